@@ -0,0 +1,274 @@
+﻿#ifndef TINYSTL_INDEXED_PRIORITY_QUEUE_H
+#define TINYSTL_INDEXED_PRIORITY_QUEUE_H
+
+#include <stdexcept>
+#include "../container/vector.h"
+#include "../container/private/hashtable.h"
+
+namespace ttl {
+    namespace detail {
+        // 默认 : 以哈希表记录key到堆下标的映射
+        template<typename Key, typename Hash>
+        class hashed_position_map {
+            ttl::hashtable<Key, size_t, Hash> table;
+        public:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            void check(const Key &) const {}
+
+            size_t get(const Key &key) const {
+                auto it = table.find(key);
+                return it == table.end() ? npos : it->second;
+            }
+
+            void set(const Key &key, size_t p) {
+                auto it = table.find(key);
+                if (it == table.end()) table.emplace_unique(key, p);
+                else it->second = p;
+            }
+
+            void erase(const Key &key) { table.erase(key); }
+
+            void clear() { table.clear(); }
+
+            void reserve(size_t n) { table.reserve(n); }
+        };
+
+        // 整数key且位于[0,bound) : 以key为下标的稠密数组 , 构造时分配bound个下标
+        // check对[0,bound)以外的key(包括负数)抛出异常 , get对它们返回npos
+        template<typename Key>
+        class dense_position_map {
+            static_assert(std::is_integral_v<Key>);
+            ttl::vector<size_t> pos;
+        public:
+            static constexpr size_t npos = static_cast<size_t>(-1);
+
+            dense_position_map() = default;
+
+            explicit dense_position_map(size_t bound) : pos(bound, npos) {}
+
+            void check(const Key &key) const {
+                if (static_cast<size_t>(key) >= pos.size()) throw std::out_of_range("indexed_priority_queue key bound");
+            }
+
+            size_t get(const Key &key) const {
+                auto i = static_cast<size_t>(key);
+                return i < pos.size() ? pos[i] : npos;
+            }
+
+            void set(const Key &key, size_t p) { pos[static_cast<size_t>(key)] = p; }
+
+            void erase(const Key &key) {
+                auto i = static_cast<size_t>(key);
+                if (i < pos.size()) pos[i] = npos;
+            }
+
+            void clear() { ttl::fill(pos.begin(), pos.end(), npos); }
+
+            void reserve(size_t) {}
+        };
+    }
+
+    // 索引优先队列 , 每个key至多出现一次 , 可以O(lgn)修改或删除任意key的优先级
+    // 堆中元素移动时同步维护key到堆下标的映射 , 默认使用以Hash为哈希函数的哈希表
+    // DenseKey为true时映射改用稠密数组(忽略Hash) , key必须是[0,bound)内的整数 , bound由构造函数给出
+    // 插入[0,bound)以外的key抛出std::out_of_range , 适合顶点编号等稠密的key
+    // Compare默认为std::less , 即top为优先级最大的元素 , 最短路等场景使用std::greater
+    // D为堆的叉数 , decrease-key以上浮为主 , 更宽的堆上浮更快
+    template<
+            typename Key,
+            typename Priority,
+            typename Compare = std::less<Priority>,
+            typename Hash = std::hash<Key>,
+            size_t D = 4,
+            bool DenseKey = false>
+    class indexed_priority_queue {
+    public:
+        using key_type = Key;
+        using priority_type = Priority;
+        using value_type = std::pair<Key, Priority>;
+        using value_compare = Compare;
+        using size_type = size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+    private:
+        using position_map = std::conditional_t<DenseKey,
+                detail::dense_position_map<Key>,
+                detail::hashed_position_map<Key, Hash>>;
+
+        static constexpr size_type npos = position_map::npos;
+
+        static_assert(D >= 2);
+    private:
+        ttl::vector<value_type> heap;
+        position_map index;
+        Compare comp;
+    public: // constructor
+#pragma region
+
+        indexed_priority_queue() = default;
+
+        explicit indexed_priority_queue(const Compare &compare) : comp(compare) {}
+
+        // 仅DenseKey , key的取值范围为[0,key_bound)
+        explicit indexed_priority_queue(size_type key_bound, const Compare &compare = Compare())
+                : index(key_bound), comp(compare) {}
+
+        indexed_priority_queue(const indexed_priority_queue &) = default;
+
+        indexed_priority_queue(indexed_priority_queue &&) noexcept = default;
+
+        ~indexed_priority_queue() = default;
+
+        indexed_priority_queue &operator=(const indexed_priority_queue &) = default;
+
+        indexed_priority_queue &operator=(indexed_priority_queue &&) noexcept = default;
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        const_reference top() const { return heap.front(); }
+
+        bool contains(const Key &key) const { return index.get(key) != npos; }
+
+        const Priority &priority(const Key &key) const {
+            size_type pos = index.get(key);
+            if (pos == npos) throw std::out_of_range("indexed_priority_queue priority");
+            return heap[pos].second;
+        }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return heap.empty(); }
+
+        size_type size() const { return heap.size(); }
+
+        // 预留n个元素的空间 , 哈希映射同时预留n个key
+        void reserve(size_type n) { heap.reserve(n), index.reserve(n); }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // key已存在时不做修改并返回false
+        bool push(const Key &key, const Priority &prio) {
+            if (contains(key)) return false;
+            index.check(key);
+            heap.emplace_back(key, prio);
+            swim(heap.size() - 1);
+            return true;
+        }
+
+        // 修改已存在key的优先级
+        void update(const Key &key, const Priority &prio) {
+            size_type pos = index.get(key);
+            if (pos == npos) throw std::out_of_range("indexed_priority_queue update");
+            update_at(pos, prio);
+        }
+
+        // key不存在时插入 , 否则修改其优先级
+        void push_or_update(const Key &key, const Priority &prio) {
+            size_type pos = index.get(key);
+            if (pos == npos) {
+                index.check(key);
+                heap.emplace_back(key, prio);
+                swim(heap.size() - 1);
+            } else {
+                update_at(pos, prio);
+            }
+        }
+
+        void pop() {
+            index.erase(heap.front().first);
+            remove_at(0);
+        }
+
+        // 弹出并返回top
+        value_type poll() {
+            value_type ret = std::move(heap.front());
+            index.erase(ret.first);
+            remove_at(0);
+            return ret;
+        }
+
+        bool erase(const Key &key) {
+            size_type pos = index.get(key);
+            if (pos == npos) return false;
+            index.erase(key);
+            remove_at(pos);
+            return true;
+        }
+
+        void clear() { heap.clear(), index.clear(); }
+
+        void swap(indexed_priority_queue &oth) noexcept {
+            std::swap(heap, oth.heap);
+            std::swap(index, oth.index);
+            std::swap(comp, oth.comp);
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        void update_at(size_type pos, const Priority &prio) {
+            bool up = comp(heap[pos].second, prio);
+            heap[pos].second = prio;
+            up ? swim(pos) : sink(pos);
+        }
+
+        // 用最后一个元素填补pos , 此时pos处元素的映射已经删除
+        void remove_at(size_type pos) {
+            size_type last = heap.size() - 1;
+            if (pos != last) {
+                heap[pos] = std::move(heap[last]);
+                heap.pop_back();
+                if (pos > 0 && comp(heap[(pos - 1) / D].second, heap[pos].second)) swim(pos);
+                else sink(pos);
+            } else {
+                heap.pop_back();
+            }
+        }
+
+        // 将value放到hole处并记录映射
+        void place(size_type hole, value_type &&value) {
+            index.set(value.first, hole);
+            heap[hole] = std::move(value);
+        }
+
+        // 上浮pos处的元素 , 移动空位而不是交换
+        void swim(size_type hole) {
+            value_type value = std::move(heap[hole]);
+            while (hole > 0) {
+                size_type parent = (hole - 1) / D;
+                if (!comp(heap[parent].second, value.second)) break;
+                place(hole, std::move(heap[parent]));
+                hole = parent;
+            }
+            place(hole, std::move(value));
+        }
+
+        // 下沉pos处的元素
+        void sink(size_type hole) {
+            value_type value = std::move(heap[hole]);
+            size_type n = heap.size(), child;
+            while ((child = hole * D + 1) < n) {
+                size_type best = child, last = child + D < n ? child + D : n;
+                for (++child; child < last; ++child) {
+                    if (comp(heap[best].second, heap[child].second)) best = child;
+                }
+                if (!comp(value.second, heap[best].second)) break;
+                place(hole, std::move(heap[best]));
+                hole = best;
+            }
+            place(hole, std::move(value));
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_INDEXED_PRIORITY_QUEUE_H
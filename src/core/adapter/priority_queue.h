@@ -9,10 +9,12 @@
 #include "../algorithm/algorithm.h"
 
 namespace ttl {
+    // D为底层堆的叉数 , 元素较大或堆较大时D=4/8可以减少缓存缺失
     template<
             typename T,
             typename Container = ttl::vector<T>,
-            typename Compare = std::less<typename Container::value_type>>
+            typename Compare = std::less<typename Container::value_type>,
+            size_t D = 2>
     class priority_queue {
     public:
         using container_type = Container;
@@ -32,12 +34,12 @@ namespace ttl {
 
         priority_queue(const Compare &compare, const Container &cont) // NOLINT(modernize-pass-by-value)
                 : comp(compare), arr(cont) {
-            ttl::make_heap(arr.begin(), arr.end(), comp);
+            ttl::make_heap<D>(arr.begin(), arr.end(), comp);
         }
 
         priority_queue(const Compare &compare, Container &&cont)
                 : comp(compare), arr(std::forward<Container>(cont)) {
-            ttl::make_heap(arr.begin(), arr.end(), comp);
+            ttl::make_heap<D>(arr.begin(), arr.end(), comp);
         }
 
         priority_queue(const priority_queue &other) = default;
@@ -63,7 +65,7 @@ namespace ttl {
         size_type size() const { return arr.size(); }
 
     private:
-        void after_push() { ttl::push_heap(arr.begin(), arr.end(), comp); }
+        void after_push() { ttl::push_heap<D>(arr.begin(), arr.end(), comp); }
 
     public: // change
         void push(const value_type &value) {
@@ -76,11 +78,11 @@ namespace ttl {
 
         template<class... Args>
         void emplace(Args &&... args) {
-            arr.emplace_back(std::forward<value_type>(args)...), after_push();
+            arr.emplace_back(std::forward<Args>(args)...), after_push();
         }
 
         void pop() {
-            ttl::pop_heap(arr.begin(), arr.end(), comp), arr.pop_back();
+            ttl::pop_heap<D>(arr.begin(), arr.end(), comp), arr.pop_back();
         }
 
         T poll() {
@@ -0,0 +1,147 @@
+﻿#ifndef TINYSTL_RADIX_HEAP_H
+#define TINYSTL_RADIX_HEAP_H
+
+#include <stdexcept>
+#include "../container/vector.h"
+#include "../algorithm/algorithm.h"
+
+namespace ttl {
+    // 单调整数优先队列 , top为最小的key , 新push的key不能小于最近一次top/pop看到的key(last)
+    // 第i个桶存放与last最高不同位为第i-1位的元素 , 0号桶存放等于last的元素
+    // 访问top时若0号桶为空 , 取出最低的非空桶 , 以其中最小的key为新的last重新分桶 , 元素只会向更低的桶移动
+    // 因此每个元素至多移动位数次 , 均摊O(lgC) , 且几乎不做元素间的比较
+    template<typename Key, typename Value>
+    class radix_heap {
+        static_assert(std::is_integral_v<Key>);
+    public:
+        using key_type = Key;
+        using mapped_type = Value;
+        using value_type = std::pair<Key, Value>;
+        using size_type = size_t;
+        using reference = value_type &;
+        using const_reference = const value_type &;
+    private:
+        using ukey_type = std::make_unsigned_t<Key>;
+
+        static constexpr int digit = std::numeric_limits<ukey_type>::digits;
+
+        // 重新分桶推迟到访问top时 , 不改变堆中的内容
+        mutable ttl::vector<value_type> buckets[digit + 1];
+        mutable ukey_type last = 0;
+        size_type count = 0;
+    public: // constructor
+#pragma region
+
+        radix_heap() = default;
+
+        radix_heap(const radix_heap &) = default;
+
+        radix_heap(radix_heap &&) noexcept = default;
+
+        ~radix_heap() = default;
+
+        radix_heap &operator=(const radix_heap &) = default;
+
+        radix_heap &operator=(radix_heap &&) noexcept = default;
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        const_reference top() const {
+            if (buckets[0].empty()) refill();
+            return buckets[0].back();
+        }
+
+        // 最近一次top/pop看到的key , 之后push的key不能比它小
+        key_type last_key() const { return static_cast<key_type>(last ^ sign_bit()); }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return count == 0; }
+
+        size_type size() const { return count; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        void push(const value_type &value) { emplace(value.first, value.second); }
+
+        void push(value_type &&value) { emplace(value.first, std::move(value.second)); }
+
+        template<class... Args>
+        void emplace(const key_type &key, Args &&... args) {
+            ukey_type k = to_unsigned(key);
+            if (k < last) throw std::out_of_range("radix_heap push");
+            buckets[bucket_index(k)].emplace_back(std::piecewise_construct,
+                                                  std::forward_as_tuple(key),
+                                                  std::forward_as_tuple(std::forward<Args>(args)...));
+            ++count;
+        }
+
+        void pop() {
+            if (buckets[0].empty()) refill();
+            buckets[0].pop_back(), --count;
+        }
+
+        value_type poll() {
+            if (buckets[0].empty()) refill();
+            value_type ret = std::move(buckets[0].back());
+            return pop(), ret;
+        }
+
+        // 清空并将last重置为key的最小值
+        void clear() {
+            for (auto &bucket: buckets) bucket.clear();
+            last = 0, count = 0;
+        }
+
+        void swap(radix_heap &other) noexcept {
+            for (int i = 0; i <= digit; ++i) buckets[i].swap(other.buckets[i]);
+            std::swap(last, other.last);
+            std::swap(count, other.count);
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        // 有符号key翻转符号位 , 使无符号比较与原比较一致
+        static constexpr ukey_type sign_bit() {
+            return std::is_signed_v<Key> ? ukey_type(1) << (digit - 1) : 0;
+        }
+
+        static ukey_type to_unsigned(const key_type &key) {
+            return static_cast<ukey_type>(key) ^ sign_bit();
+        }
+
+        int bucket_index(ukey_type k) const {
+            return k == last ? 0 : digit - ttl::countl_zero<ukey_type>(k ^ last);
+        }
+
+        // 0号桶为空且堆非空时 , 将最低的非空桶按新的last重新分桶
+        void refill() const {
+            int i = 1;
+            while (buckets[i].empty()) ++i;
+            auto &bucket = buckets[i];
+            ukey_type min_key = to_unsigned(bucket[0].first);
+            for (size_t j = 1; j < bucket.size(); ++j) {
+                ukey_type k = to_unsigned(bucket[j].first);
+                if (k < min_key) min_key = k;
+            }
+            last = min_key;
+            for (auto &item: bucket) {
+                buckets[bucket_index(to_unsigned(item.first))].push_back(std::move(item));
+            }
+            // 保留桶的容量
+            bucket.erase(bucket.begin(), bucket.end());
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_RADIX_HEAP_H
@@ -0,0 +1,147 @@
+﻿#ifndef TINYSTL_TOP_K_H
+#define TINYSTL_TOP_K_H
+
+#include "../container/vector.h"
+#include "../algorithm/algorithm.h"
+
+namespace ttl {
+    // 从数据流中保留Compare意义下最大的k个元素
+    // 内部是大小为k的小顶堆 , 堆顶为当前第k大的元素 , 新元素只需与堆顶比较一次即可决定是否丢弃
+    // 多个线程可以各自维护一个top_k , 最后用merge合并
+    template<typename T, typename Compare = std::less<T>>
+    class top_k {
+    public:
+        using value_type = T;
+        using value_compare = Compare;
+        using size_type = size_t;
+        using reference = T &;
+        using const_reference = const T &;
+        using container_type = ttl::vector<T>;
+    private:
+        // 反转比较 , 使ttl的大顶堆算法组织出小顶堆
+        struct heap_compare {
+            Compare comp;
+
+            bool operator()(const T &lhs, const T &rhs) const { return comp(rhs, lhs); }
+        };
+
+        container_type heap;
+        size_type k;
+        heap_compare comp;
+    public: // constructor
+#pragma region
+
+        explicit top_k(size_type k, const Compare &compare = Compare()) : k(k), comp{compare} {
+            heap.reserve(k);
+        }
+
+        top_k(const top_k &) = default;
+
+        top_k(top_k &&) noexcept = default;
+
+        ~top_k() = default;
+
+        top_k &operator=(const top_k &) = default;
+
+        top_k &operator=(top_k &&) noexcept = default;
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        // 当前保留的元素中最小的一个 , 即第k大的元素
+        const_reference threshold() const { return heap.front(); }
+
+        // 保留的元素 , 堆序
+        const container_type &data() const { return heap; }
+
+        // 保留的元素 , 从大到小排列
+        container_type sorted() const & {
+            container_type ret = heap;
+            ttl::sort_heap(ret.begin(), ret.end(), comp);
+            return ret;
+        }
+
+        container_type sorted() &&{
+            ttl::sort_heap(heap.begin(), heap.end(), comp);
+            return std::move(heap);
+        }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return heap.empty(); }
+
+        size_type size() const { return heap.size(); }
+
+        // 最多保留的元素个数
+        size_type capacity() const { return k; }
+
+        bool full() const { return heap.size() >= k; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 返回value是否被保留
+        bool push(const value_type &value) {
+            if (!full()) {
+                heap.push_back(value), ttl::push_heap(heap.begin(), heap.end(), comp);
+                return true;
+            }
+            if (k == 0 || !comp.comp(heap.front(), value)) return false;
+            ttl::replace_heap_top(heap.begin(), heap.end(), value, comp);
+            return true;
+        }
+
+        bool push(value_type &&value) {
+            if (!full()) {
+                heap.push_back(std::move(value)), ttl::push_heap(heap.begin(), heap.end(), comp);
+                return true;
+            }
+            if (k == 0 || !comp.comp(heap.front(), value)) return false;
+            ttl::replace_heap_top(heap.begin(), heap.end(), std::move(value), comp);
+            return true;
+        }
+
+        template<typename InputIt>
+        void push(InputIt first, InputIt last) {
+            // 先填满再一次性建堆
+            bool added = false;
+            while (!full() && first != last) heap.push_back(*first++), added = true;
+            if (added) ttl::make_heap(heap.begin(), heap.end(), comp);
+            while (first != last) push(*first++);
+        }
+
+        // 合并另一个(例如其他线程的)部分结果 , 两者的k可以不同 , 以*this为准
+        void merge(const top_k &oth) {
+            if (heap.empty() && !oth.empty() && k == oth.k) {
+                heap = oth.heap;
+                return;
+            }
+            for (auto &x: oth.heap) push(x);
+        }
+
+        void merge(top_k &&oth) {
+            if (heap.empty() && k == oth.k) {
+                heap.swap(oth.heap);
+                return;
+            }
+            for (auto &x: oth.heap) push(std::move(x));
+            oth.heap.clear();
+        }
+
+        void clear() { heap.clear(); }
+
+        void swap(top_k &oth) noexcept {
+            heap.swap(oth.heap);
+            std::swap(k, oth.k);
+            std::swap(comp, oth.comp);
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_TOP_K_H
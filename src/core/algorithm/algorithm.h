@@ -5,11 +5,65 @@
 #ifndef TINYSTL_ALGORITHM_H
 #define TINYSTL_ALGORITHM_H
 
+#include <cstring>
+#include <functional>
+#include <new>
+#include "bit.h"
+#include "simd.h"
+
 namespace ttl {
 
     /*
      * 不修改序列的操作
      */
+    template<typename InputIt, typename UnaryFunction>
+    UnaryFunction for_each(InputIt first, InputIt last, UnaryFunction f) {
+        for (; first != last; ++first) f(*first);
+        return f;
+    }
+
+    // 连续存储的算术类型序列使用向量化内核 , 下同
+    template<typename InputIt, typename T>
+    size_t count(InputIt first, InputIt last, const T &value) {
+        if constexpr (simd_searchable_v<InputIt, T>) {
+            using E = simd_value_t<InputIt>;
+            // 与逐元素比较相同 , 按通常算术转换比较 , 转换为元素类型后与value不相等时不会有元素与value相等
+            // 用equal_to比较 , 避免有符号与无符号比较的警告
+            if (first == last || !std::equal_to<>()(static_cast<E>(value), value)) return 0;
+            auto p = simd_address(first);
+            return simd_count(p, p + (last - first), static_cast<E>(value));
+        } else {
+            size_t ret = 0;
+            for (; first != last; ++first) if (*first == value) ++ret;
+            return ret;
+        }
+    }
+
+    template<typename InputIt, typename UnaryPredicate>
+    size_t count_if(InputIt first, InputIt last, UnaryPredicate pred) {
+        size_t ret = 0;
+        for (; first != last; ++first) if (pred(*first)) ++ret;
+        return ret;
+    }
+
+    template<typename InputIt, typename T>
+    InputIt find(InputIt first, InputIt last, const T &value) {
+        if constexpr (simd_searchable_v<InputIt, T>) {
+            using E = simd_value_t<InputIt>;
+            if (first == last || !std::equal_to<>()(static_cast<E>(value), value)) return last;
+            auto p = simd_address(first);
+            return first + (simd_find(p, p + (last - first), static_cast<E>(value)) - p);
+        } else {
+            for (; first != last; ++first) if (*first == value) break;
+            return first;
+        }
+    }
+
+    template<typename InputIt, typename UnaryPredicate>
+    InputIt find_if(InputIt first, InputIt last, UnaryPredicate pred) {
+        for (; first != last; ++first) if (pred(*first)) break;
+        return first;
+    }
 
     /*
      * 修改序列的操作
@@ -26,6 +80,23 @@ namespace ttl {
         return result;
     }
 
+    template<typename ForwardIt, typename T>
+    void fill(ForwardIt first, ForwardIt last, const T &value) {
+        for (; first != last; ++first) *first = value;
+    }
+
+    template<typename InputIt, typename OutputIt, typename UnaryOperation>
+    OutputIt transform(InputIt first, InputIt last, OutputIt result, UnaryOperation op) {
+        for (; first != last; ++first, ++result) *result = op(*first);
+        return result;
+    }
+
+    template<typename InputIt1, typename InputIt2, typename OutputIt, typename BinaryOperation>
+    OutputIt transform(InputIt1 first1, InputIt1 last1, InputIt2 first2, OutputIt result, BinaryOperation op) {
+        for (; first1 != last1; ++first1, ++first2, ++result) *result = op(*first1, *first2);
+        return result;
+    }
+
     template<class BidirIt1, class BidirIt2>
     BidirIt2 copy_backward(BidirIt1 first, BidirIt1 last, BidirIt2 result_back) {
         while (first != last) *(--result_back) = *(--last);
@@ -70,10 +141,112 @@ namespace ttl {
     /*
      * 划分操作
      */
+    namespace detail {
+        // 临时缓冲区 , 空间不足时逐次减半 , 最终可能为空
+        // 缓冲区中的元素由*seed依次移动构造 , 最后再移回*seed , 因此不要求T可默认构造
+        template<typename T>
+        class temporary_buffer {
+            T *buf = nullptr;
+            ptrdiff_t len = 0;
+        public:
+            template<typename ForwardIt>
+            temporary_buffer(ForwardIt seed, ptrdiff_t n) {
+                for (; n > 0; n /= 2) {
+                    buf = static_cast<T *>(::operator new(n * sizeof(T), std::nothrow));
+                    if (buf) break;
+                }
+                if (!buf) return;
+                len = n;
+                ::new(buf) T(std::move(*seed));
+                for (ptrdiff_t i = 1; i < len; ++i) ::new(buf + i) T(std::move(buf[i - 1]));
+                *seed = std::move(buf[len - 1]);
+            }
 
-    /*
-     * 排序操作
-     */
+            temporary_buffer(const temporary_buffer &) = delete;
+
+            temporary_buffer &operator=(const temporary_buffer &) = delete;
+
+            ~temporary_buffer() {
+                for (ptrdiff_t i = 0; i < len; ++i) buf[i].~T();
+                ::operator delete(buf);
+            }
+
+            T *data() const { return buf; }
+
+            ptrdiff_t size() const { return len; }
+        };
+    }
+
+    namespace {
+        // 交换[first,middle)与[middle,last) , 返回原*first的新位置
+        // 每轮把较短的一段交换到位 , 类似辗转相减 , 只需要前向迭代器
+        template<typename ForwardIt>
+        ForwardIt rotate_forward(ForwardIt first, ForwardIt middle, ForwardIt last) {
+            if (first == middle) return last;
+            if (middle == last) return first;
+            ForwardIt ret = first;
+            bool first_round = true;
+            while (first != middle && middle != last) {
+                ForwardIt write = first, next_read = first;
+                for (ForwardIt read = middle; read != last; ++write, ++read) {
+                    if (write == next_read) next_read = read;
+                    std::swap(*write, *read);
+                }
+                if (first_round) ret = write, first_round = false;
+                first = write, middle = next_read;
+            }
+            return ret;
+        }
+
+        // 稳定划分 , 长度不超过缓冲区时一趟完成 , 否则二分后旋转合并
+        template<typename ForwardIt, typename UnaryPredicate, typename T>
+        ForwardIt stable_partition_adaptive(ForwardIt first, ForwardIt last, UnaryPredicate &pred,
+                                            ptrdiff_t n, T *buf, ptrdiff_t buf_len) {
+            if (n == 1) return pred(*first) ? last : first;
+            if (n <= buf_len) {
+                ForwardIt result = first;
+                T *buf_end = buf;
+                for (; first != last && pred(*first); ++first) ++result;
+                for (; first != last; ++first) {
+                    if (pred(*first)) *result = std::move(*first), ++result;
+                    else *buf_end++ = std::move(*first);
+                }
+                ForwardIt it = result;
+                for (T *p = buf; p != buf_end; ++p, ++it) *it = std::move(*p);
+                return result;
+            }
+            ForwardIt middle = first;
+            for (ptrdiff_t i = 0; i < n / 2; ++i) ++middle;
+            ForwardIt left_split = stable_partition_adaptive(first, middle, pred, n / 2, buf, buf_len);
+            ForwardIt right_split = stable_partition_adaptive(middle, last, pred, n - n / 2, buf, buf_len);
+            return rotate_forward(left_split, middle, right_split);
+        }
+    }
+
+    // 使满足pred的元素位于不满足的之前 , 返回第二组的起点 , 不保持相对顺序
+    template<typename ForwardIt, typename UnaryPredicate>
+    ForwardIt partition(ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+        while (first != last && pred(*first)) ++first;
+        if (first == last) return first;
+        for (ForwardIt it = first; ++it != last;) {
+            if (pred(*it)) std::swap(*it, *first), ++first;
+        }
+        return first;
+    }
+
+    // 同partition , 但两组内部都保持原有的相对顺序
+    // 能申请到足够的缓冲区时O(n) , 否则O(nlgn)
+    template<typename ForwardIt, typename UnaryPredicate>
+    ForwardIt stable_partition(ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+        // 跳过已经在正确位置的前缀
+        while (first != last && pred(*first)) ++first;
+        if (first == last) return first;
+        ptrdiff_t n = 0;
+        for (ForwardIt it = first; it != last; ++it) ++n;
+        using value_type = std::decay_t<decltype(*first)>;
+        detail::temporary_buffer<value_type> buf(first, n);
+        return stable_partition_adaptive(first, last, pred, n, buf.data(), buf.size());
+    }
 
     /*
      * 二分搜索操作(需要已排序)
@@ -133,137 +306,623 @@ namespace ttl {
      * 设 N = l - f ,对于所有 0 < i < N , comp(f[parent_index(i)],f[i]) == false
      * 且对任意0 < i < N , comp(f[0], f[i])为false
      * Comp默认为std::less , 即大顶堆
+     * D为堆的叉数(默认为2) , 结点i的孩子为[D*i+1, D*i+D] , D为4或8时兄弟结点位于同一缓存行 , 树高也更低
+     * 调整时移动"空位"而不是逐层交换 , 每层只需一次移动
      */
     namespace {
         using heap_index = size_t;
 
         // i>0
+        template<size_t D>
         heap_index parent_index(heap_index pos) {
-            return (pos - 1) >> 1;
+            return (pos - 1) / D;
         }
 
-        heap_index left_index(heap_index pos) {
-            return (pos << 1) | 1;
+        template<size_t D>
+        heap_index first_child_index(heap_index pos) {
+            return pos * D + 1;
         }
 
-        heap_index right_index(heap_index pos) {
-            return (pos + 1) << 1;
+        // 从[child, child+D)中选取最大的孩子下标
+        template<size_t D, typename RandomIt, typename Compare>
+        heap_index max_child_index(RandomIt first, heap_index child, heap_index heap_size, Compare &comp) {
+            heap_index ret = child;
+            if (child + D <= heap_size) { // 孩子是满的 , 循环次数为常数 , 用条件选择代替分支
+                for (heap_index i = 1; i < D; ++i) ret = comp(first[ret], first[child + i]) ? child + i : ret;
+            } else {
+                for (heap_index i = child + 1; i < heap_size; ++i) if (comp(first[ret], first[i])) ret = i;
+            }
+            return ret;
         }
 
-        // 上浮最后一个元素
-        template<typename RandomIt, typename Compare>
-        void swim_heap(RandomIt first, heap_index pos, Compare comp) {
-            heap_index parent = parent_index(pos);
-            while (pos && comp(first[parent], first[pos])) {
-                std::swap(first[parent], first[pos]);
-                pos = parent, parent = parent_index(pos);
+        // 空位hole向上移动到value的位置 , 不超过top
+        template<size_t D, typename RandomIt, typename T, typename Compare>
+        void swim_heap(RandomIt first, heap_index hole, heap_index top, T &&value, Compare &comp) {
+            while (hole > top) {
+                heap_index parent = parent_index<D>(hole);
+                if (!comp(first[parent], value)) break;
+                first[hole] = std::move(first[parent]), hole = parent;
             }
+            first[hole] = std::move(value);
         }
 
-        // 从left,right,parent中选取一个最大的下标
-        template<typename RandomIt, typename Compare>
-        heap_index sink_index_selector(RandomIt first, heap_index parent, heap_index heap_size, Compare comp) {
-            heap_index ret = parent, l = left_index(parent), r = right_index(parent);
-            if (l < heap_size && comp(first[ret], first[l])) ret = l;
-            if (r < heap_size && comp(first[ret], first[r])) ret = r;
-            return ret;
+        // 空位hole向下移动到value的位置
+        template<size_t D, typename RandomIt, typename T, typename Compare>
+        void sink_heap(RandomIt first, heap_index hole, heap_index heap_size, T &&value, Compare &comp) {
+            heap_index child;
+            while ((child = first_child_index<D>(hole)) < heap_size) {
+                child = max_child_index<D>(first, child, heap_size, comp);
+                if (!comp(value, first[child])) break;
+                first[hole] = std::move(first[child]), hole = child;
+            }
+            first[hole] = std::move(value);
         }
 
-        // 下沉第一个元素
-        template<typename RandomIt, typename Compare>
-        void sink_heap(RandomIt first, heap_index parent, heap_index heap_size, Compare comp) {
-            heap_index idx;
-            while ((idx = sink_index_selector(first, parent, heap_size, comp)) != parent) {
-                std::swap(first[parent], first[idx]), parent = idx;
+        // Floyd : 空位沿着最大的孩子一直下降到叶子 , 再将value从叶子上浮
+        // 用于pop , 放入的value来自堆底 , 通常很小 , 上浮几乎立即停止 , 每层省去与value的比较
+        template<size_t D, typename RandomIt, typename T, typename Compare>
+        void floyd_sink_heap(RandomIt first, heap_index hole, heap_index heap_size, T &&value, Compare &comp) {
+            heap_index top = hole, child;
+            while ((child = first_child_index<D>(hole)) < heap_size) {
+                child = max_child_index<D>(first, child, heap_size, comp);
+                first[hole] = std::move(first[child]), hole = child;
             }
+            swim_heap<D>(first, hole, top, std::move(value), comp);
         }
     }
 
     // 检验范围 [first, last) 并寻找始于 first 且为最大堆的最大范围
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     RandomIt is_heap_until(RandomIt first, RandomIt last, Compare comp) {
-        if (first == last) return last;
-        RandomIt pre = first, cur = ++first;
-        bool add_pre = false;
-        while (cur != last) {
-            if (comp(*pre, *cur++))break;
-            if (add_pre) ++pre, add_pre = false;
-            else add_pre = true;
+        static_assert(D >= 2);
+        heap_index heap_size = last - first;
+        for (heap_index i = 1; i < heap_size; ++i) {
+            if (comp(first[parent_index<D>(i)], first[i])) return first + i;
         }
-        return cur;
+        return last;
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     RandomIt is_heap_until(RandomIt first, RandomIt last) {
-        return ttl::is_heap_until(first, last, std::less<>());
+        return ttl::is_heap_until<D>(first, last, std::less<>());
     }
 
     // 检测是否为堆
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     bool is_heap(RandomIt first, RandomIt last, Compare comp) {
-        return is_heap_until(first, last, comp) == last;
+        return ttl::is_heap_until<D>(first, last, comp) == last;
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     bool is_heap(RandomIt first, RandomIt last) {
-        return ttl::is_heap(first, last, std::less<>());
+        return ttl::is_heap<D>(first, last, std::less<>());
     }
 
     // 将last-1位置处的元素插入到[first,last-1)的堆中
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     void push_heap(RandomIt first, RandomIt last, Compare comp) {
-        if (last <= first + 1) return;
+        static_assert(D >= 2);
+        if (last - first <= 1) return;
         heap_index pos = last - first - 1;
-        swim_heap(first, pos, comp);
+        std::decay_t<decltype(*first)> value = std::move(first[pos]);
+        swim_heap<D>(first, pos, 0, std::move(value), comp);
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     void push_heap(RandomIt first, RandomIt last) {
-        return ttl::push_heap(first, last, std::less<>());
+        return ttl::push_heap<D>(first, last, std::less<>());
     }
 
     // 将first位置处的元素从[first,last)的堆中移除,放置到last-1处
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     void pop_heap(RandomIt first, RandomIt last, Compare comp) {
-        if (last <= first + 1) return;
+        static_assert(D >= 2);
+        if (last - first <= 1) return;
         heap_index heap_size = last - first - 1;
-        std::swap(*first, *(first + heap_size));
-        sink_heap(first, 0, heap_size, comp);
+        std::decay_t<decltype(*first)> value = std::move(first[heap_size]);
+        first[heap_size] = std::move(*first);
+        floyd_sink_heap<D>(first, 0, heap_size, std::move(value), comp);
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     void pop_heap(RandomIt first, RandomIt last) {
-        return ttl::pop_heap(first, last, std::less<>());
+        return ttl::pop_heap<D>(first, last, std::less<>());
+    }
+
+    // 用value替换[first,last)的堆顶 , 等价于pop_heap后替换最后一个元素再push_heap , 但只需一次调整
+    template<size_t D = 2, typename RandomIt, typename T, typename Compare>
+    void replace_heap_top(RandomIt first, RandomIt last, T &&value, Compare comp) {
+        static_assert(D >= 2);
+        std::decay_t<decltype(*first)> tmp = std::forward<T>(value);
+        floyd_sink_heap<D>(first, 0, last - first, std::move(tmp), comp);
+    }
+
+    template<size_t D = 2, typename RandomIt, typename T>
+    void replace_heap_top(RandomIt first, RandomIt last, T &&value) {
+        return ttl::replace_heap_top<D>(first, last, std::forward<T>(value), std::less<>());
     }
 
     // 将[first,last)的中的元素整理为一个堆
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     void make_heap(RandomIt first, RandomIt last, Compare comp) {
-        if (last <= first + 1) return;
-        heap_index heap_size = last - first, parent = heap_size / 2; // 2*p+1<len
+        static_assert(D >= 2);
+        if (last - first <= 1) return;
+        heap_index heap_size = last - first, parent = parent_index<D>(heap_size - 1);
         while (true) {
-            sink_heap(first, parent, heap_size, comp);
+            std::decay_t<decltype(*first)> value = std::move(first[parent]);
+            sink_heap<D>(first, parent, heap_size, std::move(value), comp);
             if (parent-- == 0) break;
         }
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     void make_heap(RandomIt first, RandomIt last) {
-        return ttl::make_heap(first, last, std::less<>());
+        return ttl::make_heap<D>(first, last, std::less<>());
     }
 
     // 将[first,last)的堆排序为升序序列
-    template<typename RandomIt, typename Compare>
+    template<size_t D = 2, typename RandomIt, typename Compare>
     void sort_heap(RandomIt first, RandomIt last, Compare comp) {
-        while (last > first + 1) ttl::pop_heap(first, last--, comp);
+        while (last - first > 1) ttl::pop_heap<D>(first, last--, comp);
     }
 
-    template<typename RandomIt>
+    template<size_t D = 2, typename RandomIt>
     void sort_heap(RandomIt first, RandomIt last) {
-        return ttl::sort_heap(first, last, std::less<>());
+        return ttl::sort_heap<D>(first, last, std::less<>());
     }
 
 
+    /*
+     * 排序操作 (部分排序依赖上面的堆操作)
+     */
+    namespace {
+        // 插入排序 , 用于小区间
+        template<typename RandomIt, typename Compare>
+        void insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            if (first == last) return;
+            for (RandomIt i = first + 1; i != last; ++i) {
+                std::decay_t<decltype(*first)> value = std::move(*i);
+                if (comp(value, *first)) { // 比所有已排序的元素都小 , 内层循环无需检查边界
+                    for (RandomIt j = i; j != first; --j) *j = std::move(*(j - 1));
+                    *first = std::move(value);
+                } else {
+                    RandomIt j = i;
+                    for (; comp(value, *(j - 1)); --j) *j = std::move(*(j - 1));
+                    *j = std::move(value);
+                }
+            }
+        }
+
+        // 将*a,*b,*c的中位数交换到result
+        template<typename RandomIt, typename Compare>
+        void move_median_to_first(RandomIt result, RandomIt a, RandomIt b, RandomIt c, Compare &comp) {
+            if (comp(*a, *b)) {
+                if (comp(*b, *c)) std::swap(*result, *b);
+                else if (comp(*a, *c)) std::swap(*result, *c);
+                else std::swap(*result, *a);
+            } else if (comp(*a, *c)) {
+                std::swap(*result, *a);
+            } else if (comp(*b, *c)) {
+                std::swap(*result, *c);
+            } else {
+                std::swap(*result, *b);
+            }
+        }
+
+        // 以三数中值为pivot(放在*first)进行Hoare划分 , 区间长度至少为3
+        // 返回cut , 满足[first, cut) <= pivot <= [cut, last) , pivot本身留在左半边
+        template<typename RandomIt, typename Compare>
+        RandomIt partition_pivot(RandomIt first, RandomIt last, Compare &comp) {
+            move_median_to_first(first, first + 1, first + (last - first) / 2, last - 1, comp);
+            RandomIt l = first + 1, r = last;
+            while (true) {
+                while (comp(*l, *first)) ++l;
+                --r;
+                while (comp(*first, *r)) --r;
+                if (!(l < r)) return l;
+                std::swap(*l, *r), ++l;
+            }
+        }
+
+        // 将[first,last)中最小的middle-first个元素放入[first,middle) , 并组织为大顶堆
+        template<typename RandomIt, typename Compare>
+        void heap_select(RandomIt first, RandomIt middle, RandomIt last, Compare &comp) {
+            ttl::make_heap(first, middle, comp);
+            for (RandomIt it = middle; it < last; ++it) {
+                if (comp(*it, *first)) { // 只需与堆顶比较一次
+                    std::decay_t<decltype(*first)> value = std::move(*it);
+                    *it = std::move(*first);
+                    ttl::replace_heap_top(first, middle, std::move(value), comp);
+                }
+            }
+        }
+
+        inline size_t log2_floor(size_t n) {
+            size_t ret = 0;
+            while (n >>= 1) ++ret;
+            return ret;
+        }
+    }
+
+    // 使[first,middle)为整个区间中最小的若干元素且有序 , [middle,last)的顺序不确定
+    template<typename RandomIt, typename Compare>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp) {
+        if (first == middle) return;
+        heap_select(first, middle, last, comp);
+        ttl::sort_heap(first, middle, comp);
+    }
+
+    template<typename RandomIt>
+    void partial_sort(RandomIt first, RandomIt middle, RandomIt last) {
+        return ttl::partial_sort(first, middle, last, std::less<>());
+    }
+
+    // 使*nth为排序后位于该位置的元素 , 且[first,nth) <= *nth <= (nth,last)
+    // 三数取中的快速选择 , 划分次数过多时退化为堆选择 , 保证O(nlgn)
+    template<typename RandomIt, typename Compare>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+        if (first == last || nth == last) return;
+        size_t depth = 2 * log2_floor(last - first);
+        while (last - first > 3) {
+            if (depth-- == 0) {
+                heap_select(first, nth + 1, last, comp);
+                std::swap(*first, *nth); // 堆顶是前nth+1小中最大的
+                return;
+            }
+            RandomIt cut = partition_pivot(first, last, comp);
+            if (cut <= nth) first = cut;
+            else last = cut;
+        }
+        insertion_sort(first, last, comp);
+    }
+
+    template<typename RandomIt>
+    void nth_element(RandomIt first, RandomIt nth, RandomIt last) {
+        return ttl::nth_element(first, nth, last, std::less<>());
+    }
+
+    namespace {
+        constexpr ptrdiff_t sort_insertion_threshold = 24;    // 小于该长度时插入排序
+        constexpr ptrdiff_t sort_ninther_threshold = 128;     // 大于该长度时用九数取中选pivot
+        constexpr ptrdiff_t sort_partial_insertion_limit = 8; // 尝试插入排序时允许的最多移动次数
+        constexpr ptrdiff_t sort_block_size = 64;             // 无分支划分的块大小
+        constexpr ptrdiff_t stable_sort_chunk = 32;           // 归并前先插入排序的块大小
+
+        // 已知*(first-1)不大于区间内的任何元素 , 内层循环无需检查边界
+        template<typename RandomIt, typename Compare>
+        void unguarded_insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            for (RandomIt i = first; i != last; ++i) {
+                if (!comp(*i, *(i - 1))) continue;
+                std::decay_t<decltype(*first)> value = std::move(*i);
+                RandomIt j = i;
+                do { *j = std::move(*(j - 1)), --j; } while (comp(value, *(j - 1)));
+                *j = std::move(value);
+            }
+        }
+
+        // 插入排序 , 总移动次数超过上限时放弃 , 返回是否完成了排序
+        template<typename RandomIt, typename Compare>
+        bool partial_insertion_sort(RandomIt first, RandomIt last, Compare &comp) {
+            if (first == last) return true;
+            ptrdiff_t moved = 0;
+            for (RandomIt i = first + 1; i != last; ++i) {
+                if (!comp(*i, *(i - 1))) continue;
+                std::decay_t<decltype(*first)> value = std::move(*i);
+                RandomIt j = i;
+                do { *j = std::move(*(j - 1)), --j; } while (j != first && comp(value, *(j - 1)));
+                *j = std::move(value);
+                moved += i - j;
+                if (moved > sort_partial_insertion_limit) return false;
+            }
+            return true;
+        }
+
+        // 使*a <= *b <= *c
+        template<typename RandomIt, typename Compare>
+        void sort3(RandomIt a, RandomIt b, RandomIt c, Compare &comp) {
+            if (comp(*b, *a)) std::swap(*a, *b);
+            if (comp(*c, *b)) std::swap(*b, *c);
+            if (comp(*b, *a)) std::swap(*a, *b);
+        }
+
+        // 以*first为pivot划分 , 与pivot相等的元素放在右侧 , 返回pivot的最终位置以及区间原本是否已经划分好
+        // 要求[first+1,last)中存在不小于pivot的元素 , 且若first不是最左侧 , *(first-1)不大于pivot
+        template<typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right(RandomIt first, RandomIt last, Compare &comp) {
+            std::decay_t<decltype(*first)> pivot = std::move(*first);
+            RandomIt l = first, r = last;
+            while (comp(*++l, pivot));
+            if (l - 1 == first) while (l < r && !comp(*--r, pivot));
+            else while (!comp(*--r, pivot));
+            bool already_partitioned = l >= r;
+            while (l < r) {
+                std::swap(*l, *r);
+                while (comp(*++l, pivot));
+                while (!comp(*--r, pivot));
+            }
+            RandomIt pivot_pos = l - 1;
+            *first = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // 按偏移交换左右两侧放错位置的元素 , 数量不等时用一次轮转代替逐对交换
+        template<typename RandomIt>
+        void swap_offsets(RandomIt l_base, RandomIt r_base, const unsigned char *offsets_l,
+                          const unsigned char *offsets_r, ptrdiff_t num, bool use_swaps) {
+            if (use_swaps) {
+                for (ptrdiff_t i = 0; i < num; ++i) std::swap(*(l_base + offsets_l[i]), *(r_base - offsets_r[i]));
+            } else if (num > 0) {
+                RandomIt l = l_base + offsets_l[0], r = r_base - offsets_r[0];
+                std::decay_t<decltype(*l)> tmp = std::move(*l);
+                *l = std::move(*r);
+                for (ptrdiff_t i = 1; i < num; ++i) {
+                    l = l_base + offsets_l[i], *r = std::move(*l);
+                    r = r_base - offsets_r[i], *l = std::move(*r);
+                }
+                *r = std::move(tmp);
+            }
+        }
+
+        // partition_right的无分支版本(分块划分)
+        // 先把一块内放错位置的元素偏移写入缓冲 , 比较结果只用于累加计数而不用于跳转 , 再成对交换
+        // 比较廉价(算术类型)时避免了分支预测失败
+        template<typename RandomIt, typename Compare>
+        std::pair<RandomIt, bool> partition_right_branchless(RandomIt first, RandomIt last, Compare &comp) {
+            std::decay_t<decltype(*first)> pivot = std::move(*first);
+            RandomIt l = first, r = last;
+            while (comp(*++l, pivot));
+            if (l - 1 == first) while (l < r && !comp(*--r, pivot));
+            else while (!comp(*--r, pivot));
+            bool already_partitioned = l >= r;
+            if (!already_partitioned) {
+                std::swap(*l, *r), ++l;
+                alignas(64) unsigned char offsets_l[sort_block_size];
+                alignas(64) unsigned char offsets_r[sort_block_size];
+                RandomIt l_base = l, r_base = r;
+                ptrdiff_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+                while (l < r) {
+                    // 两侧都需要新块时平分剩余的元素
+                    ptrdiff_t unknown = r - l;
+                    ptrdiff_t l_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+                    ptrdiff_t r_split = num_r == 0 ? unknown - l_split : 0;
+                    if (l_split > sort_block_size) l_split = sort_block_size;
+                    if (r_split > sort_block_size) r_split = sort_block_size;
+                    for (ptrdiff_t i = 0; i < l_split; ++i) {
+                        offsets_l[num_l] = static_cast<unsigned char>(i);
+                        num_l += !comp(*l, pivot), ++l;
+                    }
+                    for (ptrdiff_t i = 0; i < r_split; ++i) {
+                        offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+                        num_r += comp(*--r, pivot);
+                    }
+                    ptrdiff_t num = num_l < num_r ? num_l : num_r;
+                    swap_offsets(l_base, r_base, offsets_l + start_l, offsets_r + start_r, num, num_l == num_r);
+                    num_l -= num, num_r -= num, start_l += num, start_r += num;
+                    if (num_l == 0) start_l = 0, l_base = l;
+                    if (num_r == 0) start_r = 0, r_base = r;
+                }
+                // 某一侧还有放错位置的元素 , 逐个交换到分界处
+                if (num_l) {
+                    while (num_l--) std::swap(*(l_base + offsets_l[start_l + num_l]), *--r);
+                    l = r;
+                }
+                if (num_r) {
+                    while (num_r--) std::swap(*(r_base - offsets_r[start_r + num_r]), *l), ++l;
+                }
+            }
+            RandomIt pivot_pos = l - 1;
+            *first = std::move(*pivot_pos);
+            *pivot_pos = std::move(pivot);
+            return {pivot_pos, already_partitioned};
+        }
+
+        // 以*first为pivot划分 , 与pivot相等的元素放在左侧 , 返回pivot的最终位置
+        // 用于*(first-1)与pivot相等的情况 , 此时整个区间都不小于pivot , 左侧即为全部相等的元素
+        template<typename RandomIt, typename Compare>
+        RandomIt partition_left(RandomIt first, RandomIt last, Compare &comp) {
+            std::decay_t<decltype(*first)> pivot = std::move(*first);
+            RandomIt l = first, r = last;
+            while (comp(pivot, *--r));
+            if (r + 1 == last) while (l < r && !comp(pivot, *++l));
+            else while (!comp(pivot, *++l));
+            while (l < r) {
+                std::swap(*l, *r);
+                while (comp(pivot, *--r));
+                while (!comp(pivot, *++l));
+            }
+            *first = std::move(*r);
+            *r = std::move(pivot);
+            return r;
+        }
+
+        // 比较为内置的大小比较的算术类型使用无分支划分
+        template<typename T, typename Compare>
+        constexpr bool use_branchless_partition = std::is_arithmetic_v<T> && (
+                std::is_same_v<Compare, std::less<>> || std::is_same_v<Compare, std::less<T>> ||
+                std::is_same_v<Compare, std::greater<>> || std::is_same_v<Compare, std::greater<T>>);
+
+        // pattern-defeating quicksort
+        // bad_allowed : 还允许出现的严重不平衡划分的次数 , 耗尽后改用堆排序
+        // leftmost : 区间是否位于最左侧 , 否则*(first-1)可以作为插入排序与划分的哨兵
+        template<bool Branchless, typename RandomIt, typename Compare>
+        void pdqsort_loop(RandomIt first, RandomIt last, Compare &comp, int bad_allowed, bool leftmost) {
+            while (true) {
+                ptrdiff_t size = last - first;
+                if (size < sort_insertion_threshold) {
+                    if (leftmost) insertion_sort(first, last, comp);
+                    else unguarded_insertion_sort(first, last, comp);
+                    return;
+                }
+                // 选择pivot放到*first
+                ptrdiff_t half = size / 2;
+                if (size > sort_ninther_threshold) {
+                    sort3(first, first + half, last - 1, comp);
+                    sort3(first + 1, first + (half - 1), last - 2, comp);
+                    sort3(first + 2, first + (half + 1), last - 3, comp);
+                    sort3(first + (half - 1), first + half, first + (half + 1), comp);
+                    std::swap(*first, *(first + half));
+                } else {
+                    sort3(first + half, first, last - 1, comp);
+                }
+                // pivot与左侧的哨兵相等 : 区间内没有比pivot更小的元素 , 相等的元素一次性划分出去不再处理
+                // 大量重复元素时因此是线性的
+                if (!leftmost && !comp(*(first - 1), *first)) {
+                    first = partition_left(first, last, comp) + 1;
+                    continue;
+                }
+                std::pair<RandomIt, bool> part;
+                if constexpr(Branchless) part = partition_right_branchless(first, last, comp);
+                else part = partition_right(first, last, comp);
+                RandomIt pivot_pos = part.first;
+                ptrdiff_t l_size = pivot_pos - first, r_size = last - (pivot_pos + 1);
+                if (l_size < size / 8 || r_size < size / 8) {
+                    // 严重不平衡 , 次数过多说明遇到了针对性的输入 , 退化为堆排序保证O(nlgn)
+                    if (--bad_allowed == 0) {
+                        ttl::make_heap(first, last, comp);
+                        ttl::sort_heap(first, last, comp);
+                        return;
+                    }
+                    // 打乱两侧的部分元素以破坏导致不平衡的模式
+                    if (l_size >= sort_insertion_threshold) {
+                        std::swap(*first, *(first + l_size / 4));
+                        std::swap(*(pivot_pos - 1), *(pivot_pos - l_size / 4));
+                        if (l_size > sort_ninther_threshold) {
+                            std::swap(*(first + 1), *(first + (l_size / 4 + 1)));
+                            std::swap(*(first + 2), *(first + (l_size / 4 + 2)));
+                            std::swap(*(pivot_pos - 2), *(pivot_pos - (l_size / 4 + 1)));
+                            std::swap(*(pivot_pos - 3), *(pivot_pos - (l_size / 4 + 2)));
+                        }
+                    }
+                    if (r_size >= sort_insertion_threshold) {
+                        std::swap(*(pivot_pos + 1), *(pivot_pos + (1 + r_size / 4)));
+                        std::swap(*(last - 1), *(last - r_size / 4));
+                        if (r_size > sort_ninther_threshold) {
+                            std::swap(*(pivot_pos + 2), *(pivot_pos + (2 + r_size / 4)));
+                            std::swap(*(pivot_pos + 3), *(pivot_pos + (3 + r_size / 4)));
+                            std::swap(*(last - 2), *(last - (1 + r_size / 4)));
+                            std::swap(*(last - 3), *(last - (2 + r_size / 4)));
+                        }
+                    }
+                } else if (part.second && partial_insertion_sort(first, pivot_pos, comp)
+                           && partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                    // 划分时没有发生交换 , 很可能整体已经有序 , 尝试用有限次数的插入排序收尾
+                    return;
+                }
+                // 递归左侧 , 循环处理右侧
+                pdqsort_loop<Branchless>(first, pivot_pos, comp, bad_allowed, leftmost);
+                first = pivot_pos + 1, leftmost = false;
+            }
+        }
+
+        // 在有序区间中二分查找第一个不小于(lower)/大于(upper)value的位置
+        template<bool Upper, typename RandomIt, typename T, typename Compare>
+        RandomIt binary_bound(RandomIt first, RandomIt last, const T &value, Compare &comp) {
+            ptrdiff_t len = last - first;
+            while (len > 0) {
+                ptrdiff_t half = len / 2;
+                RandomIt mid = first + half;
+                if (Upper ? !comp(value, *mid) : comp(*mid, value)) first = mid + 1, len -= half + 1;
+                else len = half;
+            }
+            return first;
+        }
+
+        // 将[first,middle)与[middle,last)两段有序区间合并 , 缓冲区能容纳较短的一段时线性合并
+        // 否则按较长一段的中点切分 , 旋转后递归 , 两段已经有序时直接返回
+        template<typename RandomIt, typename T, typename Compare>
+        void merge_adaptive(RandomIt first, RandomIt middle, RandomIt last, ptrdiff_t len1, ptrdiff_t len2,
+                            T *buf, ptrdiff_t buf_len, Compare &comp) {
+            if (len1 == 0 || len2 == 0 || !comp(*middle, *(middle - 1))) return;
+            if (len1 <= len2 && len1 <= buf_len) {
+                // 前段移入缓冲区 , 从前往后合并
+                T *buf_end = buf;
+                for (RandomIt it = first; it != middle; ++it) *buf_end++ = std::move(*it);
+                T *b = buf;
+                RandomIt out = first;
+                while (b != buf_end && middle != last) {
+                    if (comp(*middle, *b)) *out++ = std::move(*middle++);
+                    else *out++ = std::move(*b++);
+                }
+                while (b != buf_end) *out++ = std::move(*b++);
+            } else if (len2 <= buf_len) {
+                // 后段移入缓冲区 , 从后往前合并
+                T *buf_end = buf;
+                for (RandomIt it = middle; it != last; ++it) *buf_end++ = std::move(*it);
+                T *b = buf_end;
+                RandomIt out = last;
+                while (b != buf && middle != first) {
+                    if (comp(*(b - 1), *(middle - 1))) *--out = std::move(*--middle);
+                    else *--out = std::move(*--b);
+                }
+                while (b != buf) *--out = std::move(*--b);
+            } else {
+                RandomIt cut1 = first, cut2 = middle;
+                ptrdiff_t len11, len22;
+                if (len1 > len2) {
+                    len11 = len1 / 2, cut1 += len11;
+                    cut2 = binary_bound<false>(middle, last, *cut1, comp), len22 = cut2 - middle;
+                } else {
+                    len22 = len2 / 2, cut2 += len22;
+                    cut1 = binary_bound<true>(first, middle, *cut2, comp), len11 = cut1 - first;
+                }
+                RandomIt new_middle = rotate_forward(cut1, middle, cut2);
+                merge_adaptive(first, cut1, new_middle, len11, len22, buf, buf_len, comp);
+                merge_adaptive(new_middle, cut2, last, len1 - len11, len2 - len22, buf, buf_len, comp);
+            }
+        }
+
+        template<typename RandomIt, typename T, typename Compare>
+        void merge_sort_adaptive(RandomIt first, RandomIt last, T *buf, ptrdiff_t buf_len, Compare &comp) {
+            ptrdiff_t n = last - first;
+            if (n <= stable_sort_chunk) {
+                // 严格降序的块直接翻转 , 严格降序保证了没有相等的元素 , 不影响稳定性
+                RandomIt it = first + 1;
+                while (it != last && comp(*it, *(it - 1))) ++it;
+                if (it == last) for (RandomIt l = first, r = last - 1; l < r; ++l, --r) std::swap(*l, *r);
+                else insertion_sort(first, last, comp);
+                return;
+            }
+            RandomIt middle = first + n / 2;
+            merge_sort_adaptive(first, middle, buf, buf_len, comp);
+            merge_sort_adaptive(middle, last, buf, buf_len, comp);
+            merge_adaptive(first, middle, last, n / 2, n - n / 2, buf, buf_len, comp);
+        }
+    }
+
+    // 不稳定排序 , pattern-defeating quicksort , 最坏O(nlgn)
+    // 小区间插入排序 , 划分严重不平衡时打乱模式 , 次数过多时退化为堆排序
+    // 有序/逆序/大量重复的输入为线性 , 算术类型使用无分支的分块划分
+    template<typename RandomIt, typename Compare>
+    void sort(RandomIt first, RandomIt last, Compare comp) {
+        if (last - first < 2) return;
+        using value_type = std::decay_t<decltype(*first)>;
+        int bad_allowed = int(log2_floor(last - first));
+        pdqsort_loop<use_branchless_partition<value_type, Compare>>(first, last, comp, bad_allowed, true);
+    }
+
+    template<typename RandomIt>
+    void sort(RandomIt first, RandomIt last) {
+        ttl::sort(first, last, std::less<>());
+    }
+
+    // 稳定排序 , 自顶向下的归并排序 , 小块插入排序
+    // 申请到n/2的缓冲区时为O(nlgn) , 缓冲区不足时退化为旋转合并 , O(nlgn^2)
+    // 相邻两段已经有序时跳过合并 , 有序的输入为线性
+    template<typename RandomIt, typename Compare>
+    void stable_sort(RandomIt first, RandomIt last, Compare comp) {
+        ptrdiff_t n = last - first;
+        if (n < 2) return;
+        using value_type = std::decay_t<decltype(*first)>;
+        detail::temporary_buffer<value_type> buf(first, (n + 1) / 2);
+        merge_sort_adaptive(first, last, buf.data(), buf.size(), comp);
+    }
+
+    template<typename RandomIt>
+    void stable_sort(RandomIt first, RandomIt last) {
+        ttl::stable_sort(first, last, std::less<>());
+    }
+
     /*
      * 最小/最大操作
      */
@@ -277,14 +936,68 @@ namespace ttl {
         return a < b ? b : a;
     }
 
+    // 第一个最小的元素
+    template<typename ForwardIt, typename Compare>
+    ForwardIt min_element(ForwardIt first, ForwardIt last, Compare comp) {
+        if (first == last) return last;
+        ForwardIt ret = first;
+        while (++first != last) if (comp(*first, *ret)) ret = first;
+        return ret;
+    }
+
+    template<typename ForwardIt>
+    ForwardIt min_element(ForwardIt first, ForwardIt last) {
+        if constexpr (simd_eligible_v<ForwardIt>) {
+            if (first == last) return last;
+            auto p = simd_address(first);
+            // 含有NaN时返回nullptr , 此时按标量版本的语义处理
+            if (auto ret = simd_extreme<false>(p, p + (last - first))) return first + (ret - p);
+        }
+        return ttl::min_element(first, last, std::less<>());
+    }
+
+    // 第一个最大的元素
+    template<typename ForwardIt, typename Compare>
+    ForwardIt max_element(ForwardIt first, ForwardIt last, Compare comp) {
+        if (first == last) return last;
+        ForwardIt ret = first;
+        while (++first != last) if (comp(*ret, *first)) ret = first;
+        return ret;
+    }
+
+    template<typename ForwardIt>
+    ForwardIt max_element(ForwardIt first, ForwardIt last) {
+        if constexpr (simd_eligible_v<ForwardIt>) {
+            if (first == last) return last;
+            auto p = simd_address(first);
+            if (auto ret = simd_extreme<true>(p, p + (last - first))) return first + (ret - p);
+        }
+        return ttl::max_element(first, last, std::less<>());
+    }
+
     /*
      * 比较操作
      */
 
+    namespace {
+        // 连续存储的两段等长序列是否相等 , 整数逐字节比较 , 浮点数按==比较(NaN不等 , ±0相等)
+        template<typename T>
+        bool simd_equal(const T *first1, const T *first2, size_t n) {
+            if (n == 0) return true;
+            if constexpr (std::is_integral_v<T>) return std::memcmp(first1, first2, n * sizeof(T)) == 0;
+            else return simd_mismatch(first1, first1 + n, first2) == first1 + n;
+        }
+    }
+
     // 元素相等
     template<class InputIt1, class InputIt2>
     bool equal(InputIt1 first1, InputIt1 last1,
                InputIt2 first2, InputIt2 last2) {
+        if constexpr (simd_comparable_v<InputIt1, InputIt2>) {
+            auto n = last1 - first1;
+            if (n != last2 - first2) return false;
+            return n == 0 || simd_equal(simd_address(first1), simd_address(first2), size_t(n));
+        }
         for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
             if (!(*first1 == *first2)) {
                 return false;
@@ -295,6 +1008,10 @@ namespace ttl {
 
     template<class InputIt1, class InputIt2>
     bool equal(InputIt1 first1, InputIt1 last1, InputIt2 first2) {
+        if constexpr (simd_comparable_v<InputIt1, InputIt2>) {
+            auto n = last1 - first1;
+            return n == 0 || simd_equal(simd_address(first1), simd_address(first2), size_t(n));
+        }
         for (; first1 != last1; ++first1, ++first2) {
             if (!(*first1 == *first2)) {
                 return false;
@@ -306,6 +1023,24 @@ namespace ttl {
     // 字典序<
     template<typename InputIt1, typename InputIt2>
     bool lexicographical_compare(InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2) {
+        if constexpr (simd_comparable_v<InputIt1, InputIt2>) {
+            using T = simd_value_t<InputIt1>;
+            auto n1 = last1 - first1, n2 = last2 - first2, n = n1 < n2 ? n1 : n2;
+            if (n > 0) {
+                const T *p1 = simd_address(first1), *p2 = simd_address(first2);
+                if constexpr (std::is_unsigned_v<T> && sizeof(T) == 1) { // memcmp按无符号字节比较
+                    int r = std::memcmp(p1, p2, size_t(n));
+                    if (r != 0) return r < 0;
+                } else {
+                    // 跳到第一个不相等的位置再比较 , 只有NaN会使两个方向的<都不成立 , 此时继续向后找
+                    for (auto p = p1, end = p1 + n; (p = simd_mismatch(p, end, p2 + (p - p1))) != end; ++p) {
+                        if (*p < p2[p - p1]) return true;
+                        if (p2[p - p1] < *p) return false;
+                    }
+                }
+            }
+            return n1 < n2;
+        }
         for (; (first1 != last1) && (first2 != last2); ++first1, ++first2) {
             if (*first1 < *first2) return true;
             if (*first2 < *first1) return false;
@@ -314,48 +1049,41 @@ namespace ttl {
     }
 
     /*
-     * 排列操作
+     * 数值操作
      */
 
+    // 按顺序折叠 , 与并行版本不同 , 不要求op满足结合律与交换律
+    template<typename InputIt, typename T, typename BinaryOperation>
+    T reduce(InputIt first, InputIt last, T init, BinaryOperation op) {
+        for (; first != last; ++first) init = op(std::move(init), *first);
+        return init;
+    }
+
+    template<typename InputIt, typename T>
+    T reduce(InputIt first, InputIt last, T init) {
+        return ttl::reduce(first, last, std::move(init), std::plus<>());
+    }
+
+    template<typename InputIt>
+    auto reduce(InputIt first, InputIt last) {
+        return ttl::reduce(first, last, std::decay_t<decltype(*first)>{}, std::plus<>());
+    }
 
     /*
-     * 位操作
+     * 排列操作
      */
-    namespace {
-        // Todo 注释
-        int popcount32(uint32_t x) noexcept {
-            x = (x & 0x55555555) + ((x >> 1) & 0x55555555);
-            x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
-            x = (x & 0x0f0f0f0f) + ((x >> 4) & 0x0f0f0f0f);
-            x = (x & 0x00ff00ff) + ((x >> 8) & 0x00ff00ff);
-            x = (x & 0x0000ffff) + ((x >> 16) & 0x0000ffff);
-            return int(x);
-        }
-
-        // Todo
-        int popcount8(uint8_t x) noexcept {
-            return popcount32(x);
-        }
 
-        // Todo
-        int popcount16(uint16_t x) noexcept {
-            return popcount32(x);
-        }
 
-        // Todo
-        int popcount64(uint64_t x) noexcept {
-            return popcount32(x & 0xffffffff) + popcount32(x >> 32);
-        }
-    }
+    /*
+     * 位操作(单个整数的位操作见bit.h)
+     */
 
+    // [first,last)中所有字的1的个数之和 , 用于按字存储的位集合
+    // 支持AVX2时使用Harley-Seal内核 , 否则逐字计数 , 运行时按cpuid选择
     template<typename T>
-    int popcount(T x) noexcept {
-        const int digit = std::numeric_limits<T>::digits;
-        static_assert(digit <= 64);
-        if constexpr(digit <= 8) return popcount8(digit);
-        else if constexpr(digit <= 16) return popcount16(digit);
-        else if constexpr(digit <= 32) return popcount32(digit);
-        else return popcount64(digit);
+    size_t popcount(const T *first, const T *last) noexcept {
+        static_assert(std::is_unsigned_v<T> && sizeof(T) == 8);
+        return simd_popcount(first, last);
     }
 }
 
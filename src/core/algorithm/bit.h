@@ -0,0 +1,154 @@
+﻿#ifndef TINYSTL_BIT_H
+#define TINYSTL_BIT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// 单个整数的位操作
+// GCC/Clang下使用编译器内建函数 , 在编译期同样可用 , 其他编译器使用等价的常量表达式实现
+namespace ttl {
+    namespace {
+        // 分治计数 : 先求每2位中1的个数 , 再合并为每4位 , 每8位 , 最后用乘法把8个字节累加到最高字节
+        constexpr int popcount_swar(uint64_t x) noexcept {
+            x = x - ((x >> 1) & 0x5555555555555555ull);
+            x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0full;
+            return int((x * 0x0101010101010101ull) >> 56);
+        }
+
+        // 没有启用popcnt指令的x86上 , 内建函数会调用libgcc中的查表实现 , 不如直接分治计数
+        constexpr int popcount64(uint64_t x) noexcept {
+#if defined(__GNUC__) && (defined(__POPCNT__) || !(defined(__x86_64__) || defined(__i386__)))
+            return __builtin_popcountll(x);
+#else
+            return popcount_swar(x);
+#endif
+        }
+
+        // x不为0 , 二分定位最高位的1
+        constexpr int countl_zero64(uint64_t x) noexcept {
+#if defined(__GNUC__)
+            return __builtin_clzll(x);
+#else
+            int ret = 0;
+            for (int shift = 32; shift; shift >>= 1) {
+                if (!(x >> (64 - shift))) ret += shift, x <<= shift;
+            }
+            return ret;
+#endif
+        }
+
+        // x不为0 , 最低位的1以下全部置1后计数
+        constexpr int countr_zero64(uint64_t x) noexcept {
+#if defined(__GNUC__)
+            return __builtin_ctzll(x);
+#else
+            return popcount64((x & (0 - x)) - 1);
+#endif
+        }
+
+        // Vigna的broadword select : 求出每个字节及之前的1的个数 , 与广播的k逐字节比较定位所在字节 , 再在字节内逐个清除
+        constexpr int select64_broadword(uint64_t x, int k) noexcept {
+            constexpr uint64_t l8 = 0x0101010101010101ull, h8 = 0x8080808080808080ull;
+            uint64_t s = x - ((x >> 1) & 0x5555555555555555ull);
+            s = (s & 0x3333333333333333ull) + ((s >> 2) & 0x3333333333333333ull);
+            s = ((s + (s >> 4)) & 0x0f0f0f0f0f0f0f0full) * l8;
+            // 前缀和不超过k的字节数 , 乘8即目标字节的起始位
+            uint64_t before = (((uint64_t(k) * l8) | h8) - s) & h8;
+            int place = int(((before >> 7) * l8 >> 53) & ~uint64_t(7));
+            int rest = k - int(((s << 8) >> place) & 0xff);
+            uint64_t byte = (x >> place) & 0xff;
+            for (; rest; --rest) byte &= byte - 1;
+            return place + countr_zero64(byte);
+        }
+
+        template<typename T>
+        constexpr T byteswap_generic(T x) noexcept {
+            using U = std::make_unsigned_t<T>;
+            U v = U(x), ret = 0;
+            for (size_t i = 0; i < sizeof(T); ++i, v >>= 8) ret = U(ret << 8) | U(v & 0xff);
+            return T(ret);
+        }
+    }
+
+    // 1的个数
+    template<typename T>
+    constexpr int popcount(T x) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        static_assert(std::numeric_limits<T>::digits <= 64);
+        return popcount64(x);
+    }
+
+    // 从最高位起连续0的个数 , x为0时返回T的位数
+    template<typename T>
+    constexpr int countl_zero(T x) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        constexpr int digit = std::numeric_limits<T>::digits;
+        static_assert(digit <= 64);
+        if (x == 0) return digit;
+        return countl_zero64(x) - (64 - digit);
+    }
+
+    // 从最低位起连续0的个数 , x为0时返回T的位数
+    template<typename T>
+    constexpr int countr_zero(T x) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        constexpr int digit = std::numeric_limits<T>::digits;
+        static_assert(digit <= 64);
+        if (x == 0) return digit;
+        return countr_zero64(x);
+    }
+
+    // 表示x所需的最少位数 , x为0时返回0
+    template<typename T>
+    constexpr int bit_width(T x) noexcept {
+        return std::numeric_limits<T>::digits - ttl::countl_zero(x);
+    }
+
+    // 循环左移s位 , s可以为负数或超过T的位数
+    template<typename T>
+    constexpr T rotl(T x, int s) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        constexpr int digit = std::numeric_limits<T>::digits;
+        int r = s % digit;
+        if (r < 0) r += digit;
+        if (r == 0) return x;
+        return T(x << r) | T(x >> (digit - r));
+    }
+
+    // 循环右移s位
+    template<typename T>
+    constexpr T rotr(T x, int s) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        constexpr int digit = std::numeric_limits<T>::digits;
+        int r = s % digit;
+        if (r < 0) r += digit;
+        if (r == 0) return x;
+        return T(x >> r) | T(x << (digit - r));
+    }
+
+    // 第k个(从0开始)值为1的位的下标 , x中1的个数需要大于k
+    template<typename T>
+    constexpr int bit_select(T x, int k) noexcept {
+        static_assert(std::is_unsigned_v<T>);
+        static_assert(std::numeric_limits<T>::digits <= 64);
+        return select64_broadword(x, k);
+    }
+
+    // 反转字节序
+    template<typename T>
+    constexpr T byteswap(T x) noexcept {
+        static_assert(std::is_integral_v<T>);
+        if constexpr (sizeof(T) == 1) return x;
+#if defined(__GNUC__)
+        else if constexpr (sizeof(T) == 2) return T(__builtin_bswap16(uint16_t(x)));
+        else if constexpr (sizeof(T) == 4) return T(__builtin_bswap32(uint32_t(x)));
+        else if constexpr (sizeof(T) == 8) return T(__builtin_bswap64(uint64_t(x)));
+#endif
+        else return byteswap_generic(x);
+    }
+}
+
+#endif //TINYSTL_BIT_H
@@ -0,0 +1,387 @@
+﻿#ifndef TINYSTL_EXECUTION_H
+#define TINYSTL_EXECUTION_H
+
+#include <atomic>
+#include "algorithm.h"
+#include "../iterator/iterator.h"
+#include "../container/vector.h"
+#include "../thread/thread_pool.h"
+
+namespace ttl {
+
+    /*
+     * 执行策略
+     * par与par_unseq在线程池上分块执行 , 默认使用thread_pool::global() , 可以用on(pool)指定线程池
+     * par_unseq额外允许块内的循环向量化 , 元素访问函数中不能加锁
+     */
+    namespace execution {
+        struct sequenced_policy {
+        };
+
+        struct parallel_policy {
+            thread_pool *pool = nullptr;
+
+            parallel_policy on(thread_pool &p) const { return parallel_policy{&p}; }
+        };
+
+        struct parallel_unsequenced_policy {
+            thread_pool *pool = nullptr;
+
+            parallel_unsequenced_policy on(thread_pool &p) const { return parallel_unsequenced_policy{&p}; }
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+        inline constexpr parallel_unsequenced_policy par_unseq{};
+    }
+
+    template<typename T>
+    struct is_execution_policy : std::false_type {
+    };
+    template<>
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type {
+    };
+    template<>
+    struct is_execution_policy<execution::parallel_policy> : std::true_type {
+    };
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type {
+    };
+
+    template<typename T>
+    inline constexpr bool is_execution_policy_v = is_execution_policy<std::decay_t<T>>::value;
+
+    namespace detail {
+        // 每块的元素数 , 块的划分只与元素个数有关 , 与线程数无关
+        constexpr size_t parallel_grain = 1 << 14;
+
+        template<typename ExecutionPolicy>
+        using enable_if_execution_policy_t = std::enable_if_t<is_execution_policy_v<ExecutionPolicy>, int>;
+
+        template<typename It>
+        inline constexpr bool is_random_access_v =
+                std::is_same_v<typename ttl::iterator_traits<It>::iterator_category, random_access_iterator_tag>;
+
+        inline constexpr size_t parallel_chunk_count(size_t n) {
+            return (n + parallel_grain - 1) / parallel_grain;
+        }
+
+        // 执行策略对应的线程池 , 顺序执行或线程池只有一个线程时返回nullptr
+        template<typename ExecutionPolicy>
+        thread_pool *parallel_pool(const ExecutionPolicy &policy) {
+            if constexpr(std::is_same_v<ExecutionPolicy, execution::sequenced_policy>) {
+                return nullptr;
+            } else {
+                thread_pool *pool = policy.pool ? policy.pool : &thread_pool::global();
+                return pool->size() > 1 ? pool : nullptr;
+            }
+        }
+
+        // 对[0,n)的每一块调用body(begin, end)
+        // 不能并行时在当前线程按相同的划分依次执行 , 按块归约的结果总是相同的
+        template<typename ExecutionPolicy, typename Function>
+        void parallel_chunks(const ExecutionPolicy &policy, size_t n, Function &&body) {
+            thread_pool *pool = parallel_pool(policy);
+            if (pool && n >= 2 * parallel_grain) return pool->parallel_for(n, parallel_grain, body);
+            for (size_t lo = 0; lo < n; lo += parallel_grain) body(lo, ttl::min(lo + parallel_grain, n));
+        }
+
+        // a[0,la)与b[0,lb)归并后的前k个元素中来自a的个数 , 相等的元素a在前
+        template<typename It1, typename It2, typename Compare>
+        size_t merge_split(It1 a, size_t la, It2 b, size_t lb, size_t k, Compare &comp) {
+            size_t lo = k > lb ? k - lb : 0, hi = ttl::min(k, la);
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (comp(b[k - mid - 1], a[mid])) hi = mid;
+                else lo = mid + 1;
+            }
+            return lo;
+        }
+
+        template<typename InputIt, typename OutputIt, typename Compare>
+        void merge_move(InputIt a, InputIt a_end, InputIt b, InputIt b_end, OutputIt out, Compare &comp) {
+            for (; a != a_end && b != b_end; ++out) *out = comp(*b, *a) ? std::move(*b++) : std::move(*a++);
+            for (; a != a_end; ++a, ++out) *out = std::move(*a);
+            for (; b != b_end; ++b, ++out) *out = std::move(*b);
+        }
+
+        // 将src中相邻的有序段两两归并到dst , 第i段为[bounds[i], bounds[i+1]) , segs为偶数
+        // 每对按输出位置切成若干片 , 用二分找到每片在两段中的起点 , 各片互不相关
+        // 归并会移走src中的元素 , 所以先求出所有切分点再并行归并
+        template<typename InputIt, typename OutputIt, typename Compare>
+        void parallel_merge(thread_pool &pool, InputIt src, OutputIt dst, const size_t *bounds, size_t segs,
+                            Compare &comp) {
+            size_t pairs = segs / 2, n = bounds[segs];
+            size_t pieces = ttl::max(size_t(1), ttl::min(pool.size() * 4 / pairs, n / pairs / parallel_grain));
+            ttl::vector<size_t> split(pairs * (pieces + 1)); // 每片输出的起点中来自前一段的元素个数
+            for (size_t g = 0; g < pairs; ++g) {
+                size_t s = bounds[2 * g], m = bounds[2 * g + 1], e = bounds[2 * g + 2];
+                for (size_t p = 0; p <= pieces; ++p) {
+                    size_t k = (e - s) * p / pieces;
+                    split[g * (pieces + 1) + p] = merge_split(src + s, m - s, src + m, e - m, k, comp);
+                }
+            }
+            pool.parallel_for(pairs * pieces, 1, [&](size_t lo, size_t hi) {
+                for (size_t t = lo; t < hi; ++t) {
+                    size_t g = t / pieces, p = t % pieces;
+                    size_t s = bounds[2 * g], m = bounds[2 * g + 1], e = bounds[2 * g + 2];
+                    size_t k0 = (e - s) * p / pieces, k1 = (e - s) * (p + 1) / pieces;
+                    size_t i0 = split[g * (pieces + 1) + p], i1 = split[g * (pieces + 1) + p + 1];
+                    merge_move(src + s + i0, src + s + i1, src + m + (k0 - i0), src + m + (k1 - i1),
+                               dst + s + k0, comp);
+                }
+            });
+        }
+    }
+
+    /*
+     * 不修改序列的操作
+     */
+    template<typename ExecutionPolicy, typename ForwardIt, typename UnaryFunction,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void for_each(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, UnaryFunction f) {
+        if constexpr(!detail::is_random_access_v<ForwardIt>) {
+            ttl::for_each(first, last, f);
+        } else {
+            detail::parallel_chunks(policy, last - first, [&](size_t lo, size_t hi) {
+                ttl::for_each(first + lo, first + hi, f);
+            });
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt, typename UnaryPredicate,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    size_t count_if(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+        if constexpr(!detail::is_random_access_v<ForwardIt>) {
+            return ttl::count_if(first, last, pred);
+        } else {
+            size_t n = last - first;
+            ttl::vector<size_t> counts(detail::parallel_chunk_count(n), size_t(0));
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                counts[lo / detail::parallel_grain] = ttl::count_if(first + lo, first + hi, pred);
+            });
+            return ttl::reduce(counts.begin(), counts.end(), size_t(0));
+        }
+    }
+
+    // 返回第一个满足pred的位置 , 与顺序执行的结果相同
+    // 只检查起点在已找到的位置之前的块
+    template<typename ExecutionPolicy, typename ForwardIt, typename UnaryPredicate,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    ForwardIt find_if(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, UnaryPredicate pred) {
+        if constexpr(!detail::is_random_access_v<ForwardIt>) {
+            return ttl::find_if(first, last, pred);
+        } else {
+            size_t n = last - first;
+            std::atomic<size_t> found{n};
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                if (lo >= found.load(std::memory_order_relaxed)) return;
+                size_t pos = ttl::find_if(first + lo, first + hi, pred) - first;
+                if (pos == hi) return;
+                size_t cur = found.load(std::memory_order_relaxed);
+                while (pos < cur && !found.compare_exchange_weak(cur, pos, std::memory_order_relaxed));
+            });
+            return first + found.load(std::memory_order_relaxed);
+        }
+    }
+
+    /*
+     * 修改序列的操作
+     */
+    template<typename ExecutionPolicy, typename ForwardIt1, typename ForwardIt2,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    ForwardIt2 copy(ExecutionPolicy &&policy, ForwardIt1 first, ForwardIt1 last, ForwardIt2 result) {
+        if constexpr(!detail::is_random_access_v<ForwardIt1> || !detail::is_random_access_v<ForwardIt2>) {
+            return ttl::copy(first, last, result);
+        } else {
+            size_t n = last - first;
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                ttl::copy(first + lo, first + hi, result + lo);
+            });
+            return result + n;
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt, typename T,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void fill(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, const T &value) {
+        if constexpr(!detail::is_random_access_v<ForwardIt>) {
+            ttl::fill(first, last, value);
+        } else {
+            detail::parallel_chunks(policy, last - first, [&](size_t lo, size_t hi) {
+                ttl::fill(first + lo, first + hi, value);
+            });
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt1, typename ForwardIt2, typename UnaryOperation,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    ForwardIt2 transform(ExecutionPolicy &&policy, ForwardIt1 first, ForwardIt1 last, ForwardIt2 result,
+                         UnaryOperation op) {
+        if constexpr(!detail::is_random_access_v<ForwardIt1> || !detail::is_random_access_v<ForwardIt2>) {
+            return ttl::transform(first, last, result, op);
+        } else {
+            size_t n = last - first;
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                ttl::transform(first + lo, first + hi, result + lo, op);
+            });
+            return result + n;
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt1, typename ForwardIt2, typename ForwardIt3,
+            typename BinaryOperation, detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    ForwardIt3 transform(ExecutionPolicy &&policy, ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2,
+                         ForwardIt3 result, BinaryOperation op) {
+        if constexpr(!detail::is_random_access_v<ForwardIt1> || !detail::is_random_access_v<ForwardIt2> ||
+                     !detail::is_random_access_v<ForwardIt3>) {
+            return ttl::transform(first1, last1, first2, result, op);
+        } else {
+            size_t n = last1 - first1;
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                ttl::transform(first1 + lo, first1 + hi, first2 + lo, result + lo, op);
+            });
+            return result + n;
+        }
+    }
+
+    /*
+     * 堆操作
+     */
+
+    // 自底向上逐层建堆 , 同一层结点的子树互不相交 , 同层的下沉可以并行
+    // 结点数少的上层直接在当前线程处理
+    template<size_t D = 2, typename ExecutionPolicy, typename RandomIt, typename Compare,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void make_heap(ExecutionPolicy &&policy, RandomIt first, RandomIt last, Compare comp) {
+        static_assert(D >= 2);
+        heap_index heap_size = last - first;
+        thread_pool *pool = detail::parallel_pool(policy);
+        if (!pool || heap_size < 2 * detail::parallel_grain) return ttl::make_heap<D>(first, last, comp);
+        heap_index last_parent = parent_index<D>(heap_size - 1), starts[64];
+        int levels = 0;
+        for (heap_index s = 0; s <= last_parent; s = s * D + 1) starts[levels++] = s;
+        for (int k = levels - 1; k >= 0; --k) {
+            heap_index lo = starts[k], hi = k + 1 < levels ? starts[k + 1] : last_parent + 1;
+            auto sink_range = [&](size_t b, size_t e) {
+                for (heap_index i = lo + e; i-- > lo + b;) {
+                    std::decay_t<decltype(*first)> value = std::move(first[i]);
+                    sink_heap<D>(first, i, heap_size, std::move(value), comp);
+                }
+            };
+            if (hi - lo < 2 * detail::parallel_grain) sink_range(0, hi - lo);
+            else pool->parallel_for(hi - lo, detail::parallel_grain, sink_range);
+        }
+    }
+
+    template<size_t D = 2, typename ExecutionPolicy, typename RandomIt,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void make_heap(ExecutionPolicy &&policy, RandomIt first, RandomIt last) {
+        ttl::make_heap<D>(std::forward<ExecutionPolicy>(policy), first, last, std::less<>());
+    }
+
+    /*
+     * 排序操作
+     */
+
+    // 切成2的幂个段 , 各段并行排序后逐轮两两并行归并 , 需要n个元素的缓冲区 , 申请失败时顺序排序
+    template<typename ExecutionPolicy, typename RandomIt, typename Compare,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void sort(ExecutionPolicy &&policy, RandomIt first, RandomIt last, Compare comp) {
+        size_t n = last - first;
+        thread_pool *pool = detail::parallel_pool(policy);
+        size_t segs = 1;
+        while (pool && segs < pool->size() && n / (segs * 2) >= detail::parallel_grain) segs *= 2;
+        if (segs == 1) return ttl::sort(first, last, comp);
+        using value_type = std::decay_t<decltype(*first)>;
+        detail::temporary_buffer<value_type> buf(first, n);
+        if (size_t(buf.size()) != n) return ttl::sort(first, last, comp);
+        ttl::vector<size_t> bounds(segs + 1);
+        for (size_t i = 0; i <= segs; ++i) bounds[i] = n * i / segs;
+        pool->parallel_for(segs, 1, [&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) ttl::sort(first + bounds[i], first + bounds[i + 1], comp);
+        });
+        bool in_buf = false;
+        for (; segs > 1; segs /= 2, in_buf = !in_buf) {
+            if (in_buf) detail::parallel_merge(*pool, buf.data(), first, bounds.data(), segs, comp);
+            else detail::parallel_merge(*pool, first, buf.data(), bounds.data(), segs, comp);
+            for (size_t i = 0; i <= segs / 2; ++i) bounds[i] = bounds[2 * i];
+        }
+        if (in_buf) {
+            pool->parallel_for(n, detail::parallel_grain, [&](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) first[i] = std::move(buf.data()[i]);
+            });
+        }
+    }
+
+    template<typename ExecutionPolicy, typename RandomIt, detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    void sort(ExecutionPolicy &&policy, RandomIt first, RandomIt last) {
+        ttl::sort(std::forward<ExecutionPolicy>(policy), first, last, std::less<>());
+    }
+
+    /*
+     * 比较操作
+     */
+    template<typename ExecutionPolicy, typename ForwardIt1, typename ForwardIt2,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    bool equal(ExecutionPolicy &&policy, ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2) {
+        if constexpr(!detail::is_random_access_v<ForwardIt1> || !detail::is_random_access_v<ForwardIt2>) {
+            return ttl::equal(first1, last1, first2);
+        } else {
+            std::atomic<bool> differ{false};
+            detail::parallel_chunks(policy, last1 - first1, [&](size_t lo, size_t hi) {
+                if (differ.load(std::memory_order_relaxed)) return;
+                if (!ttl::equal(first1 + lo, first1 + hi, first2 + lo)) differ.store(true, std::memory_order_relaxed);
+            });
+            return !differ.load(std::memory_order_relaxed);
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt1, typename ForwardIt2,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    bool equal(ExecutionPolicy &&policy, ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2, ForwardIt2 last2) {
+        if constexpr(!detail::is_random_access_v<ForwardIt1> || !detail::is_random_access_v<ForwardIt2>) {
+            return ttl::equal(first1, last1, first2, last2);
+        } else {
+            if (last1 - first1 != last2 - first2) return false;
+            return ttl::equal(std::forward<ExecutionPolicy>(policy), first1, last1, first2);
+        }
+    }
+
+    /*
+     * 数值操作
+     */
+
+    // 每块先在块内折叠 , 再按块的顺序与init折叠
+    // 块的划分与线程数无关 , 因此对于浮点加法等不满足结合律的op , 任意线程数下的结果都相同
+    template<typename ExecutionPolicy, typename ForwardIt, typename T, typename BinaryOperation,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    T reduce(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, T init, BinaryOperation op) {
+        if constexpr(!detail::is_random_access_v<ForwardIt>) {
+            return ttl::reduce(first, last, std::move(init), op);
+        } else {
+            size_t n = last - first;
+            ttl::vector<T> partial(detail::parallel_chunk_count(n), init);
+            detail::parallel_chunks(policy, n, [&](size_t lo, size_t hi) {
+                T acc = *(first + lo);
+                for (ForwardIt it = first + lo + 1, end = first + hi; it != end; ++it) acc = op(std::move(acc), *it);
+                partial[lo / detail::parallel_grain] = std::move(acc);
+            });
+            return ttl::reduce(partial.begin(), partial.end(), std::move(init), op);
+        }
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt, typename T,
+            detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    T reduce(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last, T init) {
+        return ttl::reduce(std::forward<ExecutionPolicy>(policy), first, last, std::move(init), std::plus<>());
+    }
+
+    template<typename ExecutionPolicy, typename ForwardIt, detail::enable_if_execution_policy_t<ExecutionPolicy> = 0>
+    auto reduce(ExecutionPolicy &&policy, ForwardIt first, ForwardIt last) {
+        return ttl::reduce(std::forward<ExecutionPolicy>(policy), first, last,
+                           std::decay_t<decltype(*first)>{}, std::plus<>());
+    }
+}
+
+#endif //TINYSTL_EXECUTION_H
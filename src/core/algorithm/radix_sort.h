@@ -0,0 +1,158 @@
+﻿#ifndef TINYSTL_RADIX_SORT_H
+#define TINYSTL_RADIX_SORT_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "algorithm.h"
+
+namespace ttl {
+
+    // 默认的key : 元素本身
+    struct identity_key {
+        template<typename T>
+        const T &operator()(const T &value) const { return value; }
+    };
+
+    namespace {
+        // 将整数与浮点key映射为无符号整数 , 使无符号比较的顺序与原顺序一致
+        template<typename Key, typename = void>
+        struct radix_key_traits;
+
+        template<typename Key>
+        struct radix_key_traits<Key, std::enable_if_t<std::is_integral_v<Key>>> {
+            using type = std::make_unsigned_t<Key>;
+
+            static type to_unsigned(Key key) {
+                // 有符号数翻转符号位
+                constexpr type sign = std::is_signed_v<Key> ? type(type(1) << (sizeof(Key) * 8 - 1)) : type(0);
+                return static_cast<type>(key) ^ sign;
+            }
+        };
+
+        template<typename Key>
+        struct radix_key_traits<Key, std::enable_if_t<std::is_floating_point_v<Key>>> {
+            static_assert(sizeof(Key) == 4 || sizeof(Key) == 8);
+            using type = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+
+            // 正数翻转符号位 , 负数翻转所有位 (负数的位模式越大值越小)
+            static type to_unsigned(Key key) {
+                type bits;
+                std::memcpy(&bits, &key, sizeof(Key));
+                constexpr type sign = type(1) << (sizeof(Key) * 8 - 1);
+                return bits ^ (bits & sign ? ~type(0) : sign);
+            }
+        };
+
+        constexpr ptrdiff_t radix_string_small = 32; // 字符串MSD中小于该长度的桶改用比较排序
+
+        // 按key的第byte个字节将[first,last)分配到out , 保持相对顺序
+        template<typename SrcIt, typename DstIt, typename KeyOf>
+        void radix_scatter(SrcIt first, SrcIt last, DstIt out, size_t *offset, int byte, KeyOf &key_of) {
+            for (; first != last; ++first) {
+                size_t bucket = (key_of(*first) >> (byte * 8)) & 0xff;
+                *(out + offset[bucket]++) = std::move(*first);
+            }
+        }
+
+        // LSD基数排序 , 一趟统计所有字节的直方图 , 所有元素该字节都相同的趟直接跳过
+        // 数据在区间与缓冲区之间来回移动 , 最后一趟落在缓冲区时再移回
+        template<typename RandomIt, typename T, typename Key>
+        void radix_sort_lsd(RandomIt first, RandomIt last, Key &key, T *buf) {
+            using traits = radix_key_traits<std::decay_t<decltype(key(*first))>>;
+            using ukey = typename traits::type;
+            constexpr int bytes = sizeof(ukey);
+            auto key_of = [&key](const T &value) { return traits::to_unsigned(key(value)); };
+            size_t n = last - first;
+            size_t count[bytes][256] = {};
+            for (RandomIt it = first; it != last; ++it) {
+                ukey k = key_of(*it);
+                for (int b = 0; b < bytes; ++b) ++count[b][(k >> (b * 8)) & 0xff];
+            }
+            ukey first_key = key_of(*first);
+            bool in_buf = false;
+            for (int b = 0; b < bytes; ++b) {
+                if (count[b][(first_key >> (b * 8)) & 0xff] == n) continue;
+                size_t offset[256], sum = 0;
+                for (int i = 0; i < 256; ++i) offset[i] = sum, sum += count[b][i];
+                if (in_buf) radix_scatter(buf, buf + n, first, offset, b, key_of);
+                else radix_scatter(first, last, buf, offset, b, key_of);
+                in_buf = !in_buf;
+            }
+            if (in_buf) for (size_t i = 0; i < n; ++i) *(first + i) = std::move(buf[i]);
+        }
+
+        // 字符串key第depth位的字符 , 0表示字符串在此之前结束 , 否则为字符+1
+        inline size_t radix_char_at(const std::string &s, size_t depth) {
+            return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1 : 0;
+        }
+
+        // MSD基数排序(American flag) , 按第depth个字符原地分配到257个桶 , 再递归处理除了0号桶以外的每个桶
+        // 原地分配 : 每个桶维护下一个待放置的位置 , 不断把当前元素交换到其所属桶中 , 直到换回一个属于本桶的元素
+        template<typename RandomIt, typename Key>
+        void radix_sort_msd(RandomIt first, RandomIt last, Key &key, size_t depth) {
+            while (true) {
+                ptrdiff_t n = last - first;
+                if (n < radix_string_small) {
+                    // 前depth个字符都相同 , 只比较之后的部分
+                    ttl::sort(first, last, [&key, depth](const auto &a, const auto &b) {
+                        const std::string &ka = key(a), &kb = key(b);
+                        return ka.compare(ttl::min(depth, ka.size()), std::string::npos,
+                                          kb, ttl::min(depth, kb.size()), std::string::npos) < 0;
+                    });
+                    return;
+                }
+                size_t count[257] = {};
+                for (RandomIt it = first; it != last; ++it) ++count[radix_char_at(key(*it), depth)];
+                // 所有字符串在depth处字符都相同 , 不需要分配
+                size_t only = radix_char_at(key(*first), depth);
+                if (count[only] == size_t(n)) {
+                    if (only == 0) return;
+                    ++depth;
+                    continue;
+                }
+                ptrdiff_t head[257], tail[257], sum = 0;
+                for (int i = 0; i < 257; ++i) head[i] = sum, sum += count[i], tail[i] = sum;
+                for (int i = 0; i < 257; ++i) {
+                    while (head[i] < tail[i]) {
+                        size_t c = radix_char_at(key(*(first + head[i])), depth);
+                        if (c == size_t(i)) ++head[i];
+                        else std::swap(*(first + head[i]), *(first + head[c]++));
+                    }
+                }
+                // head[i]此时等于桶i的末尾
+                for (int i = 1; i < 257; ++i) {
+                    ptrdiff_t begin = head[i] - ptrdiff_t(count[i]);
+                    if (count[i] > 1) radix_sort_msd(first + begin, first + head[i], key, depth + 1);
+                }
+                return;
+            }
+        }
+    }
+
+    // 基数排序 , 按key(元素)升序
+    // 整数与浮点key使用LSD , 稳定 , O(n * key字节数) , 需要n个元素的缓冲区
+    // buffer为调用者提供的至少n个元素的缓冲区 , 为nullptr时内部申请 , 申请失败时退化为stable_sort
+    // 浮点数中NaN会按位模式排在两端
+    // std::string key使用原地的MSD(American flag) , 不稳定且不使用缓冲区 , key应返回const std::string &
+    template<typename RandomIt, typename Key = identity_key>
+    void radix_sort(RandomIt first, RandomIt last, Key key = Key(),
+                    std::decay_t<decltype(*first)> *buffer = nullptr) {
+        using value_type = std::decay_t<decltype(*first)>;
+        using key_type = std::decay_t<decltype(key(*first))>;
+        if (last - first < 2) return;
+        if constexpr(std::is_same_v<key_type, std::string>) {
+            radix_sort_msd(first, last, key, 0);
+        } else {
+            static_assert(std::is_arithmetic_v<key_type>, "radix_sort key must be arithmetic or std::string");
+            if (buffer) return radix_sort_lsd(first, last, key, buffer);
+            detail::temporary_buffer<value_type> buf(first, last - first);
+            if (buf.size() == last - first) return radix_sort_lsd(first, last, key, buf.data());
+            ttl::stable_sort(first, last, [&key](const value_type &a, const value_type &b) {
+                return radix_key_traits<key_type>::to_unsigned(key(a)) < radix_key_traits<key_type>::to_unsigned(key(b));
+            });
+        }
+    }
+}
+
+#endif //TINYSTL_RADIX_SORT_H
@@ -0,0 +1,510 @@
+﻿#ifndef TINYSTL_SIMD_H
+#define TINYSTL_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "bit.h"
+#include "../iterator/iterator.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define TTL_SIMD_X86
+#include <immintrin.h>
+#endif
+
+// 连续存储的算术类型序列上的向量化内核 , 供algorithm.h中的查找/计数/最值/比较 , 以及bitset的批量位运算使用
+// 内核用GCC向量扩展写成与宽度无关的模板 , 16字节即SSE2(非x86平台上由编译器映射到对应的指令集)
+// x86上另外以target("avx2")实例化32字节版本 , 运行时按cpuid选择
+namespace ttl {
+    namespace {
+        template<typename It>
+        using simd_value_t = std::remove_cv_t<std::remove_reference_t<decltype(*std::declval<It>())>>;
+
+        // 元素为1/2/4/8字节的算术类型 , 不包括bool与long double
+        template<typename T>
+        constexpr bool simd_arithmetic_v = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                           (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+        // 已知连续存储的迭代器 : 指针 , ttl::vector , std::vector与std::string的迭代器
+        template<typename It, typename T, bool = simd_arithmetic_v<T>>
+        struct simd_contiguous : std::is_pointer<It> {};
+
+        template<typename P, typename C, typename T>
+        struct simd_contiguous<ttl::normal_iterator<P, C>, T, true> : std::is_pointer<P> {};
+
+        template<typename It, typename T>
+        struct simd_contiguous<It, T, true> : std::bool_constant<
+                std::is_pointer_v<It> ||
+                std::is_same_v<It, typename std::vector<T>::iterator> ||
+                std::is_same_v<It, typename std::vector<T>::const_iterator> ||
+                (std::is_same_v<T, char> && (std::is_same_v<It, std::string::iterator> ||
+                                             std::is_same_v<It, std::string::const_iterator>))> {
+        };
+
+        // 可以交给向量化内核的迭代器
+        template<typename It>
+        constexpr bool simd_eligible_v = simd_arithmetic_v<simd_value_t<It>> &&
+                                         simd_contiguous<It, simd_value_t<It>>::value;
+
+        // 两个序列的元素类型相同 , 可以逐段比较
+        template<typename It1, typename It2>
+        constexpr bool simd_comparable_v = simd_eligible_v<It1> && simd_eligible_v<It2> &&
+                                           std::is_same_v<simd_value_t<It1>, simd_value_t<It2>>;
+
+        // 用value查找It中的元素 , 整数之间按转换规则比较 , 浮点数要求类型相同
+        template<typename It, typename V>
+        constexpr bool simd_searchable_v = simd_eligible_v<It> &&
+                                           ((std::is_integral_v<simd_value_t<It>> && std::is_integral_v<V>) ||
+                                            std::is_same_v<simd_value_t<It>, V>);
+
+        // it必须可以解引用
+        template<typename It>
+        auto simd_address(It it) { return &*it; }
+
+        // unaligned只要求元素对齐 , 且可以与元素类型互为别名 , 用于非对齐读取
+        template<typename T, size_t W>
+        struct simd_vector {
+            typedef T type __attribute__((vector_size(W)));
+            typedef T unaligned __attribute__((vector_size(W), aligned(alignof(T)), may_alias));
+        };
+
+        template<typename T, size_t W>
+        using simd_vector_t = typename simd_vector<T, W>::type;
+
+        // 以V的宽度非对齐读取p , 返回引用而不是值
+        // 32字节的内核在未启用AVX的函数中实例化 , 按值返回向量会改变ABI(-Wpsabi) , 向量都按引用传递
+        template<typename V, typename T>
+        [[gnu::always_inline]] inline const typename simd_vector<T, sizeof(V)>::unaligned &simd_load(const T *p) {
+            return *reinterpret_cast<const typename simd_vector<T, sizeof(V)>::unaligned *>(p);
+        }
+
+        // 比较结果中是否有为真的通道
+        template<typename M>
+        [[gnu::always_inline]] inline bool simd_any(const M &mask) {
+            using lanes = simd_vector_t<uint64_t, sizeof(M)>;
+            auto x = (lanes) mask;
+            uint64_t ret = x[0];
+            for (size_t i = 1; i < sizeof(M) / 8; ++i) ret |= x[i];
+            return ret != 0;
+        }
+
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline const T *simd_find_kernel(const T *first, const T *last, T value) {
+            using vec = simd_vector_t<T, W>;
+            constexpr ptrdiff_t lanes = W / sizeof(T);
+            const vec key = vec{} + value;
+            for (; last - first >= 4 * lanes; first += 4 * lanes) { // 展开4次 , 每次只检测一次
+                auto m = (simd_load<vec>(first) == key) | (simd_load<vec>(first + lanes) == key) |
+                         (simd_load<vec>(first + 2 * lanes) == key) | (simd_load<vec>(first + 3 * lanes) == key);
+                if (simd_any(m)) break;
+            }
+            for (; last - first >= lanes; first += lanes) {
+                if (simd_any(simd_load<vec>(first) == key)) break;
+            }
+            for (; first != last; ++first) if (*first == value) break;
+            return first;
+        }
+
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline size_t simd_count_kernel(const T *first, const T *last, T value) {
+            using vec = simd_vector_t<T, W>;
+            using mask = decltype(vec{} == vec{});
+            constexpr ptrdiff_t lanes = W / sizeof(T);
+            constexpr ptrdiff_t flush = 127; // 相等的通道为-1 , 逐通道累加 , 8位通道每127次归约一次防止溢出
+            const vec key = vec{} + value;
+            size_t ret = 0;
+            while (last - first >= lanes) {
+                ptrdiff_t rounds = (last - first) / lanes;
+                if (rounds > flush) rounds = flush;
+                mask acc{};
+                for (const T *stop = first + rounds * lanes; first != stop; first += lanes) {
+                    acc -= simd_load<vec>(first) == key;
+                }
+                for (ptrdiff_t i = 0; i < lanes; ++i) ret += size_t(acc[i]);
+            }
+            for (; first != last; ++first) if (*first == value) ++ret;
+            return ret;
+        }
+
+        // 第一个满足!(*first1 == *first2)的位置
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline const T *simd_mismatch_kernel(const T *first1, const T *last1, const T *first2) {
+            using vec = simd_vector_t<T, W>;
+            constexpr ptrdiff_t lanes = W / sizeof(T);
+            for (; last1 - first1 >= 2 * lanes; first1 += 2 * lanes, first2 += 2 * lanes) {
+                auto m = (simd_load<vec>(first1) != simd_load<vec>(first2)) |
+                         (simd_load<vec>(first1 + lanes) != simd_load<vec>(first2 + lanes));
+                if (simd_any(m)) break;
+            }
+            for (; first1 != last1; ++first1, ++first2) if (!(*first1 == *first2)) break;
+            return first1;
+        }
+
+        // 第一个最小(Max为false)或最大的元素 , 区间非空 , 遇到NaN时返回nullptr
+        // 逐块求最值 , 只记录第一个严格更优的块 , 最后在该块中查找第一个等于最值的元素
+        template<size_t W, bool Max, typename T>
+        [[gnu::always_inline]] inline const T *simd_extreme_kernel(const T *first, const T *last) {
+            using vec = simd_vector_t<T, W>;
+            using mask = decltype(vec{} == vec{});
+            constexpr ptrdiff_t lanes = W / sizeof(T);
+            constexpr ptrdiff_t block = 4096 / sizeof(T);
+            auto better = [](T a, T b) { return Max ? b < a : a < b; };
+            T best = *first;
+            const T *best_block = first;
+            mask nan{};
+            bool scalar_nan = false;
+            for (const T *lo = first, *hi; lo != last; lo = hi) {
+                hi = last - lo > block ? lo + block : last;
+                const T *p = lo;
+                T m = *lo;
+                if (hi - lo >= lanes) {
+                    vec acc = simd_load<vec>(lo);
+                    if constexpr (std::is_floating_point_v<T>) nan |= acc != acc;
+                    for (p = lo + lanes; hi - p >= lanes; p += lanes) {
+                        vec x = simd_load<vec>(p);
+                        if constexpr (std::is_floating_point_v<T>) nan |= x != x;
+                        acc = Max ? (acc < x ? x : acc) : (x < acc ? x : acc);
+                    }
+                    m = acc[0];
+                    for (ptrdiff_t i = 1; i < lanes; ++i) if (better(acc[i], m)) m = acc[i];
+                }
+                for (; p != hi; ++p) {
+                    if constexpr (std::is_floating_point_v<T>) scalar_nan |= *p != *p;
+                    if (better(*p, m)) m = *p;
+                }
+                if (better(m, best)) best = m, best_block = lo;
+            }
+            if (scalar_nan || simd_any(nan)) return nullptr;
+            return simd_find_kernel<W>(best_block, last, best);
+        }
+
+        // 按字的位运算 , simd_first只取第一个操作数 , 用于单个序列的popcount
+        enum simd_bit_op { simd_first, simd_and, simd_or, simd_xor, simd_and_not, simd_not };
+
+        // a = a op b , 标量 , 向量扩展类型与__m256i都适用 , 原地修改以免按值返回向量
+        template<simd_bit_op Op, typename V, typename B>
+        [[gnu::always_inline]] inline void simd_apply(V &a, const B &b) {
+            if constexpr (Op == simd_and) a = a & b;
+            else if constexpr (Op == simd_or) a = a | b;
+            else if constexpr (Op == simd_xor) a = a ^ b;
+            else if constexpr (Op == simd_and_not) a = a & ~b;
+            else if constexpr (Op == simd_not) a = ~a;
+        }
+
+        // 标量的a op b
+        template<simd_bit_op Op, typename T>
+        [[gnu::always_inline]] inline T simd_apply_word(T a, T b) {
+            simd_apply<Op>(a, b);
+            return a;
+        }
+
+        template<typename V, typename T>
+        [[gnu::always_inline]] inline void simd_store(T *p, const V &v) {
+            __builtin_memcpy(p, &v, sizeof(V));
+        }
+
+        // dst[i] = dst[i] op src[i]
+        template<size_t W, simd_bit_op Op, typename T>
+        [[gnu::always_inline]] inline void simd_bitwise_kernel(T *dst, const T *src, size_t n) {
+            using vec = simd_vector_t<T, W>;
+            constexpr size_t lanes = W / sizeof(T);
+            size_t i = 0;
+            for (; i + 2 * lanes <= n; i += 2 * lanes) {
+                vec x0 = simd_load<vec>(dst + i), x1 = simd_load<vec>(dst + i + lanes);
+                if constexpr (Op == simd_first || Op == simd_not) { // 一元运算时不读取src
+                    simd_apply<Op>(x0, x0), simd_apply<Op>(x1, x1);
+                } else {
+                    simd_apply<Op>(x0, simd_load<vec>(src + i)), simd_apply<Op>(x1, simd_load<vec>(src + i + lanes));
+                }
+                simd_store(dst + i, x0), simd_store(dst + i + lanes, x1);
+            }
+            for (; i < n; ++i) simd_apply<Op>(dst[i], Op == simd_not ? T() : src[i]);
+        }
+
+        // 原地左移 : data[i] = data[i - words] << bits | data[i - words - 1] >> (digit - bits) , 0 < bits < digit
+        // 从高位向低位处理 , 每次读取的位置都低于已经写入的位置 , 因此不会读到移动后的值
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline void simd_shift_left_kernel(T *data, size_t n, size_t words, unsigned bits) {
+            using vec = simd_vector_t<T, W>;
+            constexpr size_t lanes = W / sizeof(T), digit = sizeof(T) * 8;
+            size_t i = n; // 还需写入[words + 1, i)
+            for (; i >= words + 1 + lanes; i -= lanes) {
+                const T *src = data + i - lanes - words;
+                simd_store(data + i - lanes, (simd_load<vec>(src) << bits) | (simd_load<vec>(src - 1) >> (digit - bits)));
+            }
+            for (; i > words + 1; --i) {
+                data[i - 1] = (data[i - 1 - words] << bits) | (data[i - 2 - words] >> (digit - bits));
+            }
+            data[words] = data[0] << bits;
+        }
+
+        // 原地右移 : data[i] = data[i + words] >> bits | data[i + words + 1] << (digit - bits) , 0 < bits < digit
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline void simd_shift_right_kernel(T *data, size_t n, size_t words, unsigned bits) {
+            using vec = simd_vector_t<T, W>;
+            constexpr size_t lanes = W / sizeof(T), digit = sizeof(T) * 8;
+            size_t keep = n - words, i = 0;
+            for (; i + lanes < keep; i += lanes) {
+                const T *src = data + i + words;
+                simd_store(data + i, (simd_load<vec>(src) >> bits) | (simd_load<vec>(src + 1) << (digit - bits)));
+            }
+            for (; i + 1 < keep; ++i) data[i] = (data[i + words] >> bits) | (data[i + words + 1] << (digit - bits));
+            data[keep - 1] = data[n - 1] >> bits;
+        }
+
+        // [first,last)中的字是否都等于value
+        template<size_t W, typename T>
+        [[gnu::always_inline]] inline bool simd_all_of_kernel(const T *first, const T *last, T value) {
+            using vec = simd_vector_t<T, W>;
+            constexpr ptrdiff_t lanes = W / sizeof(T);
+            const vec key = vec{} + value;
+            for (; last - first >= 4 * lanes; first += 4 * lanes) {
+                vec diff = (simd_load<vec>(first) ^ key) | (simd_load<vec>(first + lanes) ^ key) |
+                           (simd_load<vec>(first + 2 * lanes) ^ key) | (simd_load<vec>(first + 3 * lanes) ^ key);
+                if (simd_any(diff)) return false;
+            }
+            for (; first != last; ++first) if (*first != value) return false;
+            return true;
+        }
+
+        // Hardware为true时调用者需要以target("popcnt")编译
+        template<bool Hardware>
+        [[gnu::always_inline]] inline size_t simd_popcount64(uint64_t x) {
+            if constexpr (Hardware) return __builtin_popcountll(x);
+            else return popcount64(x);
+        }
+
+        // popcount(a[i] op b[i])之和 , 4路累加打破依赖链
+        template<bool Hardware, simd_bit_op Op, typename T>
+        [[gnu::always_inline]] inline size_t simd_popcount_kernel(const T *a, const T *b, size_t n) {
+            size_t c0 = 0, c1 = 0, c2 = 0, c3 = 0, i = 0;
+            for (; i + 4 <= n; i += 4) {
+                c0 += simd_popcount64<Hardware>(simd_apply_word<Op>(a[i], b[i]));
+                c1 += simd_popcount64<Hardware>(simd_apply_word<Op>(a[i + 1], b[i + 1]));
+                c2 += simd_popcount64<Hardware>(simd_apply_word<Op>(a[i + 2], b[i + 2]));
+                c3 += simd_popcount64<Hardware>(simd_apply_word<Op>(a[i + 3], b[i + 3]));
+            }
+            for (; i < n; ++i) c0 += simd_popcount64<Hardware>(simd_apply_word<Op>(a[i], b[i]));
+            return c0 + c1 + c2 + c3;
+        }
+
+#ifdef TTL_SIMD_X86
+
+        inline bool simd_has_avx2() {
+            static const bool ret = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+            return ret;
+        }
+
+        inline bool simd_has_popcnt() {
+            static const bool ret = (__builtin_cpu_init(), __builtin_cpu_supports("popcnt"));
+            return ret;
+        }
+
+        inline bool simd_has_bmi2() {
+            static const bool ret = (__builtin_cpu_init(), __builtin_cpu_supports("bmi2"));
+            return ret;
+        }
+
+        template<simd_bit_op Op, typename T>
+        [[gnu::target("popcnt")]] size_t simd_popcount_popcnt(const T *a, const T *b, size_t n) {
+            return simd_popcount_kernel<true, Op>(a, b, n);
+        }
+
+        // 每个字节的高低4位分别查表(vpshufb) , 再用vpsadbw把字节和累加为4个64位整数
+        [[gnu::target("avx2"), gnu::always_inline]] inline __m256i simd_popcount256(__m256i v) {
+            const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i low = _mm256_set1_epi8(0x0f);
+            __m256i lo = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, low));
+            __m256i hi = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), low));
+            return _mm256_sad_epu8(_mm256_add_epi8(lo, hi), _mm256_setzero_si256());
+        }
+
+        // 进位保留加法器 : 三个输入的每一位相加 , high为进位 , low为本位
+        [[gnu::target("avx2"), gnu::always_inline]] inline void
+        simd_csa(__m256i &high, __m256i &low, __m256i a, __m256i b, __m256i c) {
+            __m256i u = _mm256_xor_si256(a, b);
+            high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+            low = _mm256_xor_si256(u, c);
+        }
+
+        template<simd_bit_op Op>
+        [[gnu::target("avx2"), gnu::always_inline]] inline __m256i
+        simd_load256(const __m256i *a, const __m256i *b, ptrdiff_t i) {
+            __m256i x = _mm256_loadu_si256(a + i);
+            if constexpr (Op != simd_first) simd_apply<Op>(x, _mm256_loadu_si256(b + i));
+            return x;
+        }
+
+        // Harley-Seal : 用进位保留加法器把16个向量压缩为ones/twos/fours/eights/sixteens
+        // 每16个向量只对sixteens做一次查表计数 , 其余的权重在最后计入
+        template<simd_bit_op Op, typename T>
+        [[gnu::target("avx2,popcnt")]] size_t simd_popcount_avx2(const T *a, const T *b, size_t n) {
+            constexpr size_t words = 32 / sizeof(T);
+            if (n < 16 * words) return simd_popcount_kernel<true, Op>(a, b, n);
+            auto da = reinterpret_cast<const __m256i *>(a), db = reinterpret_cast<const __m256i *>(b);
+            ptrdiff_t vectors = ptrdiff_t(n / words), i = 0;
+            __m256i total = _mm256_setzero_si256(), ones = total, twos = total, fours = total, eights = total;
+            __m256i sixteens, twos_a, twos_b, fours_a, fours_b, eights_a, eights_b;
+            for (; i + 16 <= vectors; i += 16) {
+                simd_csa(twos_a, ones, ones, simd_load256<Op>(da, db, i), simd_load256<Op>(da, db, i + 1));
+                simd_csa(twos_b, ones, ones, simd_load256<Op>(da, db, i + 2), simd_load256<Op>(da, db, i + 3));
+                simd_csa(fours_a, twos, twos, twos_a, twos_b);
+                simd_csa(twos_a, ones, ones, simd_load256<Op>(da, db, i + 4), simd_load256<Op>(da, db, i + 5));
+                simd_csa(twos_b, ones, ones, simd_load256<Op>(da, db, i + 6), simd_load256<Op>(da, db, i + 7));
+                simd_csa(fours_b, twos, twos, twos_a, twos_b);
+                simd_csa(eights_a, fours, fours, fours_a, fours_b);
+                simd_csa(twos_a, ones, ones, simd_load256<Op>(da, db, i + 8), simd_load256<Op>(da, db, i + 9));
+                simd_csa(twos_b, ones, ones, simd_load256<Op>(da, db, i + 10), simd_load256<Op>(da, db, i + 11));
+                simd_csa(fours_a, twos, twos, twos_a, twos_b);
+                simd_csa(twos_a, ones, ones, simd_load256<Op>(da, db, i + 12), simd_load256<Op>(da, db, i + 13));
+                simd_csa(twos_b, ones, ones, simd_load256<Op>(da, db, i + 14), simd_load256<Op>(da, db, i + 15));
+                simd_csa(fours_b, twos, twos, twos_a, twos_b);
+                simd_csa(eights_b, fours, fours, fours_a, fours_b);
+                simd_csa(sixteens, eights, eights, eights_a, eights_b);
+                total = _mm256_add_epi64(total, simd_popcount256(sixteens));
+            }
+            total = _mm256_slli_epi64(total, 4);
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(simd_popcount256(eights), 3));
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(simd_popcount256(fours), 2));
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(simd_popcount256(twos), 1));
+            total = _mm256_add_epi64(total, simd_popcount256(ones));
+            for (; i < vectors; ++i) total = _mm256_add_epi64(total, simd_popcount256(simd_load256<Op>(da, db, i)));
+            size_t ret = size_t(_mm256_extract_epi64(total, 0)) + size_t(_mm256_extract_epi64(total, 1)) +
+                         size_t(_mm256_extract_epi64(total, 2)) + size_t(_mm256_extract_epi64(total, 3));
+            size_t done = size_t(vectors) * words;
+            return ret + simd_popcount_kernel<true, Op>(a + done, b + done, n - done);
+        }
+
+        template<simd_bit_op Op, typename T>
+        [[gnu::target("avx2")]] void simd_bitwise_avx2(T *dst, const T *src, size_t n) {
+            simd_bitwise_kernel<32, Op>(dst, src, n);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] void simd_shift_left_avx2(T *data, size_t n, size_t words, unsigned bits) {
+            simd_shift_left_kernel<32>(data, n, words, bits);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] void simd_shift_right_avx2(T *data, size_t n, size_t words, unsigned bits) {
+            simd_shift_right_kernel<32>(data, n, words, bits);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] bool simd_all_of_avx2(const T *first, const T *last, T value) {
+            return simd_all_of_kernel<32>(first, last, value);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] const T *simd_find_avx2(const T *first, const T *last, T value) {
+            return simd_find_kernel<32>(first, last, value);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] size_t simd_count_avx2(const T *first, const T *last, T value) {
+            return simd_count_kernel<32>(first, last, value);
+        }
+
+        template<typename T>
+        [[gnu::target("avx2")]] const T *simd_mismatch_avx2(const T *first1, const T *last1, const T *first2) {
+            return simd_mismatch_kernel<32>(first1, last1, first2);
+        }
+
+        template<bool Max, typename T>
+        [[gnu::target("avx2")]] const T *simd_extreme_avx2(const T *first, const T *last) {
+            return simd_extreme_kernel<32, Max>(first, last);
+        }
+
+#endif
+
+        template<typename T>
+        const T *simd_find(const T *first, const T *last, T value) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_find_avx2(first, last, value);
+#endif
+            return simd_find_kernel<16>(first, last, value);
+        }
+
+        template<typename T>
+        size_t simd_count(const T *first, const T *last, T value) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_count_avx2(first, last, value);
+#endif
+            return simd_count_kernel<16>(first, last, value);
+        }
+
+        template<typename T>
+        const T *simd_mismatch(const T *first1, const T *last1, const T *first2) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_mismatch_avx2(first1, last1, first2);
+#endif
+            return simd_mismatch_kernel<16>(first1, last1, first2);
+        }
+
+        // popcount(a[i] op b[i])之和 , 一元运算时b不被读取
+        template<simd_bit_op Op, typename T>
+        size_t simd_popcount(const T *a, const T *b, size_t n) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_popcount_avx2<Op>(a, b, n);
+            if (simd_has_popcnt()) return simd_popcount_popcnt<Op>(a, b, n);
+#endif
+            return simd_popcount_kernel<false, Op>(a, b, n);
+        }
+
+        template<typename T>
+        size_t simd_popcount(const T *first, const T *last) {
+            return simd_popcount<simd_first>(first, first, size_t(last - first));
+        }
+
+        // dst[i] = dst[i] op src[i] , 一元运算时src不被读取
+        template<simd_bit_op Op, typename T>
+        void simd_bitwise(T *dst, const T *src, size_t n) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_bitwise_avx2<Op>(dst, src, n);
+#endif
+            simd_bitwise_kernel<16, Op>(dst, src, n);
+        }
+
+        // 把n个字组成的整数左移words个字又bits位 , 0 < bits < 字长 , 低位的words个字由调用者清零
+        template<typename T>
+        void simd_shift_left(T *data, size_t n, size_t words, unsigned bits) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_shift_left_avx2(data, n, words, bits);
+#endif
+            simd_shift_left_kernel<16>(data, n, words, bits);
+        }
+
+        // 右移 , 高位的words个字由调用者清零
+        template<typename T>
+        void simd_shift_right(T *data, size_t n, size_t words, unsigned bits) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_shift_right_avx2(data, n, words, bits);
+#endif
+            simd_shift_right_kernel<16>(data, n, words, bits);
+        }
+
+        template<typename T>
+        bool simd_all_of(const T *first, const T *last, T value) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_all_of_avx2(first, last, value);
+#endif
+            return simd_all_of_kernel<16>(first, last, value);
+        }
+
+        // 返回nullptr时由调用者用标量版本处理
+        template<bool Max, typename T>
+        const T *simd_extreme(const T *first, const T *last) {
+#ifdef TTL_SIMD_X86
+            if (simd_has_avx2()) return simd_extreme_avx2<Max>(first, last);
+#endif
+            // SSE2没有64位整数的比较指令 , 模拟的代价比标量更高
+            if constexpr (std::is_integral_v<T> && sizeof(T) == 8) return nullptr;
+            else return simd_extreme_kernel<16, Max>(first, last);
+        }
+    }
+}
+
+#endif //TINYSTL_SIMD_H
@@ -3,6 +3,7 @@
 #define TINYSTL_MEMORY_H
 
 #include <memory>
+#include <cstddef>
 /*
  * 内存相关的函数
  */
@@ -86,6 +87,96 @@ namespace ttl {
         }
     };
 
+    /*
+     * 结点内存池 , 用于链式容器中固定大小结点的分配
+     * 单个对象从该类型的空闲链表中分配 , 空闲链表为空时一次申请一整块 , 批量分配直接交给allocator
+     * 空闲链表是线程局部的 , 申请的内存块不归还给系统
+     */
+    template<typename T>
+    class pool_allocator {
+    public:
+        // 类型成员
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+        // 重新绑定
+        template<class U>
+        struct rebind {
+            typedef pool_allocator<U> other;
+        };
+    private:
+        union free_block {
+            free_block *next;
+            alignas(T) unsigned char data[sizeof(T)];
+        };
+
+        // 每次向系统申请的块数
+        static constexpr size_type chunk_size = sizeof(free_block) < 256 ? 4096 / sizeof(free_block) : 16;
+
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned type");
+
+    public:
+        pool_allocator() = default;
+
+        pool_allocator(const pool_allocator<T> &) = default;
+
+        template<typename U>
+        explicit pool_allocator(const pool_allocator<U> &) {}
+
+        ~pool_allocator() = default;
+
+    public:
+        static pointer address(reference x) { return allocator<T>::address(x); }
+
+        static const_pointer address(const_reference x) { return allocator<T>::address(x); }
+
+        static pointer allocate(size_type n) {
+            if (n != 1) return allocator<T>::allocate(n);
+            free_block *&head = free_list();
+            if (head == nullptr) refill(head);
+            free_block *ret = head;
+            head = head->next;
+            return reinterpret_cast<pointer>(ret);
+        }
+
+        static void deallocate(pointer p, size_type n) {
+            if (n != 1) return allocator<T>::deallocate(p, n);
+            if (p == nullptr) return;
+            auto *block = reinterpret_cast<free_block *>(p);
+            free_block *&head = free_list();
+            block->next = head, head = block;
+        }
+
+        constexpr static size_type max_size() { return allocator<T>::max_size(); }
+
+        template<class U, class... Args>
+        static void construct(U *p, Args &&... args) {
+            allocator<T>::construct(p, std::forward<Args>(args)...);
+        }
+
+        template<class U>
+        static void destroy(U *p) {
+            p->~U();
+        }
+
+    private:
+        static free_block *&free_list() {
+            thread_local free_block *head = nullptr;
+            return head;
+        }
+
+        static void refill(free_block *&head) {
+            auto *chunk = static_cast<free_block *>(::operator new(chunk_size * sizeof(free_block)));
+            for (size_type i = 0; i + 1 < chunk_size; ++i) chunk[i].next = chunk + i + 1;
+            chunk[chunk_size - 1].next = nullptr;
+            head = chunk;
+        }
+    };
+
     /*
      * 未初始化内存上的操作
      * Todo POD类型的优化
@@ -411,21 +411,22 @@ namespace ttl {
         void clear() { destroy_all_node(); }
 
         iterator insert(const_iterator pos, const value_type &value) {
-            iterator it = prepare_at(pos - start, 1);
-            *it = value;
-            return it;
+            return emplace(pos, value);
         }
 
         iterator insert(const_iterator pos, value_type &&value) {
-            iterator it = prepare_at(pos - start, 1);
-            *it = std::forward<value_type>(value);
-            return it;
+            return emplace(pos, std::move(value));
         }
 
         iterator insert(const_iterator pos, size_type count, const value_type &value) {
-            iterator it = prepare_at(pos - start, count);
-            while (count--) *it++ = value;
-            return it;
+            auto idx = pos - start;
+            if (count == 0) return start + idx;
+            if (pos != finish) {
+                // value可能引用了deque中将被移动的元素 , 只有在末尾插入时prepare_at不移动已有元素
+                value_type copy = value;
+                return construct_at(idx, count, [&copy](pointer p) { alloc_type::construct(p, copy); });
+            }
+            return construct_at(idx, count, [&value](pointer p) { alloc_type::construct(p, value); });
         }
 
         template<class InputIt>
@@ -436,8 +437,7 @@ namespace ttl {
                 while (first != last) insert(start + idx, *first++), ++idx;
             } else {
                 size_type count = ttl::distance(first, last);
-                iterator it = prepare_at(idx, count);
-                ttl::copy_n(first, count, it);
+                construct_at(idx, count, [&first](pointer p) { alloc_type::construct(p, *first), ++first; });
             }
             return start + idx;
         }
@@ -446,14 +446,19 @@ namespace ttl {
             return insert(pos, init.begin(), init.end());
         }
 
-        // Todo 性能分析+优化
         template<class... Args>
         iterator emplace(const_iterator pos, Args &&... args) {
-            auto idx = pos - start;
-            prepare_at(idx, 1);
-            auto it = start + idx;
-            destroy_and_construct(it.cur, std::forward<Args>(args)...);
-            return it;
+            if (pos == start) {
+                emplace_front(std::forward<Args>(args)...);
+                return start;
+            }
+            if (pos == finish) {
+                emplace_back(std::forward<Args>(args)...);
+                return finish - 1;
+            }
+            // 先构造出对象, 避免args引用了deque中将被移动的元素
+            value_type value(std::forward<Args>(args)...);
+            return construct_at(pos - start, 1, [&value](pointer p) { alloc_type::construct(p, std::move(value)); });
         }
 
         iterator erase(const_iterator pos) {
@@ -510,8 +515,9 @@ namespace ttl {
 
         template<typename ...Args>
         void emplace_back(Args &&...args) {
-            prepare_at_back(1);
-            destroy_and_construct((finish - 1).cur, std::forward<Args>(args)...);
+            iterator new_finish = reserve_at_back(1);
+            alloc_type::construct(finish.cur, std::forward<Args>(args)...);
+            finish = new_finish;
         }
 
         void pop_back() {
@@ -535,8 +541,9 @@ namespace ttl {
 
         template<typename ...Args>
         void emplace_front(Args &&...args) {
-            prepare_at_front(1);
-            destroy_and_construct(start.cur, std::forward<Args>(args)...);
+            iterator new_start = reserve_at_front(1);
+            alloc_type::construct(new_start.cur, std::forward<Args>(args)...);
+            start = new_start;
         }
 
         void pop_front() {
@@ -578,82 +585,129 @@ namespace ttl {
 #pragma endregion
 #pragma region
     private: // helper
-        // front处有几个空余元素位置
-        size_type front_leave() {
-            return difference_type(buffer_size) * (start.node - map_buffer) +
-                   (start.cur - start.first);
-        }
-
-        // back处有几个空余元素位置
-        size_type back_leave() {
-            return difference_type(buffer_size) * ((map_buffer + (map_size - 1)) - finish.node) +
-                   (finish.last - finish.cur);
-        }
-
-        // Todo 改为处于未初始化状态
-        // 腾出足够的空间 , 使得[start+index, start+index+count)处于默认构造状态
-        // 返回true表示左移(push_front) , 否则为右移(push_back)
-        // 功能更多 , 复杂度更高 , 会移动对对象 & 更新迭代器
-        // index = 0时等价于prepare_at_front
-        // index = size()时等价于prepare_at_back
+        // 腾出足够的空间 , 使得[start+index, start+index+count)处于未初始化状态
+        // 靠近哪一端就移动哪一端的元素 , 只在两端构造新对象 , 中间部分使用移动赋值
+        // 返回指向空位起点的迭代器 , 调用者负责在空位上构造count个对象
+        // index = 0时等价于在front处预留 , index = size()时等价于在back处预留
         iterator prepare_at(size_type index, size_type count) {
             size_type sz = size();
-            // index插入点之前的元素个数
+            difference_type n = difference_type(count);
             if (index < sz / 2) {
-                // 左移 front
-                prepare_at_front(count);
-                // [start + count ,) => [start ,) for index
-                ttl::move_n(start + difference_type(count), index, start);
+                // 左移 front , [start, pos) => [new_start, new_start + index)
+                iterator new_start = reserve_at_front(count);
+                iterator old_start = start, pos = start + difference_type(index);
+                if (index >= count) {
+                    // [old_start, old_start + n) => 未初始化的[new_start, old_start)
+                    ttl::uninitialized_move_n(old_start, count, new_start);
+                    // [old_start + n, pos) => [old_start, pos - n)
+                    ttl::move_n(old_start + n, index - count, old_start);
+                    ttl::destroy(pos - n, pos);
+                } else {
+                    ttl::uninitialized_move_n(old_start, index, new_start);
+                    ttl::destroy(old_start, pos);
+                }
+                start = new_start;
             } else {
-                // 右移 back
-                prepare_at_back(count);
-                // [, finish - count) => [, finish) for size() - index
-                ttl::move_n_backward(finish - difference_type(count), sz - index, finish);
+                // 右移 back , [pos, finish) => [pos + n, new_finish)
+                iterator new_finish = reserve_at_back(count);
+                iterator old_finish = finish, pos = start + difference_type(index);
+                size_type after = sz - index;
+                if (after > count) {
+                    // [old_finish - n, old_finish) => 未初始化的[old_finish, new_finish)
+                    ttl::uninitialized_move_n(old_finish - n, count, old_finish);
+                    // [pos, old_finish - n) => [pos + n, old_finish)
+                    ttl::move_n_backward(old_finish - n, after - count, old_finish);
+                    ttl::destroy(pos, pos + n);
+                } else {
+                    ttl::uninitialized_move_n(pos, after, pos + n);
+                    ttl::destroy(pos, old_finish);
+                }
+                finish = new_finish;
             }
             return start + difference_type(index);
         }
 
-        // 在front处腾出足够位置 , 并更新头迭代器
-        void prepare_at_front(size_type count) {
-            size_type leave = front_leave();
-            if (leave < count) {
-                // 空余不够 , 重新分配
-                recall_map_node((count - leave) / buffer_size + 1, true);
+        // prepare_at的逆操作 : [start+index, start+index+count)处于未初始化状态 , 把prepare_at移走的一端移回来合上空位
+        // 并释放多出来的缓冲区
+        void close_at(size_type index, size_type count) {
+            size_type sz = size() - count;
+            difference_type n = difference_type(count);
+            iterator pos = start + difference_type(index);
+            if (index < sz / 2) {
+                // 右移 front , [start, pos) => [start + n, pos + n)
+                iterator new_start = start + n;
+                if (index >= count) {
+                    ttl::uninitialized_move_n(pos - n, count, pos);
+                    ttl::move_n_backward(pos - n, index - count, pos);
+                    ttl::destroy(start, new_start);
+                } else {
+                    ttl::uninitialized_move_n(start, index, new_start);
+                    ttl::destroy(start, pos);
+                }
+                for (map_pointer cur = start.node; cur < new_start.node; ++cur) dealloc_node(*cur);
+                start = new_start;
+            } else {
+                // 左移 back , [pos + n, finish) => [pos, finish - n)
+                iterator new_finish = finish - n;
+                size_type after = sz - index;
+                if (after > count) {
+                    ttl::uninitialized_move_n(pos + n, count, pos);
+                    ttl::move_n(pos + 2 * n, after - count, pos + n);
+                    ttl::destroy(new_finish, finish);
+                } else {
+                    ttl::uninitialized_move_n(pos + n, after, pos);
+                    ttl::destroy(pos + n, finish);
+                }
+                for (map_pointer cur = new_finish.node + 1; cur <= finish.node; ++cur) dealloc_node(*cur);
+                finish = new_finish;
+            }
+        }
+
+        // 在index处腾出count个空位 , 依次用construct(指向空位的指针)构造 , 返回指向第一个新元素的迭代器
+        // 构造抛出异常时析构已构造的对象并合上空位 , deque恢复原状(要求移动不抛出异常)
+        template<typename Construct>
+        iterator construct_at(size_type index, size_type count, Construct construct) {
+            iterator gap = prepare_at(index, count), cur = gap;
+            try {
+                for (size_type i = 0; i < count; ++i, ++cur) construct(cur.cur);
+            } catch (...) {
+                ttl::destroy(gap, cur);
+                close_at(index, count);
+                throw;
             }
+            return gap;
+        }
+
+        // 在front处腾出count个未初始化的位置 , 返回新的头迭代器 , 不修改start
+        iterator reserve_at_front(size_type count) {
             size_type node_leave = start.cur - start.first;
             if (node_leave < count) {
-                // 当前缓冲区不够 , 申请缓冲区
-                size_type nodes = (count - node_leave) / buffer_size + 1;
+                // 当前缓冲区不够 , 需要在前面新增nodes个缓冲区
+                size_type nodes = (count - node_leave + buffer_size - 1) / buffer_size;
+                if (nodes > size_type(start.node - map_buffer)) {
+                    // map空余不够 , 重新分配
+                    recall_map_node(nodes, true);
+                }
                 map_pointer cur = start.node - 1;
                 while (nodes--) *cur-- = alloc_node();
             }
-            start -= difference_type(count);
-            uninitialized_default_construct_n(start, count);
+            return start - difference_type(count);
         }
 
-        // 在front处腾出足够位置 , 并更新尾迭代器
-        void prepare_at_back(size_type count) {
-            size_type leave = back_leave();
-            if (leave <= count) {
-                // 空余不够 , 重新分配map
-                recall_map_node((count - leave) / buffer_size + 1, false);
-            }
+        // 在back处腾出count个未初始化的位置 , 返回新的尾迭代器 , 不修改finish
+        iterator reserve_at_back(size_type count) {
             size_type node_leave = finish.last - finish.cur;
             if (node_leave <= count) {
-                // 当前缓冲区不够 , 申请缓冲区
+                // 当前缓冲区不够 , finish需要始终处于有效的缓冲区中
                 size_type nodes = (count - node_leave) / buffer_size + 1;
+                if (nodes > size_type((map_buffer + (map_size - 1)) - finish.node)) {
+                    // map空余不够 , 重新分配
+                    recall_map_node(nodes, false);
+                }
                 map_pointer cur = finish.node + 1;
                 while (nodes--) *cur++ = alloc_node();
             }
-            uninitialized_default_construct_n(finish, count);
-            finish += difference_type(count);
-        }
-
-        template<typename ...Args>
-        void destroy_and_construct(pointer ptr, Args &&...args) {
-            *ptr = std::move(value_type(std::forward<Args>(args)...));
-//            alloc_type::destroy(ptr);
-//            alloc_type::construct(ptr, std::forward<Args>(args)...);
+            return finish + difference_type(count);
         }
 
 #pragma endregion
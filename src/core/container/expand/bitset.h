@@ -9,6 +9,7 @@
 #include <cstring>
 #include <cassert>
 #include <memory>
+#include "../../algorithm/algorithm.h"
 
 namespace ttl {
     template<size_t N>
@@ -72,6 +73,66 @@ namespace ttl {
             }
         };
 
+        // 按升序访问值为1的位的下标 , 用countr_zero定位当前字中最低的1 , 跳过全0的字
+        class set_bit_iterator {
+            friend class bitset;
+
+            const bitset *ptr;
+            size_type index; // 当前字的下标 , 结束时为node_count
+            bitset::value_type rest; // 当前字中还没有访问的1
+        private:
+            set_bit_iterator(const bitset *who, size_type idx, bitset::value_type word) :
+                    ptr(who), index(idx), rest(word) {}
+
+            void skip() {
+                while (!rest) {
+                    if (++index >= node_count) return void(index = node_count);
+                    rest = ptr->node(index);
+                }
+            }
+
+        public:
+            using iterator_category = ttl::forward_iterator_tag;
+            using value_type = size_type;
+            using difference_type = ptrdiff_t;
+            using pointer = const size_type *;
+            using reference = size_type;
+
+            size_type operator*() const noexcept { return index * node_bit + ttl::countr_zero(rest); }
+
+            set_bit_iterator &operator++() noexcept {
+                rest &= rest - 1;
+                return skip(), *this;
+            }
+
+            set_bit_iterator operator++(int) noexcept {
+                set_bit_iterator ret = *this;
+                return ++*this, ret;
+            }
+
+            friend bool operator==(const set_bit_iterator &lhs, const set_bit_iterator &rhs) noexcept {
+                return lhs.index == rhs.index && lhs.rest == rhs.rest;
+            }
+
+            friend bool operator!=(const set_bit_iterator &lhs, const set_bit_iterator &rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        // for (size_t i: bs.set_bits())
+        class set_bit_view {
+            const bitset *ptr;
+        public:
+            explicit set_bit_view(const bitset *who) : ptr(who) {}
+
+            set_bit_iterator begin() const {
+                set_bit_iterator ret(ptr, 0, ptr->node(0));
+                return ret.skip(), ret;
+            }
+
+            set_bit_iterator end() const { return {ptr, node_count, 0}; }
+        };
+
 #pragma endregion
     private:
         value_type data[node_count];
@@ -86,11 +147,11 @@ namespace ttl {
             for (size_type i = 0; *val; ++val, ++i)if (*val == '1') set(i);
         }
 
+        bitset(const bitset &) = default;
+
         ~bitset() = default;
 
-        bitset &operator=(const bitset &oth) noexcept {
-            if (this != &oth) memcpy(data, oth.data, node_byte_count);
-        }
+        bitset &operator=(const bitset &) = default;
 
 #pragma endregion
     public: // visit
@@ -111,77 +172,79 @@ namespace ttl {
         }
 
         bool all() const {
-            for (size_type i = 0; i < node_count - 1; ++i) {
-                if (data[i] != mask_full_node) return false;
-            }
-            return last() == mask_last_node;
+            return simd_all_of(data, data + node_count - 1, mask_full_node) && last() == mask_last_node;
         }
 
         bool any() const {
-            for (size_type i = 0; i < node_count - 1; ++i) {
-                if (data[i] != 0) return true;
-            }
-            return last() != 0;
+            return !none();
         }
 
         bool none() const {
-            for (size_type i = 0; i < node_count - 1; ++i) {
-                if (data[i] != 0) return false;
-            }
-            return last() == 0;
+            return simd_all_of(data, data + node_count - 1, value_type(0)) && last() == 0;
         }
 
         size_type count() const {
-            size_t ret = 0;
-            for (size_type i = 0; i < node_count - 1; ++i) {
-                // ttl::popcount
-                ret += ttl::popcount64(data[i]);
-            }
-            return ret + ttl::popcount64(last());
+            return ttl::popcount(data, data + node_count - 1) + ttl::popcount(last());
+        }
+
+        // (*this & other).count() , 不构造临时对象
+        size_type and_count(const bitset &other) const {
+            return simd_popcount<simd_and>(data, other.data, node_count - 1) + ttl::popcount(last() & other.last());
+        }
+
+        // (*this | other).count() , 不构造临时对象
+        size_type or_count(const bitset &other) const {
+            return simd_popcount<simd_or>(data, other.data, node_count - 1) + ttl::popcount(last() | other.last());
         }
 
         size_type size() const { return N; }
 
 #pragma endregion
-    private: // change helper
+    public: // search
 #pragma region
 
-        // 确保0<offset<char_bit
-        // 将this[i]移动到this[i+offset]中
-        void do_left_move(size_t offset) {
-            auto *ptr = reinterpret_cast<unsigned char *>(data);
-            size_type ro = offset % char_bit, lo = char_bit - ro;
-            for (size_type i = node_byte_count - 1;;) {
-                ptr[i] = (ptr[i - 1] >> lo) | (ptr[i] << ro);
-                if (i-- == 1) break;
-            }
-            ptr[0] <<= ro;
+        // 第一个值为1的位 , 不存在时返回N , 下同
+        size_type find_first() const {
+            return find_from(0, node(0));
+        }
+
+        // 下标大于i的第一个值为1的位
+        size_type find_next(size_type i) const {
+            if (i + 1 >= N) return N;
+            ++i;
+            return find_from(i / node_bit, node(i / node_bit) & (mask_full_node << (i % node_bit)));
         }
 
-        // 将第i个byte块移动到i+n位置处
-        void do_left_by_char(size_t n) {
-            if (n == 0) return;
-            // 从前往后复制
-            auto *ptr = reinterpret_cast<unsigned char *> (data);
-            for (size_type i = node_byte_count - 1; i >= n; --i) {
-                ptr[i] = ptr[i - n];
+        // 最后一个值为1的位
+        size_type find_last() const {
+            return find_prev(N);
+        }
+
+        // 下标小于i的最后一个值为1的位
+        size_type find_prev(size_type i) const {
+            if (i == 0) return N;
+            if (i > N) i = N;
+            --i;
+            size_type w = i / node_bit;
+            value_type rest = node(w) & (mask_full_node >> (node_bit - 1 - i % node_bit));
+            while (!rest) {
+                if (w == 0) return N;
+                rest = node(--w);
             }
+            return w * node_bit + node_bit - 1 - ttl::countl_zero(rest);
         }
 
-        // 确保0<offset<char_bit
-        // 将this[i]移动到this[i-offset]中
-        void do_right_move(size_t offset) {
-            auto *ptr = reinterpret_cast<unsigned char *>(data);
-            size_type lo = offset % char_bit, ro = char_bit - lo;
-            for (size_type i = 0; i < node_byte_count - 1; ++i) {
-                ptr[i] = (ptr[i] >> lo) | (ptr[i + 1] << ro);
+        // 按升序对每个值为1的位的下标调用fn
+        template<typename Function>
+        Function for_each_set(Function fn) const {
+            for (size_type w = 0; w < node_count; ++w) {
+                for (value_type rest = node(w); rest; rest &= rest - 1) fn(w * node_bit + ttl::countr_zero(rest));
             }
-            ptr[node_byte_count - 1] >>= lo;
+            return fn;
         }
 
-        // 将第i个byte块移动到i-n位置处
-        void do_right_by_char(size_t n) {
-            memcpy((char *) (data), (char *) (data) + n, node_byte_count - n);
+        set_bit_view set_bits() const {
+            return set_bit_view(this);
         }
 
 #pragma endregion
@@ -189,51 +252,49 @@ namespace ttl {
 #pragma region
 
         bitset &operator&=(const bitset &other) {
-            for (size_type i = 0; i < node_count; ++i) data[i] &= other.data[i];
-            return last(), *this;
+            simd_bitwise<simd_and>(data, other.data, node_count);
+            return *this;
         }
 
         bitset &operator|=(const bitset &other) {
-            for (size_type i = 0; i < node_count; ++i) data[i] |= other.data[i];
-            return last(), *this;
+            simd_bitwise<simd_or>(data, other.data, node_count);
+            return *this;
         }
 
         bitset &operator^=(const bitset &other) {
-            for (size_type i = 0; i < node_count; ++i) data[i] ^= other.data[i];
-            return last(), *this;
+            simd_bitwise<simd_xor>(data, other.data, node_count);
+            return *this;
+        }
+
+        // *this &= ~other , 不构造临时对象
+        bitset &and_not(const bitset &other) {
+            simd_bitwise<simd_and_not>(data, other.data, node_count);
+            return *this;
         }
 
         bitset operator~() const {
             return bitset(*this).flip();
         }
 
+        // 整字移动 , 不足一个字的部分由相邻两个字拼接(funnel shift)
         bitset &operator<<=(size_t offset) {
             if (offset == 0) return *this;
             if (offset >= N) return reset();
-            if (offset % char_bit) do_left_move(offset % char_bit);
-            size_type char_cnt = offset / char_bit;
-            do_left_by_char(char_cnt);
-            // 低位补0
-            size_type start = char_cnt * char_bit, finish = offset;
-            memset(data, 0, char_cnt);
-            while (start < finish) set(start, false), ++start;
-
+            size_type words = offset / node_bit, bits = offset % node_bit;
+            if (bits == 0) memmove(data + words, data, (node_count - words) * node_size);
+            else simd_shift_left(data, node_count, words, unsigned(bits));
+            memset(data, 0, words * node_size); // 低位补0
             return last(), *this;
         }
 
         bitset &operator>>=(size_t offset) {
             if (offset == 0) return *this;
             if (offset >= N) return reset();
-            if (offset % char_bit) do_right_move(offset % char_bit);
-            size_type char_cnt = offset / char_bit;
-            do_right_by_char(char_cnt);
-
-            // 高位补0
-            size_type start = N - offset, index = (start - 1) / char_bit + 1, finish = index * char_bit;
-            memset((char *) (data) + index, 0, node_byte_count - index);
-            while (start < finish) set(start, false), ++start;
-
-            return last(), *this;
+            size_type words = offset / node_bit, bits = offset % node_bit, keep = node_count - words;
+            if (bits == 0) memmove(data, data + words, keep * node_size);
+            else simd_shift_right(data, node_count, words, unsigned(bits));
+            memset(data + keep, 0, words * node_size); // 高位补0
+            return *this;
         }
 
         void set(size_type i, bool value = true) {
@@ -252,7 +313,7 @@ namespace ttl {
         }
 
         bitset &flip() {
-            for (auto &v: data) v = ~v;
+            simd_bitwise<simd_not>(data, data, node_count);
             return last(), *this;
         }
 
@@ -276,21 +337,33 @@ namespace ttl {
 #pragma region
 
         friend bool operator==(const bitset &lhs, const bitset &rhs) noexcept {
-            return 0 == memcmp(lhs.data, rhs.data, node_byte_count - 1) && lhs.last() == rhs.last();
+            return 0 == memcmp(lhs.data, rhs.data, node_byte_count - node_size) && lhs.last() == rhs.last();
         }
 
         bool operator!=(const bitset &rhs) const noexcept {
             return !(*this == rhs);
         }
 
-        bitset operator<<(size_type offset) {
+        bitset operator<<(size_type offset) const {
             return bitset(*this) <<= offset;
         }
 
-        bitset operator>>(size_type offset) {
+        bitset operator>>(size_type offset) const {
             return bitset(*this) >>= offset;
         }
 
+        friend bitset operator&(const bitset &lhs, const bitset &rhs) {
+            return bitset(lhs) &= rhs;
+        }
+
+        friend bitset operator|(const bitset &lhs, const bitset &rhs) {
+            return bitset(lhs) |= rhs;
+        }
+
+        friend bitset operator^(const bitset &lhs, const bitset &rhs) {
+            return bitset(lhs) ^= rhs;
+        }
+
 #pragma endregion
     private: // else
 #pragma region
@@ -303,6 +376,19 @@ namespace ttl {
             return data[node_count - 1] & mask_last_node;
         }
 
+        value_type node(size_type i) const {
+            return i == node_count - 1 ? last() : data[i];
+        }
+
+        // 从第w个字起(第w个字只保留rest中的位)找第一个1
+        size_type find_from(size_type w, value_type rest) const {
+            while (!rest) {
+                if (++w >= node_count) return N;
+                rest = node(w);
+            }
+            return w * node_bit + ttl::countr_zero(rest);
+        }
+
         void set_aux(size_type i, bool value) {
             if (value) {
                 data[i / node_bit] |= make_mask(i % node_bit);
@@ -0,0 +1,547 @@
+﻿#ifndef TINYSTL_DYNAMIC_BITSET_H
+#define TINYSTL_DYNAMIC_BITSET_H
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include "../../algorithm/algorithm.h"
+
+namespace ttl {
+
+    // 变长bitset , 与bitset共用simd.h中的批量位运算/popcount/移位内核
+    // 字存储按64字节对齐 , 容量按整个缓存行分配
+    // 不变式 : 最后一个字中超出size()的位恒为0 , 因此整字的运算和计数不需要额外掩码
+    // 长度不同的两个对象运算时 , 较短的一方缺少的字视为0
+    class dynamic_bitset {
+    public:
+        using word_type = unsigned long long;
+        using size_type = size_t;
+
+        // 一个字的bit数
+        static constexpr size_type word_bit = sizeof(word_type) * CHAR_BIT;
+    private:
+        // 一个字的字节数
+        static constexpr size_type word_size = sizeof(word_type);
+        // 存储的对齐字节数 , 容量按此取整
+        static constexpr size_type align_size = 64;
+        // 一个缓存行的字数
+        static constexpr size_type line_words = align_size / word_size;
+        static constexpr word_type mask_full_word = word_type(-1);
+    public: // helper
+#pragma region
+
+        class reference {
+            friend class dynamic_bitset;
+
+            dynamic_bitset *ptr;
+            size_type i;
+        private:
+            reference(dynamic_bitset *who, size_type idx) : ptr(who), i(idx) {}
+
+        public:
+            reference() = delete;
+
+            reference(const reference &) = default;
+
+            ~reference() = default;
+
+            reference &operator=(const reference &) = default;
+
+        public:
+            reference &operator=(bool x) noexcept {
+                ptr->set_aux(i, x);
+                return *this;
+            }
+
+            operator bool() const noexcept { return ptr->get_aux(i); } // NOLINT(google-explicit-constructor)
+
+            bool operator~() const noexcept { return !bool(*this); }
+
+            reference &flip() noexcept {
+                ptr->set_aux(i, !ptr->get_aux(i));
+                return *this;
+            }
+        };
+
+        // 按升序访问值为1的位的下标 , 与bitset::set_bit_iterator相同
+        class set_bit_iterator {
+            friend class dynamic_bitset;
+
+            const word_type *words;
+            size_type index; // 当前字的下标 , 结束时为字数
+            size_type count; // 字数
+            word_type rest; // 当前字中还没有访问的1
+        private:
+            set_bit_iterator(const word_type *w, size_type idx, size_type cnt, word_type word) :
+                    words(w), index(idx), count(cnt), rest(word) {}
+
+            void skip() {
+                while (!rest) {
+                    if (++index >= count) return void(index = count);
+                    rest = words[index];
+                }
+            }
+
+        public:
+            using iterator_category = ttl::forward_iterator_tag;
+            using value_type = size_type;
+            using difference_type = ptrdiff_t;
+            using pointer = const size_type *;
+            using reference = size_type;
+
+            size_type operator*() const noexcept { return index * word_bit + ttl::countr_zero(rest); }
+
+            set_bit_iterator &operator++() noexcept {
+                rest &= rest - 1;
+                return skip(), *this;
+            }
+
+            set_bit_iterator operator++(int) noexcept {
+                set_bit_iterator ret = *this;
+                return ++*this, ret;
+            }
+
+            friend bool operator==(const set_bit_iterator &lhs, const set_bit_iterator &rhs) noexcept {
+                return lhs.index == rhs.index && lhs.rest == rhs.rest;
+            }
+
+            friend bool operator!=(const set_bit_iterator &lhs, const set_bit_iterator &rhs) noexcept {
+                return !(lhs == rhs);
+            }
+        };
+
+        // for (size_t i: bs.set_bits())
+        class set_bit_view {
+            const dynamic_bitset *ptr;
+        public:
+            explicit set_bit_view(const dynamic_bitset *who) : ptr(who) {}
+
+            set_bit_iterator begin() const {
+                size_type n = ptr->word_count();
+                set_bit_iterator ret(ptr->words, 0, n, n ? ptr->words[0] : 0);
+                return ret.skip(), ret;
+            }
+
+            set_bit_iterator end() const { return {ptr->words, ptr->word_count(), ptr->word_count(), 0}; }
+        };
+
+#pragma endregion
+    private:
+        word_type *words = nullptr;
+        size_type bit_count = 0;
+        size_type word_capacity = 0;
+    public: // constructors
+#pragma region
+
+        dynamic_bitset() noexcept = default;
+
+        explicit dynamic_bitset(size_type n, bool value = false) {
+            resize(n, value);
+        }
+
+        dynamic_bitset(const dynamic_bitset &oth) {
+            reserve(oth.bit_count);
+            copy_words(words, oth.words, oth.word_count());
+            bit_count = oth.bit_count;
+        }
+
+        dynamic_bitset(dynamic_bitset &&oth) noexcept:
+                words(oth.words), bit_count(oth.bit_count), word_capacity(oth.word_capacity) {
+            oth.words = nullptr, oth.bit_count = oth.word_capacity = 0;
+        }
+
+        ~dynamic_bitset() {
+            deallocate(words);
+        }
+
+        dynamic_bitset &operator=(const dynamic_bitset &oth) {
+            if (this != &oth) {
+                bit_count = 0;
+                reserve(oth.bit_count);
+                copy_words(words, oth.words, oth.word_count());
+                bit_count = oth.bit_count;
+            }
+            return *this;
+        }
+
+        dynamic_bitset &operator=(dynamic_bitset &&oth) noexcept {
+            dynamic_bitset(std::move(oth)).swap(*this);
+            return *this;
+        }
+
+        void swap(dynamic_bitset &oth) noexcept {
+            std::swap(words, oth.words);
+            std::swap(bit_count, oth.bit_count);
+            std::swap(word_capacity, oth.word_capacity);
+        }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        size_type size() const { return bit_count; }
+
+        bool empty() const { return bit_count == 0; }
+
+        size_type capacity() const { return word_capacity * word_bit; }
+
+        // 已使用的字数
+        size_type word_count() const { return (bit_count + word_bit - 1) / word_bit; }
+
+        // 按字直接读取 , 超出size()的位为0
+        const word_type *data() const { return words; }
+
+        void reserve(size_type n) {
+            size_type need = (n + word_bit - 1) / word_bit;
+            if (need > word_capacity) reallocate(need);
+        }
+
+        // 新增的位取value
+        void resize(size_type n, bool value = false) {
+            size_type old_words = word_count(), new_words = (n + word_bit - 1) / word_bit;
+            if (n <= bit_count) {
+                bit_count = n;
+                return trim();
+            }
+            grow_to(new_words);
+            if (value && bit_count % word_bit) words[old_words - 1] |= mask_full_word << (bit_count % word_bit);
+            fill_words(words + old_words, value ? mask_full_word : 0, new_words - old_words);
+            bit_count = n;
+            trim();
+        }
+
+        void clear() { bit_count = 0; }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        reference operator[](size_type i) {
+            check_pos(i);
+            return {this, i};
+        }
+
+        bool operator[](size_type i) const {
+            return test(i);
+        }
+
+        bool test(size_type i) const {
+            check_pos(i);
+            return get_aux(i);
+        }
+
+        bool all() const {
+            size_type n = word_count();
+            if (n == 0) return true;
+            return simd_all_of(words, words + n - 1, mask_full_word) && words[n - 1] == last_mask();
+        }
+
+        bool any() const {
+            return !none();
+        }
+
+        bool none() const {
+            return simd_all_of(words, words + word_count(), word_type(0));
+        }
+
+        size_type count() const {
+            return ttl::popcount(words, words + word_count());
+        }
+
+        // (*this & other).count() , 不构造临时对象
+        size_type and_count(const dynamic_bitset &other) const {
+            return simd_popcount<simd_and>(words, other.words, ttl::min(word_count(), other.word_count()));
+        }
+
+        // (*this | other).count() , 不构造临时对象 , 较长一方多出的字直接计数
+        size_type or_count(const dynamic_bitset &other) const {
+            size_type n = word_count(), m = other.word_count(), k = ttl::min(n, m);
+            const word_type *longer = n > m ? words : other.words;
+            return simd_popcount<simd_or>(words, other.words, k) + ttl::popcount(longer + k, longer + ttl::max(n, m));
+        }
+
+#pragma endregion
+    public: // search
+#pragma region
+
+        // 第一个值为1的位 , 不存在时返回size() , 下同
+        size_type find_first() const {
+            return word_count() ? find_from(0, words[0]) : bit_count;
+        }
+
+        // 下标大于i的第一个值为1的位
+        size_type find_next(size_type i) const {
+            if (i + 1 >= bit_count) return bit_count;
+            ++i;
+            return find_from(i / word_bit, words[i / word_bit] & (mask_full_word << (i % word_bit)));
+        }
+
+        // 最后一个值为1的位
+        size_type find_last() const {
+            return find_prev(bit_count);
+        }
+
+        // 下标小于i的最后一个值为1的位
+        size_type find_prev(size_type i) const {
+            if (i == 0) return bit_count;
+            if (i > bit_count) i = bit_count;
+            --i;
+            size_type w = i / word_bit;
+            word_type rest = words[w] & (mask_full_word >> (word_bit - 1 - i % word_bit));
+            while (!rest) {
+                if (w == 0) return bit_count;
+                rest = words[--w];
+            }
+            return w * word_bit + word_bit - 1 - ttl::countl_zero(rest);
+        }
+
+        // 按升序对每个值为1的位的下标调用fn
+        template<typename Function>
+        Function for_each_set(Function fn) const {
+            for (size_type w = 0, n = word_count(); w < n; ++w) {
+                for (word_type rest = words[w]; rest; rest &= rest - 1) fn(w * word_bit + ttl::countr_zero(rest));
+            }
+            return fn;
+        }
+
+        set_bit_view set_bits() const {
+            return set_bit_view(this);
+        }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        void push_back(bool value) {
+            size_type off = bit_count % word_bit, w = bit_count / word_bit;
+            if (off == 0) {
+                grow_to(w + 1);
+                words[w] = 0;
+            }
+            words[w] |= word_type(value) << off;
+            ++bit_count;
+        }
+
+        void pop_back() {
+            --bit_count;
+            trim();
+        }
+
+        // 在末尾追加一个字的64个位 , 字的最低位成为下标size()的位
+        void append(word_type word) {
+            size_type off = bit_count % word_bit, w = bit_count / word_bit;
+            grow_to(w + 1 + (off != 0));
+            if (off == 0) {
+                words[w] = word;
+            } else {
+                words[w] |= word << off;
+                words[w + 1] = word >> (word_bit - off);
+            }
+            bit_count += word_bit;
+        }
+
+        // 以下原地运算保持*this的长度 , other缺少的字视为0 , 超出*this长度的位被丢弃
+        dynamic_bitset &operator&=(const dynamic_bitset &other) {
+            size_type n = word_count(), k = ttl::min(n, other.word_count());
+            simd_bitwise<simd_and>(words, other.words, k);
+            fill_words(words + k, 0, n - k);
+            return *this;
+        }
+
+        dynamic_bitset &operator|=(const dynamic_bitset &other) {
+            simd_bitwise<simd_or>(words, other.words, ttl::min(word_count(), other.word_count()));
+            return trim(), *this;
+        }
+
+        dynamic_bitset &operator^=(const dynamic_bitset &other) {
+            simd_bitwise<simd_xor>(words, other.words, ttl::min(word_count(), other.word_count()));
+            return trim(), *this;
+        }
+
+        // *this &= ~other , 不构造临时对象
+        dynamic_bitset &and_not(const dynamic_bitset &other) {
+            simd_bitwise<simd_and_not>(words, other.words, ttl::min(word_count(), other.word_count()));
+            return *this;
+        }
+
+        dynamic_bitset operator~() const {
+            return dynamic_bitset(*this).flip();
+        }
+
+        // 整字移动 , 不足一个字的部分由相邻两个字拼接(funnel shift) , 长度不变
+        dynamic_bitset &operator<<=(size_type offset) {
+            if (offset == 0) return *this;
+            if (offset >= bit_count) return reset();
+            size_type n = word_count(), w = offset / word_bit, bits = offset % word_bit;
+            if (bits == 0) memmove(words + w, words, (n - w) * word_size);
+            else simd_shift_left(words, n, w, unsigned(bits));
+            fill_words(words, 0, w); // 低位补0
+            return trim(), *this;
+        }
+
+        dynamic_bitset &operator>>=(size_type offset) {
+            if (offset == 0) return *this;
+            if (offset >= bit_count) return reset();
+            size_type n = word_count(), w = offset / word_bit, bits = offset % word_bit, keep = n - w;
+            if (bits == 0) memmove(words, words + w, keep * word_size);
+            else simd_shift_right(words, n, w, unsigned(bits));
+            fill_words(words + keep, 0, w); // 高位补0
+            return *this;
+        }
+
+        void set(size_type i, bool value = true) {
+            check_pos(i);
+            set_aux(i, value);
+        }
+
+        dynamic_bitset &set() {
+            fill_words(words, mask_full_word, word_count());
+            return trim(), *this;
+        }
+
+        dynamic_bitset &reset() {
+            fill_words(words, 0, word_count());
+            return *this;
+        }
+
+        dynamic_bitset &reset(size_type i) {
+            set(i, false);
+            return *this;
+        }
+
+        dynamic_bitset &flip() {
+            simd_bitwise<simd_not>(words, words, word_count());
+            return trim(), *this;
+        }
+
+        dynamic_bitset &flip(size_type i) {
+            set(i, !test(i));
+            return *this;
+        }
+
+#pragma endregion
+    public: // convert
+#pragma region
+
+        // 与bitset::to_string相同 , 最高位在前
+        std::string to_string() const {
+            std::string ret(bit_count, '0');
+            for (size_type i = 0, j = bit_count - 1; i < bit_count; ++i, --j) if (get_aux(i)) ret[j] = '1';
+            return ret;
+        }
+
+#pragma endregion
+    public: // operator
+#pragma region
+
+        friend bool operator==(const dynamic_bitset &lhs, const dynamic_bitset &rhs) noexcept {
+            return lhs.bit_count == rhs.bit_count &&
+                   (lhs.bit_count == 0 || 0 == memcmp(lhs.words, rhs.words, lhs.word_count() * word_size));
+        }
+
+        bool operator!=(const dynamic_bitset &rhs) const noexcept {
+            return !(*this == rhs);
+        }
+
+        dynamic_bitset operator<<(size_type offset) const {
+            return dynamic_bitset(*this) <<= offset;
+        }
+
+        dynamic_bitset operator>>(size_type offset) const {
+            return dynamic_bitset(*this) >>= offset;
+        }
+
+        // 二元运算的结果取两者中较长的长度 , 较短的一方补0
+        friend dynamic_bitset operator&(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+            return lhs.size() >= rhs.size() ? dynamic_bitset(lhs) &= rhs : dynamic_bitset(rhs) &= lhs;
+        }
+
+        friend dynamic_bitset operator|(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+            return lhs.size() >= rhs.size() ? dynamic_bitset(lhs) |= rhs : dynamic_bitset(rhs) |= lhs;
+        }
+
+        friend dynamic_bitset operator^(const dynamic_bitset &lhs, const dynamic_bitset &rhs) {
+            return lhs.size() >= rhs.size() ? dynamic_bitset(lhs) ^= rhs : dynamic_bitset(rhs) ^= lhs;
+        }
+
+#pragma endregion
+    private: // else
+#pragma region
+
+        // 最后一个字的掩码
+        word_type last_mask() const {
+            return bit_count % word_bit ? (word_type(1) << (bit_count % word_bit)) - 1 : mask_full_word;
+        }
+
+        // 恢复不变式 : 清除最后一个字中超出size()的位
+        void trim() {
+            if (bit_count % word_bit) words[bit_count / word_bit] &= last_mask();
+        }
+
+        // 从第w个字起(第w个字只保留rest中的位)找第一个1
+        size_type find_from(size_type w, word_type rest) const {
+            for (size_type n = word_count(); !rest;) {
+                if (++w >= n) return bit_count;
+                rest = words[w];
+            }
+            return w * word_bit + ttl::countr_zero(rest);
+        }
+
+        // 保证至少有n个字的容量 , 按两倍增长
+        void grow_to(size_type n) {
+            if (n > word_capacity) reallocate(ttl::max(n, 2 * word_capacity));
+        }
+
+        void reallocate(size_type n) {
+            n = (n + line_words - 1) / line_words * line_words;
+            word_type *fresh = allocate(n);
+            copy_words(fresh, words, word_count());
+            deallocate(words);
+            words = fresh, word_capacity = n;
+        }
+
+        static word_type *allocate(size_type n) {
+            return static_cast<word_type *>(::operator new(n * word_size, std::align_val_t(align_size)));
+        }
+
+        static void deallocate(word_type *p) {
+            if (p) ::operator delete(p, std::align_val_t(align_size));
+        }
+
+        static void copy_words(word_type *dst, const word_type *src, size_type n) {
+            if (n) memcpy(dst, src, n * word_size);
+        }
+
+        // value只能是0或全1
+        static void fill_words(word_type *dst, word_type value, size_type n) {
+            if (n) memset(dst, int(value & 0xff), n * word_size);
+        }
+
+        void set_aux(size_type i, bool value) {
+            if (value) {
+                words[i / word_bit] |= make_mask(i % word_bit);
+            } else {
+                words[i / word_bit] &= ~make_mask(i % word_bit);
+            }
+        }
+
+        bool get_aux(size_type i) const {
+            return words[i / word_bit] & make_mask(i % word_bit);
+        }
+
+        void check_pos(size_type i) const {
+            if (i >= bit_count) throw std::out_of_range("dynamic_bitset visit outer");
+        }
+
+        static word_type make_mask(size_type i) {
+            return word_type(1) << i;
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_DYNAMIC_BITSET_H
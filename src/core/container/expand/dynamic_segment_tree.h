@@ -0,0 +1,198 @@
+﻿#ifndef TINYSTL_DYNAMIC_SEGMENT_TREE_H
+#define TINYSTL_DYNAMIC_SEGMENT_TREE_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include "segment_tree.h"
+
+namespace ttl {
+
+    // 动态开点线段树 , 维护[lo,hi]上的int64_t坐标 , 初始每个元素都是epsilon , 代数性质同segment_tree
+    // 结点只在修改需要分裂区间时创建 , 空间与修改触及的结点数成正比 , 每次修改至多新建O(64)个结点
+    // 查询不下传标记 , 而是把沿途结点上未下传的标记作用到交集的结果上 , 因此查询不会新建结点
+    // 结点存放在连续的结点池中 , 孩子用32位下标表示 , clear()只重置结点池(保留容量) , T可平凡析构时为O(1)
+    template<
+            typename T,
+            typename Merge = std::plus<T>,
+            typename RepeatType = int64_t,
+            typename Repeat = ttl::multiplies<T, RepeatType>
+    >
+    class dynamic_segment_tree {
+        static_assert(std::is_integral_v<RepeatType>); // 必须是整数
+    public:
+        using index_type = int64_t;
+        using size_type = size_t;
+    private:
+#pragma region 辅助类型
+        using node_index = uint32_t;
+
+        struct tree_node {
+            T merged;               // 合并后的结果
+            T add;                  // add的懒惰更新
+            T set;                  // set的懒惰节点
+            RepeatType mut;         // mut的懒惰节点
+            node_index left, right; // 孩子在结点池中的下标 , 0表示没有(0号为根)
+            bool on_setting;        // 记录是否激活了set标签
+        };
+#pragma endregion
+    private:
+#pragma region 成员变量
+        Merge merge;
+        Repeat repeat;
+        const T epsilon;
+
+        index_type lo, hi;
+        std::vector<tree_node> nodes; // 结点池
+#pragma endregion
+    public:
+#pragma region 生命周期
+
+        // 区间长度hi - lo + 1需能用RepeatType表示
+        dynamic_segment_tree(
+                index_type lo,
+                index_type hi,
+                Merge merge = {},
+                Repeat repeat = {},
+                const T &epsilon = {}
+        ) : merge(merge), repeat(repeat), epsilon(epsilon), lo(lo), hi(hi) {
+            if (lo > hi) throw std::invalid_argument("dynamic_segment_tree empty range");
+            nodes.push_back(empty_node());
+        }
+
+#pragma endregion
+    public:
+#pragma region 公开方法
+
+        // 获取[l,r]的merge结果
+        T get(index_type l, index_type r) const { return get(0, lo, hi, l, r); }
+
+        // 获取位于idx的元素
+        T get(index_type idx) const { return get(idx, idx); }
+
+        // 使得[l,r]每个元素都加val
+        void add(index_type l, index_type r, const T &val) {
+            update(0, lo, hi, l, r, [this, &val](node_index i, RepeatType w) { apply_add(i, w, val); });
+        }
+
+        // 使得[l,r]每个元素都乘k
+        void mut(index_type l, index_type r, RepeatType k) {
+            update(0, lo, hi, l, r, [this, k](node_index i, RepeatType) { apply_mut(i, k); });
+        }
+
+        // 使得[l,r]每个元素都等于val
+        void set(index_type l, index_type r, const T &val) {
+            update(0, lo, hi, l, r, [this, &val](node_index i, RepeatType w) { apply_set(i, w, val); });
+        }
+
+        // 所有元素恢复为epsilon , 结点池保留容量以便复用
+        void clear() {
+            nodes.clear();
+            nodes.push_back(empty_node());
+        }
+
+        // 预留结点池容量
+        void reserve(size_type n) { nodes.reserve(n); }
+
+        // 已创建的结点数
+        size_type node_count() const { return nodes.size(); }
+
+        // 结点池占用的字节数
+        size_type memory_bytes() const { return nodes.capacity() * sizeof(tree_node); }
+
+#pragma endregion
+    private:
+#pragma region 辅助实现
+
+        tree_node empty_node() const {
+            return {epsilon, epsilon, epsilon, 1, 0, 0, false};
+        }
+
+        // [l,r]的长度 , 用无符号数计算以免溢出
+        static RepeatType width(index_type l, index_type r) {
+            return RepeatType(uint64_t(r) - uint64_t(l) + 1);
+        }
+
+        static index_type middle(index_type l, index_type r) {
+            return l + index_type((uint64_t(r) - uint64_t(l)) / 2);
+        }
+
+        // 获取[s,t]与结点i的区间[l,r]的交集的merge结果
+        T get(node_index i, index_type l, index_type r, index_type s, index_type t) const {
+            const tree_node &node = nodes[i];
+            if (s <= l && r <= t) return node.merged;
+            index_type a = s > l ? s : l, b = t < r ? t : r;
+            RepeatType w = width(a, b);
+            // 没有孩子时区间内的元素从创建起都是epsilon , set会覆盖孩子的结果
+            T result = epsilon;
+            if (node.on_setting) {
+                result = repeat(node.set, w);
+            } else if (node.left != 0) {
+                index_type mid = middle(l, r);
+                if (a <= mid) result = merge(result, get(node.left, l, mid, a, b));
+                if (b > mid) result = merge(result, get(node.right, mid + 1, r, a, b));
+            }
+            // 本结点尚未下传的mut/add作用于整个交集
+            return merge(repeat(result, node.mut), repeat(node.add, w));
+        }
+
+        // 对[s,t]与结点i的区间[l,r]的交集执行apply
+        template<typename Apply>
+        void update(node_index i, index_type l, index_type r, index_type s, index_type t, const Apply &apply) {
+            if (s <= l && r <= t) return apply(i, width(l, r));
+            index_type mid = middle(l, r);
+            push_down(i, l, mid, r);
+            node_index left = nodes[i].left, right = nodes[i].right;
+            if (s <= mid) update(left, l, mid, s, t, apply);
+            if (t > mid) update(right, mid + 1, r, s, t, apply);
+            nodes[i].merged = merge(nodes[left].merged, nodes[right].merged);
+        }
+
+        // 将惰性修改的值传递给左右结点 , 没有孩子时先创建 , 新结点的元素均为epsilon
+        void push_down(node_index i, index_type l, index_type mid, index_type r) {
+            if (nodes[i].left == 0) {
+                if (nodes.size() + 2 > node_index(-1)) throw std::length_error("dynamic_segment_tree too many nodes");
+                node_index left = node_index(nodes.size());
+                nodes.push_back(empty_node()), nodes.push_back(empty_node());
+                nodes[i].left = left, nodes[i].right = left + 1;
+            }
+            tree_node &root = nodes[i];
+            RepeatType lw = width(l, mid), rw = width(mid + 1, r);
+            if (root.on_setting) {
+                apply_set(root.left, lw, root.set), apply_set(root.right, rw, root.set);
+                root.on_setting = false;
+            }
+            // set之后的mut/add记录在set之上 , 需继续下传
+            if (root.mut != 1) {
+                apply_mut(root.left, root.mut), apply_mut(root.right, root.mut);
+                root.mut = 1;
+            }
+            apply_add(root.left, lw, root.add), apply_add(root.right, rw, root.add);
+            root.add = epsilon;
+        }
+
+        void apply_add(node_index i, RepeatType w, const T &val) {
+            tree_node &node = nodes[i];
+            node.merged = merge(node.merged, repeat(val, w));
+            node.add = merge(node.add, val);
+        }
+
+        void apply_mut(node_index i, RepeatType k) {
+            tree_node &node = nodes[i];
+            node.merged = repeat(node.merged, k);
+            node.add = repeat(node.add, k);
+            node.mut *= k;
+        }
+
+        void apply_set(node_index i, RepeatType w, const T &val) {
+            tree_node &node = nodes[i];
+            node.merged = repeat(val, w);
+            node.set = val, node.on_setting = true;
+            node.add = epsilon, node.mut = 1;
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_DYNAMIC_SEGMENT_TREE_H
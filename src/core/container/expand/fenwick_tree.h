@@ -0,0 +1,143 @@
+﻿#ifndef TINYSTL_FENWICK_TREE_H
+#define TINYSTL_FENWICK_TREE_H
+
+#include <vector>
+#include <functional>
+#include "../../algorithm/bit.h"
+
+namespace ttl {
+
+    // 树状数组 , 下标从0开始 , 内部tree[i](i从1开始)维护(i - lowbit(i), i]的Op和
+    // 单点修改 , 前缀查询均为O(log n) , 空间为n+1个元素
+    // Op需满足交换律与结合律 , 区间查询get(l,r)另外需要Inverse为Op的逆运算(如plus与minus)
+    template<typename T, typename Op = std::plus<T>, typename Inverse = std::minus<T>>
+    class fenwick_tree {
+    public:
+        using size_type = size_t;
+    private:
+        Op op;
+        Inverse inverse;
+        T epsilon;
+        std::vector<T> tree;
+    public: // constructor
+#pragma region
+
+        explicit fenwick_tree(size_type n = 0, Op op = {}, Inverse inverse = {}, const T &epsilon = {})
+                : op(op), inverse(inverse), epsilon(epsilon), tree(n + 1, epsilon) {}
+
+        // O(n)建树 : 每个结点建好后把自己合并进父结点
+        explicit fenwick_tree(const std::vector<T> &input, Op op = {}, Inverse inverse = {}, const T &epsilon = {})
+                : op(op), inverse(inverse), epsilon(epsilon), tree(input.size() + 1, epsilon) {
+            size_type n = size();
+            for (size_type i = 1; i <= n; ++i) tree[i] = op(tree[i], input[i - 1]);
+            for (size_type i = 1; i <= n; ++i) {
+                size_type parent = i + (i & -i);
+                if (parent <= n) tree[parent] = op(tree[parent], tree[i]);
+            }
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return tree.size() - 1; }
+
+        // 前n个元素[0,n)的Op和
+        T prefix(size_type n) const {
+            T ret = epsilon;
+            for (; n > 0; n &= n - 1) ret = op(ret, tree[n]);
+            return ret;
+        }
+
+        // 获取[l,r]的Op和
+        T get(size_type l, size_type r) const {
+            return inverse(prefix(r + 1), prefix(l));
+        }
+
+        // 获取位于idx的元素
+        T get(size_type idx) const { return get(idx, idx); }
+
+        // 前缀和不减时(元素均不小于epsilon) , 返回最小的idx使得prefix(idx + 1) >= value , 不存在时返回size()
+        // 从最高的2的幂开始向下逐位确定 , 每步只访问一个结点 , 不需要先求前缀再二分
+        // 元素为计数时即为第value小(从1开始)的元素 , 可作为顺序统计结构
+        size_type lower_bound(const T &value) const {
+            size_type n = size(), pos = 0;
+            T sum = epsilon;
+            for (size_type step = n ? size_type(1) << (ttl::bit_width(n) - 1) : 0; step > 0; step >>= 1) {
+                if (pos + step <= n) {
+                    T next = op(sum, tree[pos + step]);
+                    if (next < value) pos += step, sum = next;
+                }
+            }
+            return pos;
+        }
+
+#pragma endregion
+    public: // modify
+#pragma region
+
+        // 使得位于idx的元素与val做Op
+        void add(size_type idx, const T &val) {
+            for (size_type i = idx + 1; i < tree.size(); i += i & -i) tree[i] = op(tree[i], val);
+        }
+
+#pragma endregion
+    };
+
+    // 区间修改 , 区间查询的树状数组 , 用两个树状数组维护差分d
+    // prefix(n) = sum(d[i] * (n - i)) = n * sum(d[i]) - sum(d[i] * i) , i∈[0,n)
+    // T需支持加减法与乘以下标
+    template<typename T>
+    class range_fenwick_tree {
+    public:
+        using size_type = size_t;
+    private:
+        fenwick_tree<T> d, di; // d[i]与d[i]*i
+    public: // constructor
+#pragma region
+
+        explicit range_fenwick_tree(size_type n = 0) : d(n), di(n) {}
+
+        explicit range_fenwick_tree(const std::vector<T> &input) {
+            std::vector<T> diff(input.size()), diff_i(input.size());
+            for (size_type i = 0; i < input.size(); ++i) {
+                diff[i] = i ? input[i] - input[i - 1] : input[i];
+                diff_i[i] = diff[i] * T(i);
+            }
+            d = fenwick_tree<T>(diff), di = fenwick_tree<T>(diff_i);
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return d.size(); }
+
+        // 前n个元素[0,n)的和
+        T prefix(size_type n) const {
+            return d.prefix(n) * T(n) - di.prefix(n);
+        }
+
+        // 获取[l,r]的和
+        T get(size_type l, size_type r) const {
+            return prefix(r + 1) - prefix(l);
+        }
+
+        // 获取位于idx的元素
+        T get(size_type idx) const { return d.prefix(idx + 1); }
+
+#pragma endregion
+    public: // modify
+#pragma region
+
+        // 使得[l,r]每个元素都加val
+        void add(size_type l, size_type r, const T &val) {
+            d.add(l, val), di.add(l, val * T(l));
+            if (r + 1 < size()) d.add(r + 1, -val), di.add(r + 1, -(val * T(r + 1)));
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_FENWICK_TREE_H
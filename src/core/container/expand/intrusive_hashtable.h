@@ -0,0 +1,330 @@
+﻿#ifndef TINYSTL_INTRUSIVE_HASHTABLE_H
+#define TINYSTL_INTRUSIVE_HASHTABLE_H
+
+#include "./intrusive_list.h"
+#include "../vector.h"
+
+namespace ttl {
+
+    // 嵌入到对象内部的哈希结点
+    // pprev指向前驱的next字段(或bucket本身) , 因此不需要遍历bucket就能O(1)摘除
+    struct intrusive_hash_hook {
+        intrusive_hash_hook *next{};
+        intrusive_hash_hook **pprev{};
+        size_t hash{}; // 缓存的哈希值 , rehash时无需重新计算
+
+        intrusive_hash_hook() = default;
+
+        // 复制对象时不复制链接关系
+        intrusive_hash_hook(const intrusive_hash_hook &) noexcept {}
+
+        intrusive_hash_hook &operator=(const intrusive_hash_hook &) noexcept { return *this; }
+
+        bool is_linked() const { return pprev != nullptr; }
+    };
+
+    // 侵入式哈希表(开链法) , 链接字段位于对象内部 , 容器不拥有对象
+    // KeyOfValue从对象中取出key , 插入删除不会为元素分配内存 , 只有扩容时重新分配bucket数组
+    // 通过对象可以O(1)删除
+    template<
+            typename T,
+            intrusive_hash_hook T::*Hook,
+            typename KeyOfValue,
+            typename HashFcn = std::hash<std::decay_t<decltype(KeyOfValue()(std::declval<const T &>()))>>,
+            typename KeyEqualFcn = std::equal_to<>>
+    class intrusive_hashtable {
+    public:
+        using key_type = std::decay_t<decltype(KeyOfValue()(std::declval<const T &>()))>;
+        using hasher = HashFcn;
+        using key_equal = KeyEqualFcn;
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+    private: // helper class
+#pragma region
+        using node_type = intrusive_hash_hook;
+        using bucket_container = ttl::vector<node_type *>;
+
+        // 迭代器
+        template<typename CVT>
+        class intrusive_hash_iterator : public ttl::iterator<ttl::forward_iterator_tag, CVT> {
+            friend class intrusive_hashtable;
+
+            node_type *cur{};                       // 迭代器当前位置
+            const intrusive_hashtable *table{};     // 所属的容器
+        public:
+            using value_type = CVT;
+            using pointer = CVT *;
+            using reference = CVT &;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+        private:
+            intrusive_hash_iterator(node_type *node, const intrusive_hashtable *belong) : cur(node), table(belong) {}
+
+        public: // constructor
+            intrusive_hash_iterator() = default;
+
+            intrusive_hash_iterator(const intrusive_hash_iterator &) = default;
+
+            template<typename OV>
+            intrusive_hash_iterator(const intrusive_hash_iterator<OV> &oth) noexcept: // NOLINT(google-explicit-constructor)
+                    cur(oth.cur), table(oth.table) {}
+
+            intrusive_hash_iterator &operator=(const intrusive_hash_iterator &) = default;
+
+        public: // ops
+            reference operator*() const { return *owner(cur); }
+
+            pointer operator->() const { return owner(cur); }
+
+            intrusive_hash_iterator &operator++() {
+                cur = table->next_node(cur);
+                return *this;
+            }
+
+            intrusive_hash_iterator operator++(int) {
+                intrusive_hash_iterator tmp = *this;
+                return ++*this, tmp;
+            }
+
+            friend bool operator==(const intrusive_hash_iterator &lhs, const intrusive_hash_iterator &rhs) {
+                return lhs.cur == rhs.cur;
+            }
+
+            friend bool operator!=(const intrusive_hash_iterator &lhs, const intrusive_hash_iterator &rhs) {
+                return !(rhs == lhs);
+            }
+        };
+
+    public:
+        using iterator = intrusive_hash_iterator<value_type>;
+        using const_iterator = intrusive_hash_iterator<const value_type>;
+
+#pragma endregion
+    private: // fields
+        KeyOfValue key_of;
+        hasher hash_fcn;
+        key_equal equal_fcn;
+        bucket_container buckets;
+        size_type num_elements{}; // 实际元素个数
+        float factor = 1; // size()/bucket_size()<=factor
+
+        static const size_type default_size = 11;
+    public: // constructor
+#pragma region
+
+        intrusive_hashtable() : intrusive_hashtable(default_size) {}
+
+        explicit intrusive_hashtable(size_type bucket_count,
+                                     const hasher &hash = hasher(),
+                                     const key_equal &equal = key_equal()
+        ) : hash_fcn(hash), equal_fcn(equal), buckets(bucket_count ? bucket_count : 1, nullptr) {}
+
+        intrusive_hashtable(const intrusive_hashtable &) = delete;
+
+        intrusive_hashtable &operator=(const intrusive_hashtable &) = delete;
+
+        // 只解除链接 , 不销毁对象
+        ~intrusive_hashtable() { clear(); }
+
+#pragma endregion
+    public: // iterators
+#pragma region
+
+        iterator begin() const { return {first_node(), this}; }
+
+        iterator end() const { return {nullptr, this}; }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        // 由对象获取其迭代器 , 对象必须位于本表中
+        iterator iterator_to(reference value) const { return {&(value.*Hook), this}; }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return num_elements == 0; }
+
+        size_type size() const { return num_elements; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 解除所有对象的链接
+        void clear() {
+            for (auto &bucket: buckets) {
+                for (node_type *cur = bucket, *nxt; cur; cur = nxt) {
+                    nxt = cur->next;
+                    cur->next = nullptr, cur->pprev = nullptr;
+                }
+                bucket = nullptr;
+            }
+            num_elements = 0;
+        }
+
+        // 不重复插入 , 已存在相同key时返回已有对象
+        std::pair<iterator, bool> insert_unique(reference value) {
+            node_type *node = &(value.*Hook);
+            node->hash = hash_fcn(key_of(value));
+            if (node_type *old = find_node(key_of(value), node->hash)) return {{old, this}, false};
+            grow(num_elements + 1);
+            link_front(buckets[bucket_index(node->hash)], node), ++num_elements;
+            return {{node, this}, true};
+        }
+
+        // 可重复插入 , 相同key的对象相邻
+        iterator insert_equal(reference value) {
+            node_type *node = &(value.*Hook);
+            node->hash = hash_fcn(key_of(value));
+            grow(num_elements + 1);
+            node_type *old = find_node(key_of(value), node->hash);
+            link_front(old ? *old->pprev : buckets[bucket_index(node->hash)], node), ++num_elements;
+            return {node, this};
+        }
+
+        // 通过对象直接删除 , O(1)
+        void erase(reference value) {
+            unlink(&(value.*Hook));
+        }
+
+        iterator erase(const_iterator pos) {
+            node_type *node = pos.cur, *nxt = next_node(node);
+            unlink(node);
+            return {nxt, this};
+        }
+
+        // 删除所有key相同的对象
+        size_type erase(const key_type &key) {
+            size_type ret = 0, hash = hash_fcn(key);
+            node_type *cur = find_node(key, hash), *nxt;
+            while (cur && cur->hash == hash && equal_fcn(key_of(*owner(cur)), key)) {
+                nxt = cur->next, unlink(cur), cur = nxt, ++ret;
+            }
+            return ret;
+        }
+
+#pragma endregion
+    public: // find
+#pragma region
+
+        iterator find(const key_type &key) const {
+            return {find_node(key, hash_fcn(key)), this};
+        }
+
+        size_type count(const key_type &key) const {
+            size_type ret = 0, hash = hash_fcn(key);
+            node_type *cur = find_node(key, hash);
+            while (cur && cur->hash == hash && equal_fcn(key_of(*owner(cur)), key)) cur = cur->next, ++ret;
+            return ret;
+        }
+
+        bool contains(const key_type &key) const {
+            return find_node(key, hash_fcn(key)) != nullptr;
+        }
+
+#pragma endregion
+    public: // bucket interface & hash policy
+#pragma region
+
+        size_type bucket_count() const { return buckets.size(); }
+
+        float max_load_factor() const { return factor; }
+
+        void max_load_factor(float ml) { factor = ml; }
+
+        // 重新分配bucket数组 , 结点只需重新链接
+        // tails[i]指向新bucket i的最后一个next字段 , 尾插保持相同key相邻的顺序 , 总共O(n + count)
+        void rehash(size_type count) {
+            if (count == 0) count = 1;
+            bucket_container tmp(count, nullptr);
+            ttl::vector<node_type **> tails(count);
+            for (size_type i = 0; i < count; ++i) tails[i] = &tmp[i];
+            for (auto bucket: buckets) {
+                for (node_type *cur = bucket, *nxt; cur; cur = nxt) {
+                    nxt = cur->next;
+                    link_back(tails[cur->hash % count], cur);
+                }
+            }
+            // swap只交换指针 , 链表头的pprev仍然指向有效的bucket
+            buckets.swap(tmp);
+        }
+
+        // 预留空间 , 之后插入count个元素都不会再分配内存
+        void reserve(size_type count) {
+            if (!un_overload(count, bucket_count())) rehash(size_type(float(count) / factor) + 1);
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        static pointer owner(node_type *node) {
+            return hook_owner(node, Hook);
+        }
+
+        size_type bucket_index(size_type hash) const {
+            return hash % buckets.size();
+        }
+
+        // 未超载
+        bool un_overload(size_type ele_size, size_type bkt_size) const {
+            return static_cast<float>(ele_size) <= static_cast<float>(bkt_size) * factor;
+        }
+
+        // 元素过多时扩容
+        void grow(size_type hint_element_size) {
+            if (!un_overload(hint_element_size, bucket_count())) rehash(bucket_count() * 2 + 1);
+        }
+
+        // 将node放在pos处 , pos为某个next字段或bucket
+        static void link_front(node_type *&pos, node_type *node) {
+            node->next = pos, node->pprev = &pos;
+            if (pos) pos->pprev = &node->next;
+            pos = node;
+        }
+
+        // 将node放在tail处(某条链最后的next字段或空bucket) , 并把tail移到node->next
+        static void link_back(node_type **&tail, node_type *node) {
+            node->next = nullptr, node->pprev = tail, *tail = node;
+            tail = &node->next;
+        }
+
+        void unlink(node_type *node) {
+            *node->pprev = node->next;
+            if (node->next) node->next->pprev = node->pprev;
+            node->next = nullptr, node->pprev = nullptr, --num_elements;
+        }
+
+        node_type *find_node(const key_type &key, size_type hash) const {
+            node_type *cur = buckets[bucket_index(hash)];
+            while (cur && !(cur->hash == hash && equal_fcn(key_of(*owner(cur)), key))) cur = cur->next;
+            return cur;
+        }
+
+        node_type *first_node() const {
+            for (auto bucket: buckets) if (bucket) return bucket;
+            return nullptr;
+        }
+
+        // 下一个非空位置,没有则返回nullptr
+        node_type *next_node(node_type *cur) const {
+            if (cur->next) return cur->next;
+            for (size_type pos = bucket_index(cur->hash) + 1, n = bucket_count(); pos < n; ++pos) {
+                if (buckets[pos]) return buckets[pos];
+            }
+            return nullptr;
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_INTRUSIVE_HASHTABLE_H
@@ -0,0 +1,284 @@
+﻿#ifndef TINYSTL_INTRUSIVE_LIST_H
+#define TINYSTL_INTRUSIVE_LIST_H
+
+#include <cstddef>
+#include "../../iterator/iterator.h"
+
+namespace ttl {
+
+    // 嵌入到对象内部的链表结点 , 与list的list_base_node结构相同
+    // 未链接时next == prev == nullptr
+    struct intrusive_list_hook {
+        intrusive_list_hook *next{};
+        intrusive_list_hook *prev{};
+
+        intrusive_list_hook() = default;
+
+        // 复制对象时不复制链接关系
+        intrusive_list_hook(const intrusive_list_hook &) noexcept {}
+
+        intrusive_list_hook &operator=(const intrusive_list_hook &) noexcept { return *this; }
+
+        bool is_linked() const { return next != nullptr; }
+    };
+
+    namespace {
+        // 由成员指针计算出成员在对象中的偏移 , 再由成员地址反推对象地址
+        template<typename T, typename Hook>
+        T *hook_owner(Hook *hook, Hook T::*member) {
+            auto offset = reinterpret_cast<std::ptrdiff_t>(
+                    &(reinterpret_cast<const volatile T *>(0)->*member));
+            return reinterpret_cast<T *>(reinterpret_cast<char *>(hook) - offset);
+        }
+    }
+
+    // 侵入式双向链表 , 链接字段位于对象内部 , 容器不拥有对象
+    // 插入删除不会分配内存 , 通过对象可以O(1)删除
+    // 对象的生命周期由使用者管理 , 对象销毁前需要先从链表中移除
+    template<typename T, intrusive_list_hook T::*Hook>
+    class intrusive_list {
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+    private: // helper class
+#pragma region
+        using node_type = intrusive_list_hook;
+
+        // 迭代器
+        template<typename CVT>
+        class intrusive_iterator : public ttl::iterator<ttl::bidirectional_iterator_tag, CVT> {
+            friend class intrusive_list;
+
+        public:
+            using value_type = CVT;
+            using pointer = CVT *;
+            using reference = CVT &;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+        private:
+            node_type *current{};
+        public: // constructor
+            intrusive_iterator() = default;
+
+            intrusive_iterator(const intrusive_iterator &) = default;
+
+            explicit intrusive_iterator(node_type *it) noexcept: current(it) {}
+
+            template<typename OV>
+            intrusive_iterator(const intrusive_iterator<OV> &oth) noexcept: // NOLINT(google-explicit-constructor)
+                    current(oth.current) {}
+
+            intrusive_iterator &operator=(const intrusive_iterator &) = default;
+
+        public: // ops
+            reference operator*() const noexcept { return *owner(current); }
+
+            pointer operator->() const noexcept { return owner(current); }
+
+            // forward
+            intrusive_iterator &operator++() noexcept {
+                return current = current->next, *this;
+            }
+
+            intrusive_iterator operator++(int) noexcept {
+                intrusive_iterator tmp = *this;
+                return ++*this, tmp;
+            }
+
+            // bi direct
+            intrusive_iterator &operator--() noexcept {
+                return current = current->prev, *this;
+            }
+
+            intrusive_iterator operator--(int) noexcept {
+                intrusive_iterator tmp = *this;
+                return --*this, tmp;
+            }
+
+            friend bool operator==(const intrusive_iterator &lhs, const intrusive_iterator &rhs) {
+                return lhs.current == rhs.current;
+            }
+
+            friend bool operator!=(const intrusive_iterator &lhs, const intrusive_iterator &rhs) {
+                return !(lhs.current == rhs.current);
+            }
+        };
+
+#pragma endregion
+    private:
+        node_type root;     // 虚拟根节点 , root.next为头 , root.prev为尾
+        size_type count{};  // 元素个数
+    public: // iter
+        using iterator = intrusive_iterator<value_type>;
+        using const_iterator = intrusive_iterator<const value_type>;
+        using reverse_iterator = ttl::reverse_iterator<iterator>;
+        using const_reverse_iterator = ttl::reverse_iterator<const_iterator>;
+    public: // constructor
+#pragma region
+
+        intrusive_list() { root.next = root.prev = &root; }
+
+        intrusive_list(const intrusive_list &) = delete;
+
+        intrusive_list(intrusive_list &&oth) noexcept: intrusive_list() {
+            swap(oth);
+        }
+
+        intrusive_list &operator=(const intrusive_list &) = delete;
+
+        intrusive_list &operator=(intrusive_list &&oth) noexcept {
+            if (&oth != this) clear(), swap(oth);
+            return *this;
+        }
+
+        // 只解除链接 , 不销毁对象
+        ~intrusive_list() { clear(); }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        reference front() { return *owner(root.next); }
+
+        const_reference front() const { return *owner(root.next); }
+
+        reference back() { return *owner(root.prev); }
+
+        const_reference back() const { return *owner(root.prev); }
+
+        // 由对象获取其迭代器 , 对象必须位于本链表中
+        iterator iterator_to(reference value) const { return iterator(&(value.*Hook)); }
+
+#pragma endregion
+    public: // iterator
+#pragma region
+
+        iterator begin() const { return iterator(root.next); }
+
+        iterator end() const { return iterator(const_cast<node_type *>(&root)); }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+        reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+
+        const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return count == 0; }
+
+        size_type size() const { return count; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 解除所有对象的链接
+        void clear() {
+            for (node_type *cur = root.next, *nxt; cur != &root; cur = nxt) {
+                nxt = cur->next;
+                cur->next = cur->prev = nullptr;
+            }
+            root.next = root.prev = &root, count = 0;
+        }
+
+        // 将value链接到pos之前 , value不能已经位于某个链表中
+        iterator insert(const_iterator pos, reference value) {
+            node_type *node = &(value.*Hook), *cur = pos.current;
+            hook(cur->prev, node), hook(node, cur);
+            return ++count, iterator(node);
+        }
+
+        iterator erase(const_iterator pos) {
+            node_type *node = pos.current, *nxt = node->next;
+            unlink(node);
+            return iterator(nxt);
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            while (first != last) first = erase(first);
+            return iterator(last);
+        }
+
+        // 通过对象直接删除 , O(1)
+        void erase(reference value) {
+            unlink(&(value.*Hook));
+        }
+
+        void push_back(reference value) { insert(cend(), value); }
+
+        void push_front(reference value) { insert(cbegin(), value); }
+
+        void pop_back() { unlink(root.prev); }
+
+        void pop_front() { unlink(root.next); }
+
+        void swap(intrusive_list &oth) {
+            node_type *a_first = root.next, *a_last = root.prev;
+            node_type *b_first = oth.root.next, *b_last = oth.root.prev;
+            // 空链表需要自环
+            if (b_first == &oth.root) root.next = root.prev = &root;
+            else hook(&root, b_first), hook(b_last, &root);
+            if (a_first == &root) oth.root.next = oth.root.prev = &oth.root;
+            else hook(&oth.root, a_first), hook(a_last, &oth.root);
+            std::swap(count, oth.count);
+        }
+
+        // 移动value到pos之前 , value必须位于本链表中
+        void move_to(const_iterator pos, reference value) {
+            node_type *node = &(value.*Hook), *cur = pos.current;
+            if (node == cur) return;
+            hook(node->prev, node->next);
+            hook(cur->prev, node), hook(node, cur);
+        }
+
+        // 从oth中移动[first, last)到pos的前面
+        void splice(const_iterator pos, intrusive_list &oth, const_iterator first, const_iterator last) {
+            if (first == last) return;
+            size_type n = ttl::distance(first, last);
+            count += n, oth.count -= n;
+            node_type *first_ptr = first.current, *last_ptr = last.current->prev, *cur = pos.current;
+            hook(first_ptr->prev, last.current);
+            hook(cur->prev, first_ptr), hook(last_ptr, cur);
+        }
+
+        void splice(const_iterator pos, intrusive_list &oth) {
+            splice(pos, oth, oth.cbegin(), oth.cend());
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        // 连接pre<->nxt
+        static void hook(node_type *pre, node_type *nxt) {
+            pre->next = nxt, nxt->prev = pre;
+        }
+
+        void unlink(node_type *node) {
+            hook(node->prev, node->next);
+            node->next = node->prev = nullptr, --count;
+        }
+
+        static pointer owner(node_type *node) {
+            return hook_owner(node, Hook);
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_INTRUSIVE_LIST_H
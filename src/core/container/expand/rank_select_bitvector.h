@@ -0,0 +1,180 @@
+﻿#ifndef TINYSTL_RANK_SELECT_BITVECTOR_H
+#define TINYSTL_RANK_SELECT_BITVECTOR_H
+
+#include <cstdint>
+#include <stdexcept>
+#include "../vector.h"
+#include "bitset.h"
+#include "dynamic_bitset.h"
+
+namespace ttl {
+
+    // 不可变位向量上的rank/select , 索引布局参照poppy(Zhou等人)
+    // 每2048位(块)一个64位索引项 , 低32位为到块起点为止的1的个数(相对于所在的2^32位区间) ,
+    // 高位交错存放块内前3个512位子块各自的1的个数(各10位) , 另外每2^32位记录一次绝对计数 , rank索引开销约3.1%
+    // rank1 : 一次索引项 , 再对子块内最多8个字计数 , 两次缓存未命中
+    // select1 : 每8192个1采样一次所在的块 , 在相邻两个采样之间二分索引项 , 再用子块计数与popcount定位到字 ,
+    //           字内用pdep(BMI2)或broadword的字节前缀和定位 , 运行时按cpuid选择
+    class rank_select_bitvector {
+    public:
+        using size_type = size_t;
+    private:
+        using word_type = dynamic_bitset::word_type;
+
+        static constexpr size_type block_bit = 2048;
+        static constexpr size_type block_words = block_bit / 64;
+        static constexpr size_type sub_words = 8;
+        // 绝对计数的间隔(位数的对数)
+        static constexpr size_type region_shift = 32;
+        // 每多少个1采样一次
+        static constexpr size_type select_sample = 8192;
+
+        ttl::dynamic_bitset bits;
+        ttl::vector<uint64_t> regions; // 每2^32位一个 , 区间起点之前的1的个数
+        ttl::vector<uint64_t> blocks; // 每块一项 , 末尾另有一项哨兵
+        ttl::vector<uint32_t> samples; // 第j*select_sample个1所在的块
+        size_type ones = 0;
+    public: // constructor
+#pragma region
+
+        rank_select_bitvector() { build(); }
+
+        explicit rank_select_bitvector(const ttl::dynamic_bitset &bs) : bits(bs) { build(); }
+
+        explicit rank_select_bitvector(ttl::dynamic_bitset &&bs) : bits(std::move(bs)) { build(); }
+
+        template<size_t N>
+        explicit rank_select_bitvector(const ttl::bitset<N> &bs) : bits(N) {
+            bs.for_each_set([this](size_type i) { bits.set(i); });
+            build();
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return bits.size(); }
+
+        // 值为1的位数
+        size_type count() const { return ones; }
+
+        bool operator[](size_type i) const { return bits[i]; }
+
+        const ttl::dynamic_bitset &bitvector() const { return bits; }
+
+        // 索引占用的字节数
+        size_type index_bytes() const {
+            return regions.size() * sizeof(uint64_t) + blocks.size() * sizeof(uint64_t) + samples.size() * sizeof(uint32_t);
+        }
+
+        // [0,i)中1的个数 , i <= size()
+        size_type rank1(size_type i) const {
+#ifdef TTL_SIMD_X86
+            if (simd_has_popcnt()) return rank_popcnt(i);
+#endif
+            return rank_kernel<false>(i);
+        }
+
+        // [0,i)中0的个数
+        size_type rank0(size_type i) const {
+            return i - rank1(i);
+        }
+
+        // 第k个(从0开始)值为1的位的下标 , k >= count()时抛出out_of_range
+        size_type select1(size_type k) const {
+            if (k >= ones) throw std::out_of_range("rank_select_bitvector select1");
+#ifdef TTL_SIMD_X86
+            if (simd_has_bmi2()) return select_bmi2(k);
+#endif
+            size_type base;
+            word_type word = select_kernel<false>(k, base);
+            return base + ttl::bit_select(word, int(k));
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        void build() {
+            const word_type *w = bits.data();
+            size_type n = bits.word_count(), block_count = (n + block_words - 1) / block_words;
+            regions.assign(((block_count * block_bit) >> region_shift) + 1, 0);
+            blocks.assign(block_count + 1, 0);
+            ones = 0;
+            for (size_type b = 0; b <= block_count; ++b) {
+                if ((b * block_bit) % (size_type(1) << region_shift) == 0) regions[(b * block_bit) >> region_shift] = ones;
+                uint64_t entry = ones - regions[(b * block_bit) >> region_shift], count = 0;
+                for (size_type s = 0; s < block_bit / 512; ++s) {
+                    uint64_t sub = 0;
+                    for (size_type i = b * block_words + s * sub_words, j = 0; j < sub_words && i < n; ++i, ++j) {
+                        sub += ttl::popcount(w[i]);
+                    }
+                    if (s < 3) entry |= sub << (region_shift + 10 * s);
+                    count += sub;
+                }
+                blocks[b] = entry;
+                for (; samples.size() * select_sample < ones + count; samples.push_back(uint32_t(b)));
+                ones += count;
+            }
+        }
+
+        size_type block_rank(size_type b) const {
+            return regions[(b * block_bit) >> region_shift] + (blocks[b] & 0xffffffffu);
+        }
+
+        template<bool Hardware>
+        [[gnu::always_inline]] size_type rank_kernel(size_type i) const {
+            const word_type *w = bits.data();
+            size_type b = i / block_bit, s = i / 512 % 4;
+            uint64_t entry = blocks[b], sub = entry >> region_shift;
+            size_type ret = regions[i >> region_shift] + (entry & 0xffffffffu);
+            ret += (sub & 1023) * (s > 0) + (sub >> 10 & 1023) * (s > 1) + (sub >> 20 & 1023) * (s > 2);
+            for (size_type j = b * block_words + s * sub_words; j < i / 64; ++j) ret += simd_popcount64<Hardware>(w[j]);
+            if (i % 64) ret += simd_popcount64<Hardware>(w[i / 64] & ((word_type(1) << (i % 64)) - 1));
+            return ret;
+        }
+
+        // 定位第k个1所在的字 , 返回该字 , base为字的起始位 , k改为在字内的序号
+        template<bool Hardware>
+        [[gnu::always_inline]] word_type select_kernel(size_type &k, size_type &base) const {
+            size_type j = k / select_sample;
+            size_type lo = samples[j], hi = j + 1 < samples.size() ? samples[j + 1] + 1 : blocks.size() - 1;
+            while (hi - lo > 1) {
+                size_type mid = lo + (hi - lo) / 2;
+                block_rank(mid) <= k ? lo = mid : hi = mid;
+            }
+            k -= block_rank(lo);
+            uint64_t sub = blocks[lo] >> region_shift;
+            size_type i = lo * block_words;
+            for (int s = 0; s < 3; ++s, sub >>= 10, i += sub_words) {
+                if (k < (sub & 1023)) break;
+                k -= sub & 1023;
+            }
+            const word_type *w = bits.data();
+            for (;; ++i) {
+                size_type c = simd_popcount64<Hardware>(w[i]);
+                if (k < c) return base = i * 64, w[i];
+                k -= c;
+            }
+        }
+
+#ifdef TTL_SIMD_X86
+
+        [[gnu::target("popcnt")]] size_type rank_popcnt(size_type i) const {
+            return rank_kernel<true>(i);
+        }
+
+        // 字内的第k个1 : pdep把1<<k散布到word中第k个1的位置
+        [[gnu::target("bmi2,popcnt")]] size_type select_bmi2(size_type k) const {
+            size_type base;
+            word_type word = select_kernel<true>(k, base);
+            return base + size_type(__builtin_ctzll(_pdep_u64(word_type(1) << k, word)));
+        }
+
+#endif
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_RANK_SELECT_BITVECTOR_H
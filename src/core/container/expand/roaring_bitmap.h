@@ -0,0 +1,890 @@
+﻿#ifndef TINYSTL_ROARING_BITMAP_H
+#define TINYSTL_ROARING_BITMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include "../vector.h"
+#include "dynamic_bitset.h"
+
+namespace ttl {
+    namespace {
+        // 序列化格式固定为小端序 , 逐字节拷贝读写 , 不要求对齐
+        template<typename T>
+        T roaring_le(T x) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+            return ttl::byteswap(x);
+#else
+            return x;
+#endif
+        }
+
+        template<typename T>
+        T roaring_load(const char *p) {
+            T x;
+            memcpy(&x, p, sizeof(T));
+            return roaring_le(x);
+        }
+
+        template<typename T>
+        void roaring_store(char *p, T x) {
+            x = roaring_le(x);
+            memcpy(p, &x, sizeof(T));
+        }
+    }
+
+    class roaring_bitmap_view;
+
+    // 32位无符号整数的压缩集合(Roaring bitmap)
+    // 按高16位分桶 , 每个桶是一个容器 , 保存低16位 :
+    //     array  : 升序数组 , 基数不超过4096
+    //     bitset : 65536位的dynamic_bitset , 基数超过4096 , 批量运算使用bitset的向量化内核
+    //     run    : (起点,长度-1)的序列 , 只由run_optimize产生 , 修改时先展开为另外两种
+    // 序列化使用Roaring的可移植格式 , 可以由roaring_bitmap_view直接在内存映射的数据上查询
+    class roaring_bitmap {
+        friend class roaring_bitmap_view;
+
+    public:
+        using value_type = uint32_t;
+        using size_type = size_t;
+    private:
+        using word_type = dynamic_bitset::word_type;
+
+        // array容器的最大基数 , 此时与bitset容器的空间相等
+        static constexpr uint32_t array_max = 4096;
+        // 一个容器的位数
+        static constexpr uint32_t container_bit = 1 << 16;
+        // bitset容器的字数
+        static constexpr uint32_t container_words = container_bit / 64;
+        // 可移植格式的常量
+        static constexpr uint32_t cookie_no_run = 12346;
+        static constexpr uint32_t cookie_run = 12347;
+        // 有run容器时 , 容器数不少于此值才写入偏移表
+        static constexpr uint32_t no_offset_threshold = 4;
+
+        enum container_type : uint8_t {
+            array_type, bitset_type, run_type
+        };
+
+        struct container {
+            container_type type = array_type;
+            uint32_t card = 0;
+            ttl::vector<uint16_t> values; // array : 升序的值 ; run : 起点与长度-1交替存放
+            ttl::dynamic_bitset bits; // bitset : 65536位
+
+            size_type run_count() const { return values.size() / 2; }
+
+            // 起点不大于x的最后一个run , 不存在时返回run_count()
+            size_type find_run(uint16_t x) const {
+                size_type l = 0, r = run_count();
+                while (l < r) {
+                    size_type mid = l + (r - l) / 2;
+                    values[2 * mid] <= x ? l = mid + 1 : r = mid;
+                }
+                return l ? l - 1 : run_count();
+            }
+
+            bool contains(uint16_t x) const {
+                if (type == array_type) return std::binary_search(values.data(), values.data() + values.size(), x);
+                if (type == bitset_type) return bits[x];
+                size_type i = find_run(x);
+                return i != run_count() && x - values[2 * i] <= values[2 * i + 1];
+            }
+
+            // 返回是否新增
+            bool add(uint16_t x) {
+                if (type == run_type) expand();
+                if (type == bitset_type) {
+                    if (bits[x]) return false;
+                    return bits.set(x), ++card, true;
+                }
+                size_type i = std::lower_bound(values.data(), values.data() + values.size(), x) - values.data();
+                if (i != values.size() && values[i] == x) return false;
+                values.insert(values.begin() + i, x);
+                if (++card > array_max) to_bitset();
+                return true;
+            }
+
+            // 返回是否删除
+            bool remove(uint16_t x) {
+                if (type == run_type) expand();
+                if (type == bitset_type) {
+                    if (!bits[x]) return false;
+                    bits.reset(x);
+                    if (--card <= array_max) to_array();
+                    return true;
+                }
+                size_type i = std::lower_bound(values.data(), values.data() + values.size(), x) - values.data();
+                if (i == values.size() || values[i] != x) return false;
+                values.erase(values.begin() + i);
+                return --card, true;
+            }
+
+            // 不大于x的值的个数
+            uint32_t rank(uint16_t x) const {
+                if (type == array_type) {
+                    return uint32_t(std::upper_bound(values.data(), values.data() + values.size(), x) - values.data());
+                }
+                if (type == bitset_type) {
+                    const word_type *w = bits.data();
+                    return uint32_t(ttl::popcount(w, w + x / 64) + ttl::popcount(w[x / 64] & (word_type(-1) >> (63 - x % 64))));
+                }
+                uint32_t ret = 0;
+                for (size_type i = 0, n = run_count(); i < n && values[2 * i] <= x; ++i) {
+                    ret += ttl::min(uint32_t(values[2 * i + 1]), uint32_t(x - values[2 * i])) + 1;
+                }
+                return ret;
+            }
+
+            // 第k小(从0开始)的值 , k < card
+            uint16_t select(uint32_t k) const {
+                if (type == array_type) return values[k];
+                if (type == bitset_type) {
+                    const word_type *w = bits.data();
+                    for (uint32_t i = 0;; ++i) {
+                        uint32_t c = ttl::popcount(w[i]);
+                        if (k < c) return uint16_t(i * 64 + ttl::bit_select(w[i], int(k)));
+                        k -= c;
+                    }
+                }
+                for (size_type i = 0;; ++i) {
+                    uint32_t len = uint32_t(values[2 * i + 1]) + 1;
+                    if (k < len) return uint16_t(values[2 * i] + k);
+                    k -= len;
+                }
+            }
+
+            template<typename Function>
+            void for_each(Function &fn, uint32_t high) const {
+                if (type == array_type) {
+                    for (uint16_t x: values) fn(high | x);
+                } else if (type == bitset_type) {
+                    bits.for_each_set([&fn, high](size_type i) { fn(high | uint32_t(i)); });
+                } else {
+                    for (size_type i = 0, n = run_count(); i < n; ++i) {
+                        for (uint32_t x = values[2 * i], last = x + values[2 * i + 1]; x <= last; ++x) fn(high | x);
+                    }
+                }
+            }
+
+            // 把容器的内容写成container_words个字
+            void store_words(word_type *out) const {
+                if (type == bitset_type) return void(memcpy(out, bits.data(), container_words * sizeof(word_type)));
+                memset(out, 0, container_words * sizeof(word_type));
+                if (type == array_type) {
+                    for (uint16_t x: values) out[x / 64] |= word_type(1) << (x % 64);
+                    return;
+                }
+                for (size_type i = 0, n = run_count(); i < n; ++i) {
+                    uint32_t first = values[2 * i], last = first + values[2 * i + 1];
+                    uint32_t fw = first / 64, lw = last / 64;
+                    word_type head = word_type(-1) << (first % 64), tail = word_type(-1) >> (63 - last % 64);
+                    if (fw == lw) {
+                        out[fw] |= head & tail;
+                    } else {
+                        out[fw] |= head;
+                        for (uint32_t j = fw + 1; j < lw; ++j) out[j] = word_type(-1);
+                        out[lw] |= tail;
+                    }
+                }
+            }
+
+            void load_words(const word_type *in) {
+                bits = ttl::dynamic_bitset();
+                bits.reserve(container_bit);
+                for (uint32_t i = 0; i < container_words; ++i) bits.append(in[i]);
+            }
+
+            void to_bitset() {
+                if (type == bitset_type) return;
+                word_type words[container_words];
+                store_words(words);
+                load_words(words);
+                type = bitset_type;
+                values = ttl::vector<uint16_t>();
+            }
+
+            void to_array() {
+                if (type == array_type) return;
+                ttl::vector<uint16_t> ret;
+                ret.reserve(card);
+                for_each_low([&ret](uint16_t x) { ret.push_back(x); });
+                values.swap(ret);
+                bits = ttl::dynamic_bitset();
+                type = array_type;
+            }
+
+            // 按基数选择array或bitset
+            void expand() {
+                if (card <= array_max) to_array();
+                else to_bitset();
+            }
+
+            // run的个数 , 即值为1且前一位为0的位数
+            size_type count_runs() const {
+                if (type == run_type) return run_count();
+                size_type ret = 0;
+                if (type == array_type) {
+                    for (size_type i = 0; i < values.size(); ++i) ret += i == 0 || values[i] != values[i - 1] + 1;
+                    return ret;
+                }
+                const word_type *w = bits.data();
+                for (uint32_t i = 0; i < container_words; ++i) {
+                    word_type prev = i ? w[i - 1] >> 63 : 0;
+                    ret += ttl::popcount(w[i] & ~(w[i] << 1 | prev));
+                }
+                return ret;
+            }
+
+            void to_run() {
+                if (type == run_type) return;
+                ttl::vector<uint16_t> ret;
+                ret.reserve(2 * count_runs());
+                uint32_t start = 0, prev = 0;
+                bool open = false;
+                for_each_low([&](uint16_t x) {
+                    if (open && x == prev + 1) return void(prev = x);
+                    if (open) ret.push_back(uint16_t(start)), ret.push_back(uint16_t(prev - start));
+                    start = prev = x, open = true;
+                });
+                if (open) ret.push_back(uint16_t(start)), ret.push_back(uint16_t(prev - start));
+                values.swap(ret);
+                bits = ttl::dynamic_bitset();
+                type = run_type;
+            }
+
+            // 序列化后的字节数
+            size_type serialized_size() const {
+                if (type == run_type) return 2 + 2 * values.size();
+                return type == array_type ? 2 * size_type(card) : container_words * sizeof(word_type);
+            }
+
+        private:
+            template<typename Function>
+            void for_each_low(Function fn) const {
+                for_each(fn, 0);
+            }
+        };
+
+        ttl::vector<uint16_t> keys; // 升序的高16位
+        ttl::vector<container> containers; // 与keys一一对应 , 不含空容器
+    public: // constructor
+#pragma region
+
+        roaring_bitmap() = default;
+
+        roaring_bitmap(std::initializer_list<value_type> init) {
+            for (value_type x: init) add(x);
+        }
+
+        template<typename InputIt>
+        roaring_bitmap(InputIt first, InputIt last) {
+            for (; first != last; ++first) add(value_type(*first));
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const {
+            size_type ret = 0;
+            for (const container &c: containers) ret += c.card;
+            return ret;
+        }
+
+        bool empty() const { return keys.empty(); }
+
+        bool contains(value_type x) const {
+            size_type i = find_key(uint16_t(x >> 16));
+            return i != keys.size() && containers[i].contains(uint16_t(x));
+        }
+
+        // 不大于x的元素个数
+        size_type rank(value_type x) const {
+            size_type ret = 0;
+            uint16_t high = uint16_t(x >> 16);
+            for (size_type i = 0; i < keys.size() && keys[i] <= high; ++i) {
+                ret += keys[i] < high ? containers[i].card : containers[i].rank(uint16_t(x));
+            }
+            return ret;
+        }
+
+        // 第k小(从0开始)的元素 , k >= size()时抛出out_of_range
+        value_type select(size_type k) const {
+            for (size_type i = 0; i < keys.size(); ++i) {
+                if (k < containers[i].card) return value_type(keys[i]) << 16 | containers[i].select(uint32_t(k));
+                k -= containers[i].card;
+            }
+            throw std::out_of_range("roaring_bitmap select");
+        }
+
+        // 按升序对每个元素调用fn
+        template<typename Function>
+        Function for_each(Function fn) const {
+            for (size_type i = 0; i < keys.size(); ++i) containers[i].for_each(fn, value_type(keys[i]) << 16);
+            return fn;
+        }
+
+        // (*this & other).size() , 不构造临时对象
+        size_type and_count(const roaring_bitmap &other) const {
+            size_type ret = 0;
+            for (size_type i = 0, j = 0; i < keys.size() && j < other.keys.size();) {
+                if (keys[i] < other.keys[j]) ++i;
+                else if (keys[i] > other.keys[j]) ++j;
+                else ret += container_and_count(containers[i++], other.containers[j++]);
+            }
+            return ret;
+        }
+
+        size_type or_count(const roaring_bitmap &other) const {
+            return size() + other.size() - and_count(other);
+        }
+
+        size_type xor_count(const roaring_bitmap &other) const {
+            return size() + other.size() - 2 * and_count(other);
+        }
+
+        // (*this & ~other).size()
+        size_type and_not_count(const roaring_bitmap &other) const {
+            return size() - and_count(other);
+        }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 返回是否新增
+        bool add(value_type x) {
+            uint16_t high = uint16_t(x >> 16);
+            size_type i = lower_key(high);
+            if (i == keys.size() || keys[i] != high) {
+                keys.insert(keys.begin() + i, high);
+                containers.insert(containers.begin() + i, container());
+            }
+            return containers[i].add(uint16_t(x));
+        }
+
+        // 返回是否删除
+        bool remove(value_type x) {
+            size_type i = find_key(uint16_t(x >> 16));
+            if (i == keys.size() || !containers[i].remove(uint16_t(x))) return false;
+            if (containers[i].card == 0) {
+                keys.erase(keys.begin() + i);
+                containers.erase(containers.begin() + i);
+            }
+            return true;
+        }
+
+        void clear() {
+            keys.clear();
+            containers.clear();
+        }
+
+        // 把run编码更小的容器转为run容器 , 返回是否有容器被转换
+        bool run_optimize() {
+            bool changed = false;
+            for (container &c: containers) {
+                if (c.type == run_type) continue;
+                if (2 + 4 * c.count_runs() < c.serialized_size()) c.to_run(), changed = true;
+            }
+            return changed;
+        }
+
+        roaring_bitmap &operator&=(const roaring_bitmap &other) {
+            return *this = combine<simd_and>(*this, other);
+        }
+
+        roaring_bitmap &operator|=(const roaring_bitmap &other) {
+            return *this = combine<simd_or>(*this, other);
+        }
+
+        roaring_bitmap &operator^=(const roaring_bitmap &other) {
+            return *this = combine<simd_xor>(*this, other);
+        }
+
+        // *this &= ~other
+        roaring_bitmap &and_not(const roaring_bitmap &other) {
+            return *this = combine<simd_and_not>(*this, other);
+        }
+
+#pragma endregion
+    public: // serialize
+#pragma region
+
+        // Roaring可移植格式(与CRoaring/Java版本互通)的字节数
+        size_type serialized_size() const {
+            size_type n = keys.size(), ret = has_run() ? 4 + (n + 7) / 8 + 4 * n + (n >= no_offset_threshold ? 4 * n : 0)
+                                                       : 8 + 8 * n;
+            for (const container &c: containers) ret += c.serialized_size();
+            return ret;
+        }
+
+        // 写入serialized_size()个字节 , 返回写入的字节数
+        size_type serialize(void *out) const {
+            char *buf = static_cast<char *>(out), *p = buf;
+            uint32_t n = uint32_t(keys.size());
+            bool run = has_run();
+            if (run) {
+                roaring_store<uint32_t>(p, cookie_run | (n - 1) << 16), p += 4;
+                memset(p, 0, (n + 7) / 8);
+                for (uint32_t i = 0; i < n; ++i) if (containers[i].type == run_type) p[i / 8] |= char(1 << (i % 8));
+                p += (n + 7) / 8;
+            } else {
+                roaring_store<uint32_t>(p, cookie_no_run), roaring_store<uint32_t>(p + 4, n), p += 8;
+            }
+            for (uint32_t i = 0; i < n; ++i, p += 4) {
+                roaring_store<uint16_t>(p, keys[i]), roaring_store<uint16_t>(p + 2, uint16_t(containers[i].card - 1));
+            }
+            char *offsets = !run || n >= no_offset_threshold ? p : nullptr;
+            if (offsets) p += 4 * n;
+            for (uint32_t i = 0; i < n; ++i) {
+                const container &c = containers[i];
+                if (offsets) roaring_store<uint32_t>(offsets + 4 * i, uint32_t(p - buf));
+                if (c.type == bitset_type) {
+                    const word_type *w = c.bits.data();
+                    for (uint32_t j = 0; j < container_words; ++j, p += 8) roaring_store<uint64_t>(p, w[j]);
+                    continue;
+                }
+                if (c.type == run_type) roaring_store<uint16_t>(p, uint16_t(c.run_count())), p += 2;
+                for (uint16_t x: c.values) roaring_store<uint16_t>(p, x), p += 2;
+            }
+            return p - buf;
+        }
+
+        // 数据不合法时抛出invalid_argument
+        static roaring_bitmap deserialize(const void *in, size_type bytes);
+
+#pragma endregion
+    public: // operator
+#pragma region
+
+        // 元素相同即相等 , 与容器的表示方式无关
+        friend bool operator==(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+            if (lhs.keys != rhs.keys) return false;
+            for (size_type i = 0; i < lhs.keys.size(); ++i) {
+                const container &a = lhs.containers[i], &b = rhs.containers[i];
+                if (a.card != b.card || container_and_count(a, b) != a.card) return false;
+            }
+            return true;
+        }
+
+        friend bool operator!=(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend roaring_bitmap operator&(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+            return combine<simd_and>(lhs, rhs);
+        }
+
+        friend roaring_bitmap operator|(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+            return combine<simd_or>(lhs, rhs);
+        }
+
+        friend roaring_bitmap operator^(const roaring_bitmap &lhs, const roaring_bitmap &rhs) {
+            return combine<simd_xor>(lhs, rhs);
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        bool has_run() const {
+            for (const container &c: containers) if (c.type == run_type) return true;
+            return false;
+        }
+
+        size_type lower_key(uint16_t high) const {
+            return std::lower_bound(keys.data(), keys.data() + keys.size(), high) - keys.data();
+        }
+
+        // 不存在时返回keys.size()
+        size_type find_key(uint16_t high) const {
+            size_type i = lower_key(high);
+            return i != keys.size() && keys[i] == high ? i : keys.size();
+        }
+
+        // 按键归并 , 一方缺少的键视为空容器
+        template<simd_bit_op Op>
+        static roaring_bitmap combine(const roaring_bitmap &a, const roaring_bitmap &b) {
+            constexpr bool keep_a = Op != simd_and, keep_b = Op == simd_or || Op == simd_xor;
+            roaring_bitmap ret;
+            size_type i = 0, j = 0, n = a.keys.size(), m = b.keys.size();
+            while (i < n && j < m) {
+                if (a.keys[i] < b.keys[j]) {
+                    if (keep_a) ret.push(a.keys[i], a.containers[i]);
+                    ++i;
+                } else if (a.keys[i] > b.keys[j]) {
+                    if (keep_b) ret.push(b.keys[j], b.containers[j]);
+                    ++j;
+                } else {
+                    container c = container_combine<Op>(a.containers[i], b.containers[j]);
+                    if (c.card) ret.push(a.keys[i], std::move(c));
+                    ++i, ++j;
+                }
+            }
+            for (; keep_a && i < n; ++i) ret.push(a.keys[i], a.containers[i]);
+            for (; keep_b && j < m; ++j) ret.push(b.keys[j], b.containers[j]);
+            return ret;
+        }
+
+        void push(uint16_t key, container c) {
+            keys.push_back(key);
+            containers.push_back(std::move(c));
+        }
+
+        // run容器展开为另外两种 , 其余的直接返回
+        static const container &expanded(const container &c, container &tmp) {
+            if (c.type != run_type) return c;
+            tmp = c;
+            return tmp.expand(), tmp;
+        }
+
+        // 线程局部的65536位暂存区 , 使用后需要清回0
+        static word_type *scratch() {
+            thread_local word_type words[container_words] = {};
+            return words;
+        }
+
+        // 两个升序数组按Op归并
+        // 交集与差集把一方标记在暂存区中 , 再按序探测另一方 , 每个元素的判断互不依赖 ; 大小悬殊的交集改为二分
+        // 并集与对称差每步用比较结果推进指针而不是分支 , 避免随机数据上的分支预测失败
+        template<simd_bit_op Op>
+        static void merge_arrays(const ttl::vector<uint16_t> &a, const ttl::vector<uint16_t> &b,
+                                 ttl::vector<uint16_t> &out) {
+            const uint16_t *p = a.data(), *pe = p + a.size(), *q = b.data(), *qe = q + b.size();
+            if (Op == simd_and && (a.size() * 64 < b.size() || b.size() * 64 < a.size())) {
+                if (a.size() > b.size()) std::swap(p, q), std::swap(pe, qe);
+                for (; p != pe && q != qe; ++p) {
+                    q = std::lower_bound(q, qe, *p);
+                    if (q != qe && *q == *p) out.push_back(*p);
+                }
+                return;
+            }
+            if constexpr (Op == simd_and || Op == simd_and_not) {
+                const ttl::vector<uint16_t> &mark = Op == simd_and && a.size() < b.size() ? a : b;
+                const ttl::vector<uint16_t> &scan = &mark == &b ? a : b;
+                word_type *w = scratch();
+                for (uint16_t x: mark) w[x / 64] |= word_type(1) << (x % 64);
+                out.resize(scan.size());
+                uint16_t *o = out.data();
+                for (uint16_t x: scan) *o = x, o += (w[x / 64] >> (x % 64) & 1) == (Op == simd_and);
+                for (uint16_t x: mark) w[x / 64] = 0;
+                return out.resize(o - out.data());
+            }
+            out.resize(a.size() + b.size());
+            uint16_t *o = out.data();
+            while (p != pe && q != qe) {
+                uint16_t x = *p, y = *q;
+                *o = x < y ? x : y;
+                o += Op == simd_or || x != y;
+                p += x <= y, q += y <= x;
+            }
+            o = std::copy(q, qe, std::copy(p, pe, o));
+            out.resize(o - out.data());
+        }
+
+        template<simd_bit_op Op>
+        static container container_combine(const container &x, const container &y) {
+            container ta, tb;
+            const container &a = expanded(x, ta), &b = expanded(y, tb);
+            container ret;
+            if (a.type == array_type && b.type == array_type) {
+                merge_arrays<Op>(a.values, b.values, ret.values);
+                ret.card = uint32_t(ret.values.size());
+                if (ret.card > array_max) ret.to_bitset();
+                return ret;
+            }
+            if (Op == simd_and && b.type == array_type) return container_combine<Op>(b, a);
+            if ((Op == simd_and || Op == simd_and_not) && a.type == array_type) {
+                for (uint16_t v: a.values) if (b.bits[v] == (Op == simd_and)) ret.values.push_back(v);
+                ret.card = uint32_t(ret.values.size());
+                return ret;
+            }
+            // 此时至少一方是bitset , 以bitset的一方为基础计算
+            const container &base = a.type == bitset_type ? a : b, &rest = &base == &a ? b : a;
+            ret.type = bitset_type;
+            ret.bits = base.bits;
+            if (rest.type == bitset_type) {
+                if (Op == simd_and) ret.bits &= rest.bits;
+                else if (Op == simd_or) ret.bits |= rest.bits;
+                else if (Op == simd_xor) ret.bits ^= rest.bits;
+                else ret.bits.and_not(rest.bits);
+                ret.card = uint32_t(ret.bits.count());
+            } else {
+                ret.card = base.card;
+                for (uint16_t v: rest.values) {
+                    bool had = ret.bits[v];
+                    if (Op == simd_or && !had) ret.bits.set(v), ++ret.card;
+                    else if (Op == simd_xor) ret.bits.flip(v), had ? --ret.card : ++ret.card;
+                    else if (Op == simd_and_not && had) ret.bits.reset(v), --ret.card;
+                }
+            }
+            if (ret.card <= array_max) ret.to_array();
+            return ret;
+        }
+
+        static uint32_t container_and_count(const container &x, const container &y) {
+            if (x.type == array_type && y.type == array_type) {
+                const ttl::vector<uint16_t> &mark = x.card < y.card ? x.values : y.values;
+                const ttl::vector<uint16_t> &scan = &mark == &x.values ? y.values : x.values;
+                word_type *w = scratch();
+                uint32_t ret = 0;
+                for (uint16_t v: mark) w[v / 64] |= word_type(1) << (v % 64);
+                for (uint16_t v: scan) ret += w[v / 64] >> (v % 64) & 1;
+                for (uint16_t v: mark) w[v / 64] = 0;
+                return ret;
+            }
+            if (x.type == array_type || y.type == array_type) {
+                const container &a = x.type == array_type ? x : y, &b = &a == &x ? y : x;
+                uint32_t ret = 0;
+                for (uint16_t v: a.values) ret += b.contains(v);
+                return ret;
+            }
+            container ta, tb;
+            const container &a = expanded(x, ta), &b = expanded(y, tb);
+            if (a.type == array_type || b.type == array_type) return container_and_count(a, b);
+            return uint32_t(a.bits.and_count(b.bits));
+        }
+
+#pragma endregion
+    };
+
+    // 在Roaring可移植格式的数据上直接查询 , 不复制数据 , 可用于内存映射的文件
+    // 构造时只校验头部与每个容器的边界 , 数据需要在view的生命周期内有效
+    class roaring_bitmap_view {
+        using size_type = size_t;
+        using container_type = roaring_bitmap::container_type;
+
+        const char *buf = nullptr;
+        size_type bytes = 0;
+        uint32_t n = 0;
+        const char *run_flags = nullptr; // 没有run容器时为nullptr
+        const char *desc = nullptr; // n个(键 , 基数-1)
+        const char *offsets = nullptr; // n个容器的起始偏移 , 省略时为nullptr
+        uint32_t scanned[roaring_bitmap::no_offset_threshold] = {}; // 省略偏移表时扫描得到的偏移
+    public: // constructor
+#pragma region
+
+        roaring_bitmap_view(const void *data, size_type size) : buf(static_cast<const char *>(data)), bytes(size) {
+            check(bytes >= 4);
+            uint32_t cookie = roaring_load<uint32_t>(buf);
+            const char *p = buf + 4;
+            if ((cookie & 0xffff) == roaring_bitmap::cookie_run) {
+                n = (cookie >> 16) + 1;
+                check(bytes >= 4 + (n + 7) / 8);
+                run_flags = p, p += (n + 7) / 8;
+            } else {
+                check(cookie == roaring_bitmap::cookie_no_run && bytes >= 8);
+                n = roaring_load<uint32_t>(p), p += 4;
+            }
+            check(n <= 1 << 16 && size_type(p - buf) + 4 * size_type(n) <= bytes);
+            desc = p, p += 4 * size_type(n);
+            if (!run_flags || n >= roaring_bitmap::no_offset_threshold) {
+                check(size_type(p - buf) + 4 * size_type(n) <= bytes);
+                offsets = p, p += 4 * size_type(n);
+            }
+            size_type pos = p - buf;
+            for (uint32_t i = 0; i < n; ++i) {
+                check(i == 0 || key(i - 1) < key(i));
+                if (offsets) pos = roaring_load<uint32_t>(offsets + 4 * i);
+                else scanned[i] = uint32_t(pos);
+                check(pos + 2 <= bytes);
+                pos += container_size(i, buf + pos);
+                check(pos <= bytes);
+            }
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type container_count() const { return n; }
+
+        size_type size() const {
+            size_type ret = 0;
+            for (uint32_t i = 0; i < n; ++i) ret += card(i);
+            return ret;
+        }
+
+        bool empty() const { return n == 0; }
+
+        bool contains(uint32_t x) const {
+            uint32_t i = find_key(uint16_t(x >> 16));
+            if (i == n) return false;
+            const char *p = container_at(i);
+            uint16_t low = uint16_t(x);
+            switch (type(i)) {
+                case roaring_bitmap::array_type: {
+                    uint32_t j = lower_u16(p, card(i), low);
+                    return j < card(i) && roaring_load<uint16_t>(p + 2 * j) == low;
+                }
+                case roaring_bitmap::bitset_type:
+                    return roaring_load<uint64_t>(p + 8 * (low / 64)) >> (low % 64) & 1;
+                default: {
+                    uint32_t runs = roaring_load<uint16_t>(p), j = upper_run(p + 2, runs, low);
+                    if (j == 0) return false;
+                    const char *r = p + 2 + 4 * (j - 1);
+                    return low - roaring_load<uint16_t>(r) <= roaring_load<uint16_t>(r + 2);
+                }
+            }
+        }
+
+        // 不大于x的元素个数
+        size_type rank(uint32_t x) const {
+            size_type ret = 0;
+            uint16_t high = uint16_t(x >> 16), low = uint16_t(x);
+            for (uint32_t i = 0; i < n && key(i) <= high; ++i) {
+                if (key(i) < high) {
+                    ret += card(i);
+                    continue;
+                }
+                const char *p = container_at(i);
+                switch (type(i)) {
+                    case roaring_bitmap::array_type:
+                        ret += upper_u16(p, card(i), low);
+                        break;
+                    case roaring_bitmap::bitset_type:
+                        for (uint32_t w = 0; w < low / 64; ++w) ret += ttl::popcount(roaring_load<uint64_t>(p + 8 * w));
+                        ret += ttl::popcount(roaring_load<uint64_t>(p + 8 * (low / 64)) & (~0ull >> (63 - low % 64)));
+                        break;
+                    default:
+                        for (uint32_t j = 0, runs = roaring_load<uint16_t>(p); j < runs; ++j) {
+                            uint32_t start = roaring_load<uint16_t>(p + 2 + 4 * j), len = roaring_load<uint16_t>(p + 4 + 4 * j);
+                            if (start > low) break;
+                            ret += ttl::min(len, uint32_t(low - start)) + 1;
+                        }
+                }
+            }
+            return ret;
+        }
+
+        // 第k小(从0开始)的元素 , k >= size()时抛出out_of_range
+        uint32_t select(size_type k) const {
+            for (uint32_t i = 0; i < n; ++i) {
+                if (k >= card(i)) {
+                    k -= card(i);
+                    continue;
+                }
+                const char *p = container_at(i);
+                uint32_t high = uint32_t(key(i)) << 16;
+                switch (type(i)) {
+                    case roaring_bitmap::array_type:
+                        return high | roaring_load<uint16_t>(p + 2 * k);
+                    case roaring_bitmap::bitset_type:
+                        for (uint32_t w = 0;; ++w) {
+                            uint64_t word = roaring_load<uint64_t>(p + 8 * w);
+                            uint32_t c = ttl::popcount(word);
+                            if (k < c) return high | (w * 64 + ttl::bit_select(word, int(k)));
+                            k -= c;
+                        }
+                    default:
+                        for (uint32_t j = 0;; ++j) {
+                            uint32_t len = uint32_t(roaring_load<uint16_t>(p + 4 + 4 * j)) + 1;
+                            if (k < len) return high | uint32_t(roaring_load<uint16_t>(p + 2 + 4 * j) + k);
+                            k -= len;
+                        }
+                }
+            }
+            throw std::out_of_range("roaring_bitmap_view select");
+        }
+
+        // 反序列化为roaring_bitmap
+        roaring_bitmap to_bitmap() const {
+            roaring_bitmap ret;
+            ret.keys.reserve(n);
+            ret.containers.reserve(n);
+            for (uint32_t i = 0; i < n; ++i) {
+                roaring_bitmap::container c;
+                const char *p = container_at(i);
+                c.type = type(i), c.card = card(i);
+                if (c.type == roaring_bitmap::bitset_type) {
+                    c.bits.reserve(roaring_bitmap::container_bit);
+                    for (uint32_t w = 0; w < roaring_bitmap::container_words; ++w) c.bits.append(roaring_load<uint64_t>(p + 8 * w));
+                } else {
+                    uint32_t count = c.type == roaring_bitmap::array_type ? c.card : 2 * roaring_load<uint16_t>(p);
+                    if (c.type == roaring_bitmap::run_type) p += 2;
+                    c.values.reserve(count);
+                    for (uint32_t j = 0; j < count; ++j) c.values.push_back(roaring_load<uint16_t>(p + 2 * j));
+                }
+                ret.push(key(i), std::move(c));
+            }
+            return ret;
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        static void check(bool ok) {
+            if (!ok) throw std::invalid_argument("roaring_bitmap bad format");
+        }
+
+        uint16_t key(uint32_t i) const { return roaring_load<uint16_t>(desc + 4 * i); }
+
+        uint32_t card(uint32_t i) const { return uint32_t(roaring_load<uint16_t>(desc + 4 * i + 2)) + 1; }
+
+        container_type type(uint32_t i) const {
+            if (run_flags && (run_flags[i / 8] >> (i % 8) & 1)) return roaring_bitmap::run_type;
+            return card(i) <= roaring_bitmap::array_max ? roaring_bitmap::array_type : roaring_bitmap::bitset_type;
+        }
+
+        size_type container_size(uint32_t i, const char *p) const {
+            container_type t = type(i);
+            if (t == roaring_bitmap::run_type) return 2 + 4 * size_type(roaring_load<uint16_t>(p));
+            return t == roaring_bitmap::array_type ? 2 * size_type(card(i)) : roaring_bitmap::container_words * 8;
+        }
+
+        const char *container_at(uint32_t i) const {
+            return buf + (offsets ? roaring_load<uint32_t>(offsets + 4 * i) : scanned[i]);
+        }
+
+        // 不存在时返回n
+        uint32_t find_key(uint16_t high) const {
+            uint32_t l = 0, r = n;
+            while (l < r) {
+                uint32_t mid = l + (r - l) / 2;
+                key(mid) < high ? l = mid + 1 : r = mid;
+            }
+            return l < n && key(l) == high ? l : n;
+        }
+
+        // p开始的count个u16中第一个不小于x的下标
+        static uint32_t lower_u16(const char *p, uint32_t count, uint16_t x) {
+            uint32_t l = 0, r = count;
+            while (l < r) {
+                uint32_t mid = l + (r - l) / 2;
+                roaring_load<uint16_t>(p + 2 * mid) < x ? l = mid + 1 : r = mid;
+            }
+            return l;
+        }
+
+        // p开始的count个u16中第一个大于x的下标
+        static uint32_t upper_u16(const char *p, uint32_t count, uint16_t x) {
+            uint32_t l = 0, r = count;
+            while (l < r) {
+                uint32_t mid = l + (r - l) / 2;
+                roaring_load<uint16_t>(p + 2 * mid) <= x ? l = mid + 1 : r = mid;
+            }
+            return l;
+        }
+
+        // 起点大于x的第一个run的下标
+        static uint32_t upper_run(const char *p, uint32_t runs, uint16_t x) {
+            uint32_t l = 0, r = runs;
+            while (l < r) {
+                uint32_t mid = l + (r - l) / 2;
+                roaring_load<uint16_t>(p + 4 * mid) <= x ? l = mid + 1 : r = mid;
+            }
+            return l;
+        }
+
+#pragma endregion
+    };
+
+    inline roaring_bitmap roaring_bitmap::deserialize(const void *in, size_type bytes) {
+        return roaring_bitmap_view(in, bytes).to_bitmap();
+    }
+}
+
+#endif //TINYSTL_ROARING_BITMAP_H
@@ -7,6 +7,7 @@
 
 #include <vector>
 #include <functional>
+#include "../../algorithm/bit.h"
 
 namespace ttl {
     /*
@@ -29,14 +30,14 @@ namespace ttl {
     template<typename T1, typename T2>
     class multiplies {
     public:
-        auto operator()(const T1 &v1, const T2 &v2) {
+        auto operator()(const T1 &v1, const T2 &v2) const {
             return v1 * v2;
         }
     };
 
     template<
             typename T,
-            //int FeatureTag = 1 | 2 | 4, // 1为add, 2为mut , 4为set Todo 使用tag来定制轻量级的操作
+            // 只需要部分懒惰操作时 , 见lazy_segment_tree的Features参数
             typename Merge = std::plus<T>,
             typename RepeatType = int32_t,
             typename Repeat = ttl::multiplies<T, RepeatType>
@@ -356,7 +357,8 @@ namespace ttl {
 
         // 从左右结点获取正确的值
         void update(tree_index index) {
-            trees[index.idx].merged = merge(trees[index.l].merged, trees[index.r].merged);
+            auto [l, r] = index.get_lr();
+            trees[index.idx].merged = merge(trees[l.idx].merged, trees[r.idx].merged);
         }
 
         // 将惰性修改的值传递给左右结点,并更新merged
@@ -372,7 +374,9 @@ namespace ttl {
                 set_val(right, root.set);
 
                 root.on_setting = false;
-            } else {
+            }
+            // set之后的mut/add记录在set之上 , 需继续下传
+            {
                 left.merged = merge(
                         repeat(left.merged, root.mut),
                         repeat(root.add, l.width())
@@ -397,6 +401,277 @@ namespace ttl {
             node.add = epsilon, node.mut = 1;
         }
 
+#pragma endregion
+    };
+
+    // lazy_segment_tree中可选的懒惰操作 , 未选中的操作不分配对应的懒惰标记
+    enum segment_tree_feature {
+        segment_add = 1,
+        segment_mut = 2,
+        segment_set = 4,
+    };
+
+    // 非递归的单点修改 , 区间查询线段树
+    // 共2n个结点 , 叶子位于[n,2n) , 结点i的孩子为2i与2i+1 , 不要求n为2的幂
+    // 查询时左右两侧分别累积 , 因此Merge只需满足结合律
+    template<typename T, typename Merge = std::plus<T>>
+    class iterative_segment_tree {
+    public:
+        using size_type = size_t;
+    private:
+        Merge merge;
+        const T epsilon;
+        std::vector<T> trees;
+        size_type len;
+    public: // constructor
+#pragma region
+
+        explicit iterative_segment_tree(const std::vector<T> &input, Merge merge = {}, const T &epsilon = {})
+                : merge(merge), epsilon(epsilon), trees(input.size() * 2, epsilon), len(input.size()) {
+            std::copy(input.begin(), input.end(), trees.begin() + len);
+            for (size_type i = len; i-- > 1;) pull(i);
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return len; }
+
+        // 获取[l,r]的merge结果
+        T get(size_type l, size_type r) const {
+            T left = epsilon, right = epsilon;
+            for (l += len, r += len + 1; l < r; l >>= 1, r >>= 1) {
+                if (l & 1) left = merge(left, trees[l++]);
+                if (r & 1) right = merge(trees[--r], right);
+            }
+            return merge(left, right);
+        }
+
+        // 获取位于idx的元素
+        T get(size_type idx) const { return trees[idx + len]; }
+
+#pragma endregion
+    public: // modify
+#pragma region
+
+        // 使得位于idx的元素等于val
+        void set(size_type idx, const T &val) {
+            idx += len;
+            trees[idx] = val;
+            for (idx >>= 1; idx > 0; idx >>= 1) pull(idx);
+        }
+
+        // 使得位于idx的元素与val合并
+        void add(size_type idx, const T &val) {
+            set(idx, merge(trees[idx + len], val));
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        void pull(size_type i) { trees[i] = merge(trees[i * 2], trees[i * 2 + 1]); }
+
+#pragma endregion
+    };
+
+    // 非递归的懒惰线段树 , 支持区间add/mut/set与区间查询 , 代数性质同segment_tree
+    // 叶子数补齐为2的幂cap , 结点i的宽度为cap >> (bit_width(i) - 1)
+    // 修改与查询前自顶向下下传[l,r]两端路径上的标记 , 修改后再自底向上重新合并
+    // 懒惰标记按结构数组分开存放 , 只为Features中选中的操作分配 , 复合顺序为 : 先set , 再mut , 最后add
+    template<
+            typename T,
+            int Features = segment_add | segment_mut | segment_set,
+            typename Merge = std::plus<T>,
+            typename RepeatType = int32_t,
+            typename Repeat = ttl::multiplies<T, RepeatType>
+    >
+    class lazy_segment_tree {
+        static_assert(std::is_integral_v<RepeatType>); // 必须是整数
+        static_assert(Features > 0 && Features < 8, "no lazy feature , use iterative_segment_tree instead");
+    public:
+        using size_type = size_t;
+    private:
+        static constexpr bool has_add = Features & segment_add;
+        static constexpr bool has_mut = Features & segment_mut;
+        static constexpr bool has_set = Features & segment_set;
+
+        // 未开启的操作对应空基类 , 由空基类优化去掉其空间
+        template<bool Enable, typename U, int Id>
+        struct lazy_field {
+            U value;
+        };
+
+        template<typename U, int Id>
+        struct lazy_field<false, U, Id> {
+        };
+
+        struct set_value {
+            T value;
+            bool on_setting; // 是否激活了set标签
+        };
+
+        // 一个内部结点的全部懒惰标记 , 连续存放以便下传时只访问一处
+        struct lazy_tag : lazy_field<has_add, T, 0>, lazy_field<has_mut, RepeatType, 1>, lazy_field<has_set, set_value, 2> {
+        };
+
+        Merge merge;
+        Repeat repeat;
+        const T epsilon;
+
+        size_type len, cap;
+        int height;
+        std::vector<T> trees;            // 2*cap个结点的merge结果
+        std::vector<lazy_tag> tags;      // cap个内部结点的懒惰标记
+    public: // constructor
+#pragma region
+
+        explicit lazy_segment_tree(
+                const std::vector<T> &input,
+                Merge merge = {},
+                Repeat repeat = {},
+                const T &epsilon = {}
+        ) : merge(merge), repeat(repeat), epsilon(epsilon), len(input.size()),
+            cap(len > 1 ? size_type(1) << ttl::bit_width(len - 1) : 1), height(ttl::bit_width(cap) - 1),
+            trees(cap * 2, epsilon), tags(cap) {
+            for (size_type i = 1; i < cap; ++i) {
+                if constexpr (has_add) add_of(i) = epsilon;
+                if constexpr (has_mut) mut_of(i) = 1;
+                if constexpr (has_set) set_of(i) = {epsilon, false};
+            }
+            std::copy(input.begin(), input.end(), trees.begin() + cap);
+            for (size_type i = cap; i-- > 1;) pull(i);
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return len; }
+
+        // 获取[l,r]的merge结果
+        T get(size_type l, size_type r) {
+            l += cap, r += cap + 1;
+            push_bound(l, r);
+            T left = epsilon, right = epsilon;
+            for (; l < r; l >>= 1, r >>= 1) {
+                if (l & 1) left = merge(left, trees[l++]);
+                if (r & 1) right = merge(trees[--r], right);
+            }
+            return merge(left, right);
+        }
+
+        // 获取位于idx的元素
+        T get(size_type idx) {
+            idx += cap;
+            for (int i = height; i > 0; --i) push(idx >> i);
+            return trees[idx];
+        }
+
+#pragma endregion
+    public: // modify
+#pragma region
+
+        // 使得[l,r]每个元素都加val
+        void add(size_type l, size_type r, const T &val) {
+            static_assert(has_add, "segment_add is not enabled");
+            update(l, r, [this, &val](size_type i) { apply_add(i, val); });
+        }
+
+        // 使得[l,r]每个元素都乘k
+        void mut(size_type l, size_type r, RepeatType k) {
+            static_assert(has_mut, "segment_mut is not enabled");
+            update(l, r, [this, k](size_type i) { apply_mut(i, k); });
+        }
+
+        // 使得[l,r]每个元素都等于val
+        void set(size_type l, size_type r, const T &val) {
+            static_assert(has_set, "segment_set is not enabled");
+            update(l, r, [this, &val](size_type i) { apply_set(i, val); });
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        // 对[l,r]分解出的O(log n)个结点执行apply
+        template<typename Apply>
+        void update(size_type l, size_type r, Apply apply) {
+            l += cap, r += cap + 1;
+            push_bound(l, r);
+            for (size_type a = l, b = r; a < b; a >>= 1, b >>= 1) {
+                if (a & 1) apply(a++);
+                if (b & 1) apply(--b);
+            }
+            for (int i = 1; i <= height; ++i) {
+                if (((l >> i) << i) != l) pull(l >> i);
+                if (((r >> i) << i) != r) pull((r - 1) >> i);
+            }
+        }
+
+        // 下传叶子区间[l,r)两端路径上的标记 , 完整覆盖的结点无需下传
+        void push_bound(size_type l, size_type r) {
+            for (int i = height; i > 0; --i) {
+                if (((l >> i) << i) != l) push(l >> i);
+                if (((r >> i) << i) != r) push((r - 1) >> i);
+            }
+        }
+
+        RepeatType width(size_type i) const {
+            return RepeatType(cap >> (ttl::bit_width(i) - 1));
+        }
+
+        void pull(size_type i) { trees[i] = merge(trees[i * 2], trees[i * 2 + 1]); }
+
+        T &add_of(size_type i) { return static_cast<lazy_field<true, T, 0> &>(tags[i]).value; }
+
+        RepeatType &mut_of(size_type i) { return static_cast<lazy_field<true, RepeatType, 1> &>(tags[i]).value; }
+
+        set_value &set_of(size_type i) { return static_cast<lazy_field<true, set_value, 2> &>(tags[i]).value; }
+
+        void apply_add(size_type i, const T &val) {
+            trees[i] = merge(trees[i], repeat(val, width(i)));
+            if (i < cap) add_of(i) = merge(add_of(i), val);
+        }
+
+        void apply_mut(size_type i, RepeatType k) {
+            trees[i] = repeat(trees[i], k);
+            if (i < cap) {
+                mut_of(i) *= k;
+                if constexpr (has_add) add_of(i) = repeat(add_of(i), k);
+            }
+        }
+
+        void apply_set(size_type i, const T &val) {
+            trees[i] = repeat(val, width(i));
+            if (i < cap) {
+                set_of(i) = {val, true};
+                if constexpr (has_add) add_of(i) = epsilon;
+                if constexpr (has_mut) mut_of(i) = 1;
+            }
+        }
+
+        // 将结点i的标记按set , mut , add的顺序传给两个孩子
+        void push(size_type i) {
+            if constexpr (has_set) {
+                if (set_of(i).on_setting) {
+                    apply_set(i * 2, set_of(i).value), apply_set(i * 2 + 1, set_of(i).value);
+                    set_of(i).on_setting = false;
+                }
+            }
+            if constexpr (has_mut) {
+                if (mut_of(i) != 1) {
+                    apply_mut(i * 2, mut_of(i)), apply_mut(i * 2 + 1, mut_of(i));
+                    mut_of(i) = 1;
+                }
+            }
+            if constexpr (has_add) {
+                apply_add(i * 2, add_of(i)), apply_add(i * 2 + 1, add_of(i));
+                add_of(i) = epsilon;
+            }
+        }
+
 #pragma endregion
     };
 }
@@ -0,0 +1,153 @@
+﻿#ifndef TINYSTL_SPARSE_TABLE_H
+#define TINYSTL_SPARSE_TABLE_H
+
+#include <cstdint>
+#include <vector>
+#include <functional>
+#include "../../algorithm/bit.h"
+
+namespace ttl {
+
+    // 按Compare取两者中较优的一个 , 相等时取第一个 , 作为sparse_table的默认运算
+    template<typename T, typename Compare = std::less<T>>
+    struct minimum {
+        Compare comp;
+
+        T operator()(const T &a, const T &b) const { return comp(b, a) ? b : a; }
+    };
+
+    // 静态数组上的区间查询 , O(n log n)建表 , O(1)查询
+    // Op需满足结合律与幂等律(x op x = x) , 如min , max , gcd , 按位与/或
+    // 第k层的第i项为[i, i + 2^k)的Op结果 , 查询[l,r]时取覆盖它的两个长为2^k的区间 , k = bit_width(r - l + 1) - 1
+    template<typename T, typename Op = ttl::minimum<T>>
+    class sparse_table {
+    public:
+        using size_type = size_t;
+    private:
+        Op op;
+        std::vector<T> table;           // 各层连续存放 , 第k层有n - 2^k + 1项
+        std::vector<size_type> offsets; // 第k层在table中的起点
+        size_type len;
+    public: // constructor
+#pragma region
+
+        explicit sparse_table(const std::vector<T> &input, Op op = {}) : op(op), len(input.size()) {
+            int levels = len ? ttl::bit_width(len) : 0;
+            size_type total = 0;
+            for (int k = 0; k < levels; ++k) offsets.push_back(total), total += len - (size_type(1) << k) + 1;
+            table.reserve(total);
+            table.insert(table.end(), input.begin(), input.end());
+            for (int k = 1; k < levels; ++k) {
+                const size_type prev = offsets[k - 1], half = size_type(1) << (k - 1);
+                for (size_type i = 0, n = len - (size_type(1) << k) + 1; i < n; ++i) {
+                    table.push_back(op(table[prev + i], table[prev + i + half]));
+                }
+            }
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return len; }
+
+        // 获取[l,r]的Op结果
+        T get(size_type l, size_type r) const {
+            int k = ttl::bit_width(r - l + 1) - 1;
+            const T *level = table.data() + offsets[k];
+            return op(level[l], level[r + 1 - (size_type(1) << k)]);
+        }
+
+        // 获取位于idx的元素
+        const T &get(size_type idx) const { return table[idx]; }
+
+        // 表占用的字节数
+        size_type table_bytes() const { return table.size() * sizeof(T) + offsets.size() * sizeof(size_type); }
+
+#pragma endregion
+    };
+
+    // O(n)空间的区间最值查询 , O(1)查询
+    // 每block个元素分一块 , 块的最值建sparse_table , 块内用单调栈位掩码 :
+    // masks[i]记录块内[块起点,i]的单调栈 , 即那些比其后直到i的元素都不差的位置
+    // 块内查询[l,r]时 , masks[r]中不小于l的最低位就是最值的位置 , 一次与运算加一次countr_zero
+    // 跨块查询为两端块内查询加中间整块的sparse_table查询
+    template<typename T, typename Compare = std::less<T>>
+    class block_sparse_table {
+    public:
+        using size_type = size_t;
+    private:
+        using mask_type = uint32_t;
+        static constexpr size_type block = 32;
+
+        Compare comp;
+        std::vector<T> elements;
+        std::vector<mask_type> masks;
+        sparse_table<T, ttl::minimum<T, Compare>> blocks;
+    public: // constructor
+#pragma region
+
+        explicit block_sparse_table(const std::vector<T> &input, Compare comp = {})
+                : comp(comp), elements(input), masks(input.size()), blocks(build(), {comp}) {}
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        size_type size() const { return elements.size(); }
+
+        // 获取[l,r]中按Compare最优的元素
+        T get(size_type l, size_type r) const {
+            size_type bl = l / block, br = r / block;
+            if (bl == br) return in_block(l, r);
+            const T &a = in_block(l, bl * block + block - 1), &b = in_block(br * block, r);
+            T ret = comp(b, a) ? b : a;
+            if (bl + 1 < br) {
+                T mid = blocks.get(bl + 1, br - 1);
+                if (comp(mid, ret)) ret = mid;
+            }
+            return ret;
+        }
+
+        // 获取位于idx的元素
+        const T &get(size_type idx) const { return elements[idx]; }
+
+        // 占用的字节数 , 包括元素的副本 , 位掩码与块的sparse_table , 与sparse_table::table_bytes一致
+        size_type table_bytes() const {
+            return elements.size() * sizeof(T) + masks.size() * sizeof(mask_type) + blocks.table_bytes();
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        // 计算每个位置的单调栈掩码 , 返回各块的最值
+        std::vector<T> build() {
+            std::vector<T> minima;
+            for (size_type start = 0; start < elements.size(); start += block) {
+                size_type end = start + block < elements.size() ? start + block : elements.size();
+                mask_type stack = 0;
+                for (size_type i = start; i < end; ++i) {
+                    // 弹出严格差于elements[i]的栈顶
+                    while (stack) {
+                        int top = ttl::bit_width(stack) - 1;
+                        if (!comp(elements[i], elements[start + top])) break;
+                        stack ^= mask_type(1) << top;
+                    }
+                    masks[i] = stack |= mask_type(1) << (i - start);
+                }
+                minima.push_back(elements[start + ttl::countr_zero(masks[end - 1])]);
+            }
+            return minima;
+        }
+
+        const T &in_block(size_type l, size_type r) const {
+            mask_type m = masks[r] & (~mask_type(0) << (l % block));
+            return elements[r - r % block + ttl::countr_zero(m)];
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_SPARSE_TABLE_H
@@ -0,0 +1,257 @@
+﻿#ifndef TINYSTL_TIMING_WHEEL_H
+#define TINYSTL_TIMING_WHEEL_H
+
+#include <cstdint>
+#include "intrusive_list.h"
+#include "../../algorithm/algorithm.h"
+
+namespace ttl {
+
+    // 嵌入到定时器对象内部的结点 , 记录到期时间与所在的槽
+    // 未调度时next == prev == nullptr
+    struct timer_hook {
+        timer_hook *next{};
+        timer_hook *prev{};
+        uint64_t expire{};
+        uint8_t level{};
+        uint8_t slot{};
+
+        timer_hook() = default;
+
+        // 复制对象时不复制调度状态
+        timer_hook(const timer_hook &) noexcept {}
+
+        timer_hook &operator=(const timer_hook &) noexcept { return *this; }
+
+        bool is_linked() const { return next != nullptr; }
+
+        // 调度时设置的到期时间
+        uint64_t expire_time() const { return expire; }
+    };
+
+    // 分层时间轮 , 定时器对象内嵌timer_hook , 容器不拥有对象
+    // 每层64个槽 , 第k层一个槽跨越64^k个tick , 定时器按到期时间与当前时间最高的不同6位组放入对应层
+    // 当前时间跨过某层的槽边界时 , 将该槽中的定时器重新分配到更低的层(级联)
+    // 每层用一个64位字记录非空的槽 , 推进时间时直接跳到下一个非空的槽
+    // schedule/cancel为O(1) , 每个定时器至多级联层数次
+    template<typename T, timer_hook T::*Hook>
+    class timing_wheel {
+    public:
+        using value_type = T;
+        using reference = T &;
+        using size_type = size_t;
+        using time_type = uint64_t;
+    private:
+        using node_type = timer_hook;
+
+        static constexpr int slot_bit = 6;
+        static constexpr int slot_count = 1 << slot_bit;
+        static constexpr int level_count = (64 + slot_bit - 1) / slot_bit;
+
+        node_type slots[level_count][slot_count];  // 每个槽为带虚拟头结点的循环链表
+        uint64_t occupied[level_count]{};          // 非空槽的位图
+        node_type overdue;                         // 调度时已经过期的定时器 , level为level_count
+        time_type cur;                             // 下一个待处理的tick , 更早到期的定时器均已触发
+        size_type count{};
+    public: // constructor
+#pragma region
+
+        explicit timing_wheel(time_type start = 0) : cur(start) {
+            for (auto &level: slots) for (auto &head: level) head.next = head.prev = &head;
+            overdue.next = overdue.prev = &overdue;
+        }
+
+        timing_wheel(const timing_wheel &) = delete;
+
+        timing_wheel &operator=(const timing_wheel &) = delete;
+
+        // 只取消调度 , 不销毁对象
+        ~timing_wheel() { clear(); }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return count == 0; }
+
+        size_type size() const { return count; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 在expire时刻触发value , 已经过去的时刻在下一次advance时触发
+        // value已被调度时改为新的到期时间
+        void schedule(reference value, time_type expire) {
+            node_type *node = &(value.*Hook);
+            if (node->is_linked()) unlink(node);
+            node->expire = expire;
+            if (expire < cur) {
+                hook(overdue.prev, node), hook(node, &overdue);
+                node->level = level_count;
+            } else {
+                place(node, expire);
+            }
+            ++count;
+        }
+
+        // 返回value之前是否处于调度中
+        bool cancel(reference value) {
+            node_type *node = &(value.*Hook);
+            if (!node->is_linked()) return false;
+            unlink(node);
+            return true;
+        }
+
+        // 推进到now , 依到期的槽的顺序对每个到期(expire <= now)的定时器调用on_expire(T &)
+        // 回调中可以schedule或cancel任意定时器 , 返回触发的个数
+        // 推进到time_type的最大值后cur停在该时刻 , 之后调度到该时刻的定时器在下一次advance时触发
+        template<typename Function>
+        size_type advance(time_type now, Function &&on_expire) {
+            node_type pending;
+            pending.next = pending.prev = &pending;
+            splice_list(&overdue, &pending);
+            size_type fired = fire(&pending, on_expire);
+            if (cur > now) return fired;
+            for (bool reached = false; !reached;) {
+                reached = collect(now, &pending);
+                fired += fire(&pending, on_expire);
+            }
+            return fired;
+        }
+
+        // 取消所有定时器
+        void clear() {
+            for (int k = 0; k < level_count; ++k) {
+                for (uint64_t mask = occupied[k]; mask; mask &= mask - 1) {
+                    node_type *head = &slots[k][ttl::countr_zero(mask)];
+                    for (node_type *node = head->next, *nxt; node != head; node = nxt) {
+                        nxt = node->next;
+                        node->next = node->prev = nullptr;
+                    }
+                    head->next = head->prev = head;
+                }
+                occupied[k] = 0;
+            }
+            for (node_type *node = overdue.next, *nxt; node != &overdue; node = nxt) {
+                nxt = node->next;
+                node->next = node->prev = nullptr;
+            }
+            overdue.next = overdue.prev = &overdue;
+            count = 0;
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        static void hook(node_type *pre, node_type *nxt) {
+            pre->next = nxt, nxt->prev = pre;
+        }
+
+        // 按相对于cur的位置放入槽中 , 要求when >= cur
+        void place(node_type *node, time_type when) {
+            uint64_t diff = when ^ cur;
+            int level = diff < slot_count ? 0 : (63 - ttl::countl_zero(diff)) / slot_bit;
+            int slot = int(when >> (level * slot_bit)) & (slot_count - 1);
+            node_type *head = &slots[level][slot];
+            hook(head->prev, node), hook(node, head);
+            node->level = uint8_t(level), node->slot = uint8_t(slot);
+            occupied[level] |= uint64_t(1) << slot;
+        }
+
+        // 从槽中移除 , 槽变空时清除位图中的标记
+        // 已被摘到待触发链表上的结点也可以移除 , 此时检查的是其原来的槽
+        void unlink(node_type *node) {
+            hook(node->prev, node->next);
+            node->next = node->prev = nullptr, --count;
+            if (node->level == level_count) return;
+            node_type *head = &slots[node->level][node->slot];
+            if (head->next == head) occupied[node->level] &= ~(uint64_t(1) << node->slot);
+        }
+
+        // 将from中的链表整体接到to尾部
+        static void splice_list(node_type *from, node_type *to) {
+            if (from->next == from) return;
+            hook(to->prev, from->next), hook(from->prev, to);
+            from->next = from->prev = from;
+        }
+
+        void splice_slot(int level, int slot, node_type *list) {
+            splice_list(&slots[level][slot], list);
+            occupied[level] &= ~(uint64_t(1) << slot);
+        }
+
+        // 逐个摘下并触发pending中的定时器
+        // 先摘下所有到期的定时器再触发 , 回调中新调度的定时器不会在本轮被误触发
+        template<typename Function>
+        size_type fire(node_type *pending, Function &on_expire) {
+            size_type fired = 0;
+            while (pending->next != pending) {
+                node_type *node = pending->next;
+                unlink(node);
+                ++fired;
+                on_expire(*hook_owner(node, Hook));
+            }
+            return fired;
+        }
+
+        // cur跨过槽边界后 , 将cur所在的高层槽中的定时器级联到低层
+        void cascade() {
+            for (int k = 1; k < level_count; ++k) {
+                int slot = int(cur >> (k * slot_bit)) & (slot_count - 1);
+                node_type moved;
+                moved.next = moved.prev = &moved;
+                splice_slot(k, slot, &moved);
+                for (node_type *node = moved.next, *nxt; node != &moved; node = nxt) {
+                    nxt = node->next;
+                    place(node, node->expire);
+                }
+                if (slot != 0) break;
+            }
+        }
+
+        // cur移到已处理的tick之后 , tick为最大值时不回绕
+        void pass(time_type tick) {
+            cur = tick == ~time_type(0) ? tick : tick + 1;
+        }
+
+        // 推进cur , 将[旧cur, 新cur)内到期的定时器摘到pending上 , 返回是否已经处理到now
+        bool collect(time_type now, node_type *pending) {
+            if (occupied[0] != 0) {
+                // 第0层的定时器都位于cur所在的64个tick内
+                time_type block_end = cur | (slot_count - 1);
+                time_type stop = now < block_end ? now : block_end;
+                int lo = int(cur & (slot_count - 1)), hi = int(stop & (slot_count - 1));
+                uint64_t range = (hi == slot_count - 1 ? ~uint64_t(0) : (uint64_t(2) << hi) - 1) &
+                                 ~((uint64_t(1) << lo) - 1);
+                uint64_t mask = occupied[0] & range;
+                for (; mask; mask &= mask - 1) splice_slot(0, ttl::countr_zero(mask), pending);
+                pass(stop);
+                if (stop == block_end && cur != stop) cascade();
+                return stop == now;
+            }
+            // 第0层为空 , 跳到最低的有定时器的槽
+            for (int k = 1; k < level_count; ++k) {
+                int shift = k * slot_bit, cur_slot = int(cur >> shift) & (slot_count - 1);
+                uint64_t mask = cur_slot == slot_count - 1 ? 0 : occupied[k] & (~uint64_t(0) << (cur_slot + 1));
+                if (mask == 0) continue;
+                int upper = shift + slot_bit;
+                time_type base = upper >= 64 ? 0 : cur >> upper << upper;
+                time_type next = base | time_type(ttl::countr_zero(mask)) << shift;
+                // 在到达该槽之前就停下时 , 低层都为空 , 无需级联
+                bool reached = next > now;
+                if (reached) pass(now);
+                else cur = next;
+                if (cur == next) cascade();
+                return reached;
+            }
+            pass(now);
+            return true;
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_TIMING_WHEEL_H
@@ -0,0 +1,784 @@
+﻿#ifndef TINYSTL_UNROLLED_LIST_H
+#define TINYSTL_UNROLLED_LIST_H
+
+#include "../../allocator/memory.h"
+#include "../../iterator/iterator.h"
+#include "../../algorithm/algorithm.h"
+
+namespace ttl {
+
+    // 展开链表 , 每个结点保存至多K个连续的元素
+    // 相比于list , 遍历时的缓存命中率更高 , 定位第i个元素只需跳过整块
+    // 相比于vector , 中间插入删除只需移动一个块内的元素
+    // 迭代器失效 : 插入删除只会使同一块(及被合并的相邻块)中的迭代器失效
+    template<typename T, size_t K = (sizeof(T) < 64 ? size_t(512 / sizeof(T)) : size_t(8))>
+    class unrolled_list {
+        static_assert(K >= 2, "each chunk must hold at least 2 elements");
+    public:
+        using value_type = T;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+    private: // helper class
+#pragma region
+
+        // 块的头部 , 虚拟根节点的count始终为0
+        struct chunk_base {
+            chunk_base *next;
+            chunk_base *prev;
+            size_type count; // 块中已构造的元素个数 , [0,count)
+        };
+        struct chunk_node : chunk_base {
+            alignas(T) unsigned char storage[K * sizeof(T)];
+        };
+        // 虚拟根节点, root->next为第一个块 , root->prev为最后一个块
+        struct list_root : chunk_base {
+            size_type size;
+        };
+
+        static pointer slots(chunk_base *node) {
+            return reinterpret_cast<pointer>(static_cast<chunk_node *>(node)->storage);
+        }
+
+        // 迭代器
+        template<typename CVT>
+        class unrolled_iterator : public ttl::iterator<ttl::bidirectional_iterator_tag, CVT> {
+            friend class unrolled_list;
+
+        public:
+            using value_type = CVT;
+            using pointer = CVT *;
+            using reference = CVT &;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+        private:
+            chunk_base *node{}; // 所在的块
+            size_type idx{};    // 在块中的下标
+        public: // constructor
+            unrolled_iterator() = default;
+
+            unrolled_iterator(const unrolled_iterator &) = default;
+
+            unrolled_iterator(chunk_base *node, size_type idx) noexcept: node(node), idx(idx) {}
+
+            template<typename OV>
+            unrolled_iterator(const unrolled_iterator<OV> &oth) noexcept: // NOLINT(google-explicit-constructor)
+                    node(oth.node), idx(oth.idx) {}
+
+            unrolled_iterator &operator=(const unrolled_iterator &) = default;
+
+        public: // ops
+            reference operator*() const noexcept { return slots(node)[idx]; }
+
+            pointer operator->() const noexcept { return slots(node) + idx; }
+
+            // forward
+            unrolled_iterator &operator++() noexcept {
+                if (++idx == node->count) node = node->next, idx = 0;
+                return *this;
+            }
+
+            unrolled_iterator operator++(int) noexcept {
+                unrolled_iterator tmp = *this;
+                return ++*this, tmp;
+            }
+
+            // bi direct
+            unrolled_iterator &operator--() noexcept {
+                if (idx == 0) node = node->prev, idx = node->count;
+                return --idx, *this;
+            }
+
+            unrolled_iterator operator--(int) noexcept {
+                unrolled_iterator tmp = *this;
+                return --*this, tmp;
+            }
+
+            friend bool operator==(const unrolled_iterator &lhs, const unrolled_iterator &rhs) {
+                return lhs.node == rhs.node && lhs.idx == rhs.idx;
+            }
+
+            friend bool operator!=(const unrolled_iterator &lhs, const unrolled_iterator &rhs) {
+                return !(lhs == rhs);
+            }
+        };
+
+#pragma endregion
+    private:
+        using alloc_type = ttl::allocator<T>;
+        using chunk_alloc_type = ttl::allocator<chunk_node>;
+    private:
+        list_root root{};
+    public: // iter
+        using iterator = unrolled_iterator<value_type>;
+        using const_iterator = unrolled_iterator<const value_type>;
+        using reverse_iterator = ttl::reverse_iterator<iterator>;
+        using const_reverse_iterator = ttl::reverse_iterator<const_iterator>;
+    public: // constructor
+#pragma region
+
+        unrolled_list() { reset_root(); }
+
+        unrolled_list(size_type n, const value_type &val) : unrolled_list() {
+            insert(end(), n, val);
+        }
+
+        explicit unrolled_list(size_type n) : unrolled_list() {
+            while (n--) emplace_back();
+        }
+
+        template<typename InputIt>
+        unrolled_list(InputIt first, InputIt last) : unrolled_list() {
+            insert(end(), first, last);
+        }
+
+        unrolled_list(const unrolled_list &oth) : unrolled_list(oth.begin(), oth.end()) {}
+
+        unrolled_list(unrolled_list &&oth) noexcept {
+            take_storage(oth);
+        }
+
+        unrolled_list(std::initializer_list<value_type> init) : unrolled_list(init.begin(), init.end()) {}
+
+        ~unrolled_list() { destroy_all(); }
+
+    private:
+        // 空链表 , 根节点自环
+        void reset_root() {
+            root.next = root.prev = &root;
+            root.count = 0, root.size = 0;
+        }
+
+        // 接管oth的所有块 , 不释放自身
+        void take_storage(unrolled_list &oth) {
+            if (oth.root.next == &oth.root) return reset_root();
+            root.next = oth.root.next, root.prev = oth.root.prev;
+            root.next->prev = &root, root.prev->next = &root;
+            root.count = 0, root.size = oth.root.size;
+            oth.reset_root();
+        }
+
+        // 销毁所有元素并释放所有块
+        void destroy_all() {
+            for (chunk_base *cur = root.next, *nxt; cur != &root; cur = nxt) {
+                nxt = cur->next;
+                ttl::destroy(slots(cur), slots(cur) + cur->count);
+                chunk_alloc_type::deallocate(static_cast<chunk_node *>(cur), 1);
+            }
+            reset_root();
+        }
+
+#pragma endregion
+    public: // assign
+#pragma region
+
+        unrolled_list &operator=(const unrolled_list &oth) {
+            if (&oth != this) assign(oth.begin(), oth.end());
+            return *this;
+        }
+
+        unrolled_list &operator=(unrolled_list &&oth) noexcept {
+            if (&oth != this) destroy_all(), take_storage(oth);
+            return *this;
+        }
+
+        unrolled_list &operator=(std::initializer_list<value_type> init) {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        void assign(size_type n, const value_type &value) {
+            clear(), insert(end(), n, value);
+        }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last) {
+            clear(), insert(end(), first, last);
+        }
+
+        void assign(std::initializer_list<value_type> init) {
+            assign(init.begin(), init.end());
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        reference front() { return *begin(); }
+
+        const_reference front() const { return *begin(); }
+
+        reference back() { return *--end(); }
+
+        const_reference back() const { return *--end(); }
+
+        reference at(size_type i) {
+            if (i >= size()) throw std::out_of_range("unrolled_list at");
+            return *nth(i);
+        }
+
+        const_reference at(size_type i) const {
+            if (i >= size()) throw std::out_of_range("unrolled_list at");
+            return *nth(i);
+        }
+
+        // 获取第i个元素的迭代器 , 按块跳跃 , O(n/K)
+        iterator nth(size_type i) const {
+            if (i >= size()) return end();
+            if (i < size() / 2) {
+                chunk_base *cur = root.next;
+                while (i >= cur->count) i -= cur->count, cur = cur->next;
+                return iterator(cur, i);
+            } else {
+                chunk_base *cur = root.prev;
+                size_type back = size() - i; // 从后往前数第back个 , back>=1
+                while (back > cur->count) back -= cur->count, cur = cur->prev;
+                return iterator(cur, cur->count - back);
+            }
+        }
+
+#pragma endregion
+    public: // iterator
+#pragma region
+
+        iterator begin() const { return iterator(root.next, 0); }
+
+        iterator end() const { return iterator(const_cast<list_root *>(&root), 0); }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+        reverse_iterator rbegin() const { return reverse_iterator(end()); }
+
+        reverse_iterator rend() const { return reverse_iterator(begin()); }
+
+        const_reverse_iterator crbegin() const { return const_reverse_iterator(cend()); }
+
+        const_reverse_iterator crend() const { return const_reverse_iterator(cbegin()); }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return root.size == 0; }
+
+        size_type size() const { return root.size; }
+
+        static size_type max_size() {
+            return alloc_type::max_size();
+        }
+
+        // 每个块的容量
+        static constexpr size_type chunk_capacity() { return K; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        void clear() { destroy_all(); }
+
+        iterator insert(const_iterator pos, const value_type &val) {
+            return emplace(pos, val);
+        }
+
+        iterator insert(const_iterator pos, value_type &&val) {
+            return emplace(pos, std::move(val));
+        }
+
+        iterator insert(const_iterator pos, size_type n, const value_type &val) {
+            if (n == 0) return iterator(pos);
+            iterator cur = emplace(pos, val);
+            for (size_type i = 1; i < n; ++i) cur = emplace(++cur, val);
+            // 后续插入可能拆分块 , 从最后一个插入位置回退
+            return ttl::prev(cur, difference_type(n - 1));
+        }
+
+        template<class InputIt>
+        iterator insert(const_iterator pos, InputIt first, InputIt last) {
+            if (first == last) return iterator(pos);
+            size_type n = 1;
+            iterator cur = emplace(pos, *first++);
+            while (first != last) cur = emplace(++cur, *first++), ++n;
+            return ttl::prev(cur, difference_type(n - 1));
+        }
+
+        iterator insert(const_iterator pos, std::initializer_list<T> init) {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        template<typename ...Args>
+        iterator emplace(const_iterator pos, Args &&...args) {
+            // 先构造出对象, 避免args引用了将被移动的元素
+            value_type value(std::forward<Args>(args)...);
+            iterator it = make_gap(pos);
+            alloc_type::construct(slots(it.node) + it.idx, std::move(value));
+            return it;
+        }
+
+        iterator erase(const_iterator pos) {
+            chunk_base *node = pos.node;
+            size_type idx = pos.idx;
+            pointer p = slots(node);
+            ttl::move(p + idx + 1, p + node->count, p + idx);
+            alloc_type::destroy(p + --node->count);
+            --root.size;
+            if (node->count == 0) {
+                chunk_base *nxt = node->next;
+                free_chunk(node);
+                return iterator(nxt, 0);
+            }
+            iterator ret = normalize(node, idx);
+            balance(node, ret);
+            return ret;
+        }
+
+        iterator erase(const_iterator first, const_iterator last) {
+            if (first == last) return iterator(last);
+            chunk_base *node = first.node, *head = nullptr;
+            size_type idx = first.idx;
+            // 删除[first, last.node)中的元素 , 中间的块整体释放
+            while (node != last.node) {
+                chunk_base *nxt = node->next;
+                ttl::destroy(slots(node) + idx, slots(node) + node->count);
+                root.size -= node->count - idx, node->count = idx;
+                if (idx == 0) free_chunk(node);
+                else head = node;
+                node = nxt, idx = 0;
+            }
+            // 删除last所在块中的[idx, last.idx)
+            size_type n = last.idx - idx;
+            if (n) {
+                pointer p = slots(node);
+                ttl::move(p + last.idx, p + node->count, p + idx);
+                ttl::destroy(p + node->count - n, p + node->count);
+                node->count -= n, root.size -= n;
+            }
+            iterator ret = normalize(node, idx);
+            if (node != &root) balance(node, ret);
+            if (head) balance(head, ret);
+            return ret;
+        }
+
+        template<typename ...Args>
+        reference emplace_back(Args &&...args) {
+            return *emplace(cend(), std::forward<Args>(args)...);
+        }
+
+        void push_back(const value_type &val) {
+            emplace_back(val);
+        }
+
+        void push_back(value_type &&val) {
+            emplace_back(std::move(val));
+        }
+
+        void pop_back() {
+            erase(--cend());
+        }
+
+        template<typename ...Args>
+        reference emplace_front(Args &&...args) {
+            return *emplace(cbegin(), std::forward<Args>(args)...);
+        }
+
+        void push_front(const value_type &val) {
+            emplace_front(val);
+        }
+
+        void push_front(value_type &&val) {
+            emplace_front(std::move(val));
+        }
+
+        void pop_front() {
+            erase(cbegin());
+        }
+
+        void resize(size_type n) {
+            if (n < size()) erase(nth(n), end());
+            else while (size() < n) emplace_back();
+        }
+
+        void resize(size_type n, const value_type &x) {
+            if (n < size()) erase(nth(n), end());
+            else insert(end(), n - size(), x);
+        }
+
+        void swap(unrolled_list &oth) {
+            unrolled_list tmp(std::move(oth));
+            oth.take_storage(*this), take_storage(tmp);
+        }
+
+#pragma endregion
+    private: // help change
+#pragma region
+
+        // 申请一个空块并链接到pos之前
+        static chunk_base *new_chunk_before(chunk_base *pos) {
+            chunk_base *node = chunk_alloc_type::allocate(1);
+            node->count = 0;
+            node->prev = pos->prev, node->next = pos;
+            pos->prev->next = node, pos->prev = node;
+            return node;
+        }
+
+        // 摘下并释放一个块 , 不析构元素
+        static void free_chunk(chunk_base *node) {
+            node->prev->next = node->next, node->next->prev = node->prev;
+            chunk_alloc_type::deallocate(static_cast<chunk_node *>(node), 1);
+        }
+
+        // 将src[s, s+n)移动到未初始化的dst[d, d+n) , 并析构src中的原对象 , 不修改count
+        static void relocate(chunk_base *src, size_type s, size_type n, chunk_base *dst, size_type d) {
+            pointer from = slots(src) + s;
+            ttl::uninitialized_move_n(from, n, slots(dst) + d);
+            ttl::destroy(from, from + n);
+        }
+
+        // (node, idx)若处于块尾 , 则规范为下一个块的开头
+        iterator normalize(chunk_base *node, size_type idx) const {
+            if (node != &root && idx == node->count) return iterator(node->next, 0);
+            return iterator(node, idx);
+        }
+
+        // 在pos处腾出一个未初始化的位置 , 必要时拆分满块
+        iterator make_gap(const_iterator pos) {
+            chunk_base *node = pos.node;
+            size_type idx = pos.idx;
+            if (idx == 0 && node->prev != &root && node->prev->count < K) {
+                // 前一个块有空余 , 直接追加到其末尾 , 无需移动
+                node = node->prev, idx = node->count;
+            } else if (node == &root) {
+                node = new_chunk_before(&root), idx = 0;
+            } else if (node->count == K) {
+                // 满块从中间拆分
+                chunk_base *half = new_chunk_before(node->next);
+                const size_type keep = K / 2;
+                relocate(node, keep, K - keep, half, 0);
+                node->count = keep, half->count = K - keep;
+                if (idx > keep) node = half, idx -= keep;
+            }
+            // [idx, count) => [idx+1, count+1) , 只在块尾构造 , 中间移动赋值
+            pointer p = slots(node);
+            size_type cnt = node->count;
+            if (idx < cnt) {
+                alloc_type::construct(p + cnt, std::move(p[cnt - 1]));
+                ttl::move_backward(p + idx, p + cnt - 1, p + cnt);
+                alloc_type::destroy(p + idx);
+            }
+            ++node->count, ++root.size;
+            return iterator(node, idx);
+        }
+
+        // 将src整体追加到dst末尾并释放src , 指向src的迭代器it会被修正
+        static void absorb(chunk_base *dst, chunk_base *src, iterator &it) {
+            size_type offset = dst->count;
+            relocate(src, 0, src->count, dst, offset);
+            dst->count += src->count;
+            if (it.node == src) it = iterator(dst, it.idx + offset);
+            free_chunk(src);
+        }
+
+        // 若node中的元素少于一半 , 尝试与相邻的块合并
+        void balance(chunk_base *node, iterator &it) {
+            if (node->count >= K / 2) return;
+            chunk_base *pre = node->prev, *nxt = node->next;
+            if (pre != &root && pre->count + node->count <= K) {
+                absorb(pre, node, it);
+            } else if (nxt != &root && node->count + nxt->count <= K) {
+                absorb(node, nxt, it);
+            }
+        }
+
+        // 若node与下一个块能放入一个块中 , 则合并
+        void merge_next(chunk_base *node) {
+            iterator unused;
+            chunk_base *nxt = node->next;
+            if (node != &root && nxt != &root && node->count + nxt->count <= K) {
+                absorb(node, nxt, unused);
+            }
+        }
+
+        // 从at处把所在块一分为二 , 返回以at开头的块 , a和b若位于被移走的部分会被修正
+        chunk_base *split_at(const_iterator at, const_iterator &a, const_iterator &b) {
+            chunk_base *node = at.node;
+            if (at.idx == 0) return node;
+            chunk_base *tail = new_chunk_before(node->next);
+            size_type m = node->count - at.idx;
+            relocate(node, at.idx, m, tail, 0);
+            node->count = at.idx, tail->count = m;
+            for (const_iterator *x: {&a, &b}) {
+                if (x->node == node && x->idx >= at.idx) *x = const_iterator(tail, x->idx - at.idx);
+            }
+            return tail;
+        }
+
+        // 合并所有相邻且能放入一个块中的块
+        void compact() {
+            for (chunk_base *cur = root.next; cur != &root; cur = cur->next) {
+                while (cur->next != &root && cur->count + cur->next->count <= K) merge_next(cur);
+            }
+        }
+
+        // 以nullptr结尾的一段块 , 除first外prev均有效
+        struct chain {
+            chunk_base *first;
+            chunk_base *last;
+        };
+
+        // 摘下所有块(链表不能为空) , 链表变为空
+        chain detach_chain() {
+            chain ret{root.next, root.prev};
+            ret.last->next = nullptr;
+            reset_root();
+            return ret;
+        }
+
+        // 将块接回(此时链表必须为空) , 不修改size
+        void attach_chain(chain c) {
+            root.next = c.first, c.first->prev = &root;
+            root.prev = c.last, c.last->next = &root;
+        }
+
+        // 合并两个有序段 , 相等时a在前
+        // 元素逐个移动到新申请的满块中 , 取空的块立即释放 , 一方取完后另一方剩下的整块直接链接
+        template<typename Compare>
+        static chain merge_chain(chain a, chain b, Compare &compare) {
+            chain ret{};
+            chunk_base *x = a.first, *y = b.first, *dst = nullptr;
+            size_type i = 0, j = 0;
+            auto put = [&ret, &dst](chunk_base *src, size_type k) {
+                if (!dst || dst->count == K) {
+                    chunk_base *node = chunk_alloc_type::allocate(1);
+                    node->count = 0, node->next = nullptr, node->prev = dst;
+                    (dst ? dst->next : ret.first) = node;
+                    dst = node;
+                }
+                relocate(src, k, 1, dst, dst->count);
+                ++dst->count;
+            };
+            // 取出src中的第k个元素后 , src若已取空则释放并前进到下一个块
+            auto advance = [](chunk_base *&src, size_type &k) {
+                if (++k < src->count) return;
+                chunk_base *nxt = src->next;
+                chunk_alloc_type::deallocate(static_cast<chunk_node *>(src), 1);
+                src = nxt, k = 0;
+            };
+            while (x && y) {
+                if (compare(slots(y)[j], slots(x)[i])) put(y, j), advance(y, j);
+                else put(x, i), advance(x, i);
+            }
+            chunk_base *rest = x ? x : y;
+            size_type k = x ? i : j;
+            // 剩余部分所在的块已被取走一部分 , 把它剩下的元素移过来
+            while (rest && k != 0) put(rest, k), advance(rest, k);
+            if (!rest) return ret.last = dst, ret;
+            rest->prev = dst;
+            (dst ? dst->next : ret.first) = rest;
+            ret.last = x ? a.last : b.last;
+            return ret;
+        }
+
+#pragma endregion
+    public: // else operator
+#pragma region
+
+        // 从oth中移动[first, last)到pos的前面
+        // 完整的块直接重新链接 , 只有边界上的两个块需要移动元素
+        void splice(const_iterator pos, unrolled_list &&oth) {
+            splice(pos, oth, oth.cbegin(), oth.cend());
+        }
+
+        void splice(const_iterator pos, unrolled_list &oth) {
+            splice(pos, oth, oth.cbegin(), oth.cend());
+        }
+
+        void splice(const_iterator pos, unrolled_list &&oth, const_iterator first) {
+            splice(pos, oth, first, ttl::next(first));
+        }
+
+        void splice(const_iterator pos, unrolled_list &oth, const_iterator first) {
+            splice(pos, oth, first, ttl::next(first));
+        }
+
+        void splice(const_iterator pos, unrolled_list &&oth, const_iterator first, const_iterator last) {
+            splice(pos, oth, first, last);
+        }
+
+        void splice(const_iterator pos, unrolled_list &oth, const_iterator first, const_iterator last) {
+            if (first == last) return;
+            // 使[first, last)和pos都位于块的边界上
+            chunk_base *first_node = oth.split_at(first, pos, last);
+            chunk_base *last_node = oth.split_at(last, pos, first);
+            chunk_base *pos_node = split_at(pos, first, last);
+            chunk_base *back_node = last_node->prev;
+            if (pos_node == first_node || pos_node == last_node) return; // 自身移动到原位置
+            size_type n = 0;
+            for (chunk_base *cur = first_node; cur != last_node; cur = cur->next) n += cur->count;
+            // 从oth中摘下[first_node, back_node]
+            chunk_base *before = first_node->prev;
+            before->next = last_node, last_node->prev = before;
+            oth.root.size -= n;
+            // 链接到pos_node之前
+            first_node->prev = pos_node->prev, back_node->next = pos_node;
+            pos_node->prev->next = first_node, pos_node->prev = back_node;
+            root.size += n;
+            // 拆分出的块可能过小
+            merge_next(back_node);
+            merge_next(first_node->prev);
+            oth.merge_next(before);
+        }
+
+        // 合并两个有序列表 , 将oth中的元素移动到*this中(不检查有序) , 相等元素*this中的在前(稳定)
+        // 一方取完后另一方剩下的整块直接重新链接 , 其余元素移动到新的满块中
+        void merge(unrolled_list &&oth) {
+            merge(oth, std::less<>());
+        }
+
+        void merge(unrolled_list &oth) {
+            merge(oth, std::less<>());
+        }
+
+        template<typename Compare>
+        void merge(unrolled_list &&oth, Compare compare) {
+            merge(oth, compare);
+        }
+
+        template<typename Compare>
+        void merge(unrolled_list &oth, Compare compare) {
+            if (&oth == this || oth.empty()) return;
+            if (empty()) return take_storage(oth);
+            size_type n = size() + oth.size();
+            attach_chain(merge_chain(detach_chain(), oth.detach_chain(), compare));
+            root.size = n;
+        }
+
+        // 原地排序
+        void sort() {
+            sort(std::less<>());
+        }
+
+        // 先对每个块内的元素稳定排序作为初始段 , 再像list::sort一样自底向上归并 , 稳定
+        // 归并时元素被移动到新的满块中 , 排序后除最后一块外都是满块
+        template<typename Compare>
+        void sort(Compare compare) {
+            if (size() <= 1) return;
+            size_type n = size();
+            // bins[i]为空或者由2^i个初始段合并而成的有序段 , i越大的段中元素越靠前
+            chain bins[64]{};
+            size_type fill = 0;
+            for (chunk_base *cur = detach_chain().first; cur;) {
+                chain run{cur, cur};
+                cur = cur->next, run.last->next = nullptr;
+                ttl::stable_sort(slots(run.first), slots(run.first) + run.first->count, compare);
+                size_type i = 0;
+                for (; i < fill && bins[i].first; ++i) {
+                    run = merge_chain(bins[i], run, compare), bins[i] = {};
+                }
+                bins[i] = run;
+                if (i == fill) ++fill;
+            }
+            chain ret{};
+            for (size_type i = 0; i < fill; ++i) {
+                if (bins[i].first) ret = ret.first ? merge_chain(bins[i], ret, compare) : bins[i];
+            }
+            attach_chain(ret);
+            root.size = n;
+        }
+
+        size_type remove(const T &value) {
+            return remove_if([&](const T &x) { return x == value; });
+        }
+
+        // 每个块内原地压缩 , 最后合并过小的块 , 只需一遍扫描
+        template<class UnaryPredicate>
+        size_type remove_if(UnaryPredicate predicate) {
+            size_type ret = 0;
+            for (chunk_base *cur = root.next, *nxt; cur != &root; cur = nxt) {
+                nxt = cur->next;
+                pointer p = slots(cur);
+                size_type keep = 0;
+                for (size_type i = 0; i < cur->count; ++i) {
+                    if (predicate(p[i])) continue;
+                    if (keep != i) p[keep] = std::move(p[i]);
+                    ++keep;
+                }
+                ttl::destroy(p + keep, p + cur->count);
+                ret += cur->count - keep, cur->count = keep;
+                if (keep == 0) free_chunk(cur);
+            }
+            root.size -= ret;
+            return compact(), ret;
+        }
+
+        // 反转块的链接顺序 , 再反转每个块内的元素
+        void reverse() {
+            for (chunk_base *cur = root.next; cur != &root; cur = cur->prev) {
+                std::swap(cur->next, cur->prev);
+                pointer p = slots(cur);
+                for (size_type i = 0, j = cur->count; i + 1 < j; ++i, --j) std::swap(p[i], p[j - 1]);
+            }
+            std::swap(root.next, root.prev);
+        }
+
+        size_type unique() {
+            return unique(std::equal_to<>());
+        }
+
+        template<class BinaryPredicate>
+        size_type unique(BinaryPredicate predicate) {
+            size_type ret = 0;
+            pointer last_kept = nullptr;
+            for (chunk_base *cur = root.next, *nxt; cur != &root; cur = nxt) {
+                nxt = cur->next;
+                pointer p = slots(cur);
+                size_type keep = 0;
+                for (size_type i = 0; i < cur->count; ++i) {
+                    if (last_kept && predicate(*last_kept, p[i])) continue;
+                    if (keep != i) p[keep] = std::move(p[i]);
+                    last_kept = p + keep++;
+                }
+                ttl::destroy(p + keep, p + cur->count);
+                ret += cur->count - keep, cur->count = keep;
+                if (keep == 0) free_chunk(cur);
+            }
+            root.size -= ret;
+            return compact(), ret;
+        }
+
+#pragma endregion
+    public: // operators
+#pragma region
+
+        friend bool operator==(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return lhs.size() == rhs.size() && ttl::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+
+        friend bool operator!=(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return !(rhs == lhs);
+        }
+
+        friend bool operator<(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return ttl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator>(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const unrolled_list &lhs, const unrolled_list &rhs) {
+            return !(lhs < rhs);
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_UNROLLED_LIST_H
@@ -0,0 +1,542 @@
+﻿#ifndef TINYSTL_FORWARD_LIST_H
+#define TINYSTL_FORWARD_LIST_H
+
+#include "../allocator/memory.h"
+#include "../iterator/iterator.h"
+#include "../algorithm/algorithm.h"
+
+namespace ttl {
+    // 单向链表 , 每个结点只有一个next指针
+    // 头结点内嵌在容器中且没有尾哨兵 , end()为nullptr , 因此sizeof(forward_list) == sizeof(void*)
+    // 结点较小且频繁分配时可以使用ttl::pool_allocator
+    template<typename T, typename Alloc = ttl::allocator<T>>
+    class forward_list {
+    public:
+        using value_type = T;
+        using allocator_type = Alloc;
+        using pointer = T *;
+        using const_pointer = const T *;
+        using reference = T &;
+        using const_reference = const T &;
+        using size_type = size_t;
+        using difference_type = ptrdiff_t;
+    private: // helper class
+#pragma region
+        // 数据结点
+        struct forward_list_base_node {
+            forward_list_base_node *next;
+        };
+        struct forward_list_node : forward_list_base_node {
+            T data;
+        };
+
+        // 迭代器
+        template<typename CVT>
+        class forward_list_iterator : public ttl::iterator<ttl::forward_iterator_tag, CVT> {
+            friend class forward_list;
+
+            using Iterator = forward_list_base_node *;
+        public:
+            using value_type = CVT;
+            using pointer = CVT *;
+            using reference = CVT &;
+            using size_type = size_t;
+            using difference_type = ptrdiff_t;
+        private:
+            Iterator current{};
+        public: // constructor
+            forward_list_iterator() = default;
+
+            forward_list_iterator(const forward_list_iterator &) = default;
+
+            explicit forward_list_iterator(const Iterator &it) noexcept: current(it) {}
+
+            template<typename OV>
+            forward_list_iterator(const forward_list_iterator<OV> oth) noexcept: // NOLINT(google-explicit-constructor)
+                    current(oth.current) {}
+
+            forward_list_iterator &operator=(const forward_list_iterator &) = default;
+
+        public: // ops
+            reference operator*() const noexcept { return value_of(current); }
+
+            pointer operator->() const noexcept { return alloc_type::address(value_of(current)); }
+
+            forward_list_iterator &operator++() noexcept {
+                return current = current->next, *this;
+            }
+
+            forward_list_iterator operator++(int) noexcept {
+                forward_list_iterator tmp = *this;
+                return ++*this, tmp;
+            }
+
+            friend bool operator==(const forward_list_iterator &lhs, const forward_list_iterator &rhs) {
+                return lhs.current == rhs.current;
+            }
+
+            friend bool operator!=(const forward_list_iterator &lhs, const forward_list_iterator &rhs) {
+                return !(lhs.current == rhs.current);
+            }
+        };
+
+#pragma endregion
+    private:
+        using base_node = forward_list_base_node;
+        using alloc_type = typename Alloc::template rebind<T>::other;
+        using node_alloc_type = typename Alloc::template rebind<forward_list_node>::other;
+    private:
+        base_node head{}; // 虚拟头结点 , head.next为第一个元素
+    public: // iter
+        using iterator = forward_list_iterator<value_type>;
+        using const_iterator = forward_list_iterator<const value_type>;
+    public: // constructor
+#pragma region
+
+        forward_list() = default;
+
+        explicit forward_list(size_type n) {
+            for (base_node *cur = &head; n--; cur = cur->next) link_after(cur, make_node_aux());
+        }
+
+        forward_list(size_type n, const value_type &val) {
+            insert_after(cbefore_begin(), n, val);
+        }
+
+        template<typename InputIt>
+        forward_list(InputIt first, InputIt last) {
+            insert_after(cbefore_begin(), first, last);
+        }
+
+        forward_list(const forward_list &oth) : forward_list(oth.begin(), oth.end()) {}
+
+        // 没有尾哨兵 , 移动只需要转移头指针
+        forward_list(forward_list &&oth) noexcept: head(oth.head) {
+            oth.head.next = nullptr;
+        }
+
+        forward_list(std::initializer_list<value_type> init) : forward_list(init.begin(), init.end()) {}
+
+        ~forward_list() { clear(); }
+
+#pragma endregion
+    public: // assign
+#pragma region
+
+        forward_list &operator=(const forward_list &oth) {
+            if (&oth != this) assign_copy_aux(oth.begin(), oth.end());
+            return *this;
+        }
+
+        forward_list &operator=(forward_list &&oth) noexcept {
+            if (&oth == this) return *this;
+            clear(), head.next = oth.head.next, oth.head.next = nullptr;
+            return *this;
+        }
+
+        forward_list &operator=(std::initializer_list<value_type> init) {
+            assign_copy_aux(init.begin(), init.end());
+            return *this;
+        }
+
+        void assign(size_type n, const value_type &val) {
+            base_node *pre = &head;
+            for (; pre->next && n; pre = pre->next, --n) value_of(pre->next) = val;
+            if (n) insert_after(const_iterator(pre), n, val);
+            else erase_after(const_iterator(pre), cend());
+        }
+
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last) {
+            assign_copy_aux(first, last);
+        }
+
+        void assign(std::initializer_list<value_type> init) {
+            assign_copy_aux(init.begin(), init.end());
+        }
+
+    private:
+        // 复用已有结点 , 多余的删除 , 不足的补充
+        template<typename InputIt>
+        void assign_copy_aux(InputIt first, InputIt last) {
+            base_node *pre = &head;
+            for (; pre->next && first != last; pre = pre->next, ++first) value_of(pre->next) = *first;
+            if (first != last) insert_after(const_iterator(pre), first, last);
+            else erase_after(const_iterator(pre), cend());
+        }
+
+#pragma endregion
+    public: // visit
+#pragma region
+
+        reference front() { return value_of(head.next); }
+
+        const_reference front() const { return value_of(head.next); }
+
+#pragma endregion
+    public: // iterator
+#pragma region
+
+        iterator before_begin() const { return iterator(const_cast<base_node *>(&head)); }
+
+        iterator begin() const { return iterator(head.next); }
+
+        iterator end() const { return iterator(nullptr); }
+
+        const_iterator cbefore_begin() const { return before_begin(); }
+
+        const_iterator cbegin() const { return begin(); }
+
+        const_iterator cend() const { return end(); }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        bool empty() const { return head.next == nullptr; }
+
+        static size_type max_size() {
+            return node_alloc_type::max_size();
+        }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        void clear() {
+            for (base_node *cur = head.next, *nxt; cur; cur = nxt) {
+                nxt = cur->next;
+                destroy_node(cur);
+            }
+            head.next = nullptr;
+        }
+
+        iterator insert_after(const_iterator pos, const value_type &val) {
+            return emplace_after(pos, val);
+        }
+
+        iterator insert_after(const_iterator pos, value_type &&val) {
+            return emplace_after(pos, std::move(val));
+        }
+
+        // 返回最后一个插入的元素 , n为0时返回pos
+        iterator insert_after(const_iterator pos, size_type n, const value_type &val) {
+            base_node *cur = pos.current;
+            while (n--) cur = link_after(cur, make_node_aux(val));
+            return iterator(cur);
+        }
+
+        template<typename InputIt>
+        iterator insert_after(const_iterator pos, InputIt first, InputIt last) {
+            base_node *cur = pos.current;
+            for (; first != last; ++first) cur = link_after(cur, make_node_aux(*first));
+            return iterator(cur);
+        }
+
+        iterator insert_after(const_iterator pos, std::initializer_list<value_type> init) {
+            return insert_after(pos, init.begin(), init.end());
+        }
+
+        template<typename ...Args>
+        iterator emplace_after(const_iterator pos, Args &&...args) {
+            return iterator(link_after(pos.current, make_node_aux(std::forward<Args>(args)...)));
+        }
+
+        // 删除pos后面的元素
+        iterator erase_after(const_iterator pos) {
+            base_node *cur = pos.current, *del = cur->next;
+            cur->next = del->next;
+            destroy_node(del);
+            return iterator(cur->next);
+        }
+
+        // 删除(first, last)
+        iterator erase_after(const_iterator first, const_iterator last) {
+            base_node *pre = first.current, *ed = last.current;
+            for (base_node *cur = pre->next, *nxt; cur != ed; cur = nxt) {
+                nxt = cur->next;
+                destroy_node(cur);
+            }
+            pre->next = ed;
+            return iterator(ed);
+        }
+
+        void push_front(const value_type &val) {
+            emplace_front(val);
+        }
+
+        void push_front(value_type &&val) {
+            emplace_front(std::move(val));
+        }
+
+        template<typename ...Args>
+        reference emplace_front(Args &&...args) {
+            return value_of(link_after(&head, make_node_aux(std::forward<Args>(args)...)));
+        }
+
+        void pop_front() {
+            erase_after(cbefore_begin());
+        }
+
+        void resize(size_type n) {
+            base_node *pre = &head;
+            for (; pre->next && n; pre = pre->next, --n);
+            if (!n) erase_after(const_iterator(pre), cend());
+            for (; n; --n) pre = link_after(pre, make_node_aux());
+        }
+
+        void resize(size_type n, const value_type &val) {
+            base_node *pre = &head;
+            for (; pre->next && n; pre = pre->next, --n);
+            if (n) insert_after(const_iterator(pre), n, val);
+            else erase_after(const_iterator(pre), cend());
+        }
+
+        void swap(forward_list &oth) noexcept {
+            std::swap(head.next, oth.head.next);
+        }
+
+#pragma endregion
+    private: // help change
+#pragma region
+
+        static reference value_of(base_node *node) {
+            return static_cast<forward_list_node *>(node)->data;
+        }
+
+        // 将node接在pos后面 , 返回node
+        static base_node *link_after(base_node *pos, base_node *node) {
+            node->next = pos->next, pos->next = node;
+            return node;
+        }
+
+        // 创建实体结点
+        template<typename ...Args>
+        static base_node *make_node_aux(Args &&...args) {
+            forward_list_node *node = node_alloc_type::allocate(1);
+            try {
+                alloc_type::construct(alloc_type::address(node->data), std::forward<Args>(args)...);
+            } catch (...) {
+                node_alloc_type::deallocate(node, 1);
+                throw;
+            }
+            node->next = nullptr;
+            return node;
+        }
+
+        // 销毁实体结点
+        static void destroy_node(base_node *node) {
+            auto *real = static_cast<forward_list_node *>(node);
+            alloc_type::destroy(alloc_type::address(real->data));
+            node_alloc_type::deallocate(real, 1);
+        }
+
+        // 合并两个有序单链表 , 相等时a在前
+        // 只在切换来源时修改next , 连续取自同一链表的结点保持原有链接
+        template<typename Compare>
+        static base_node *merge_chain(base_node *a, base_node *b, Compare &compare) {
+            base_node tmp{}, *tail = &tmp;
+            while (a && b) {
+                if (compare(value_of(b), value_of(a))) {
+                    tail->next = b;
+                    do tail = b, b = b->next; while (b && compare(value_of(b), value_of(a)));
+                } else {
+                    tail->next = a;
+                    do tail = a, a = a->next; while (a && !compare(value_of(b), value_of(a)));
+                }
+            }
+            tail->next = a ? a : b;
+            return tmp.next;
+        }
+
+#pragma endregion
+    public: // else operator
+#pragma region
+
+        // 合并两个有序列表,将oth中的节点移动到*this中(不检查有序) , 相等元素*this中的在前
+        void merge(forward_list &&oth) {
+            merge(std::move(oth), std::less<>());
+        }
+
+        void merge(forward_list &oth) {
+            merge(std::move(oth), std::less<>());
+        }
+
+        template<typename Compare>
+        void merge(forward_list &oth, Compare compare) {
+            merge(std::move(oth), compare);
+        }
+
+        template<typename Compare>
+        void merge(forward_list &&oth, Compare compare) {
+            if (&oth == this) return;
+            head.next = merge_chain(head.next, oth.head.next, compare);
+            oth.head.next = nullptr;
+        }
+
+        // 将oth的所有元素移动到pos后面
+        void splice_after(const_iterator pos, forward_list &&oth) {
+            if (oth.empty()) return;
+            base_node *first = oth.head.next, *last = first;
+            while (last->next) last = last->next;
+            oth.head.next = nullptr;
+            last->next = pos.current->next, pos.current->next = first;
+        }
+
+        void splice_after(const_iterator pos, forward_list &oth) {
+            splice_after(pos, std::move(oth));
+        }
+
+        // 将it后面的一个元素移动到pos后面
+        void splice_after(const_iterator pos, forward_list &&, const_iterator it) {
+            base_node *pre = it.current, *node = pre->next;
+            if (pos.current == pre || pos.current == node) return;
+            pre->next = node->next;
+            link_after(pos.current, node);
+        }
+
+        void splice_after(const_iterator pos, forward_list &oth, const_iterator it) {
+            splice_after(pos, std::move(oth), it);
+        }
+
+        // 将(first, last)移动到pos后面
+        void splice_after(const_iterator pos, forward_list &&, const_iterator first, const_iterator last) {
+            base_node *pre = first.current, *ed = last.current;
+            if (pre->next == ed) return;
+            base_node *tail = pre->next;
+            while (tail->next != ed) tail = tail->next;
+            tail->next = pos.current->next, pos.current->next = pre->next, pre->next = ed;
+        }
+
+        void splice_after(const_iterator pos, forward_list &oth, const_iterator first, const_iterator last) {
+            splice_after(pos, std::move(oth), first, last);
+        }
+
+        size_type remove(const T &value) {
+            return remove_if([&value](const T &x) { return x == value; });
+        }
+
+        // 单趟遍历 , 被删除的结点先摘下 , 遍历结束后统一销毁
+        // 因此value可以引用链表中的元素
+        template<class UnaryPredicate>
+        size_type remove_if(UnaryPredicate predicate) {
+            base_node *garbage = nullptr;
+            size_type ret = 0;
+            for (base_node *pre = &head, *cur; (cur = pre->next);) {
+                if (predicate(value_of(cur))) {
+                    pre->next = cur->next;
+                    cur->next = garbage, garbage = cur, ++ret;
+                } else {
+                    pre = cur;
+                }
+            }
+            for (base_node *nxt; garbage; garbage = nxt) {
+                nxt = garbage->next;
+                destroy_node(garbage);
+            }
+            return ret;
+        }
+
+        void reverse() noexcept {
+            base_node *ret = nullptr;
+            for (base_node *cur = head.next, *nxt; cur; cur = nxt) {
+                nxt = cur->next;
+                cur->next = ret, ret = cur;
+            }
+            head.next = ret;
+        }
+
+        size_type unique() {
+            return unique(std::equal_to<>());
+        }
+
+        // 每组相等元素保留第一个 , predicate(保留的元素, 当前元素)
+        template<class BinaryPredicate>
+        size_type unique(BinaryPredicate predicate) {
+            if (empty()) return 0;
+            size_type ret = 0;
+            base_node *keep = head.next;
+            for (base_node *cur = keep->next, *nxt; cur; cur = nxt) {
+                nxt = cur->next;
+                if (predicate(value_of(keep), value_of(cur))) {
+                    keep->next = nxt, destroy_node(cur), ++ret;
+                } else {
+                    keep = cur;
+                }
+            }
+            return ret;
+        }
+
+        // 原地排序
+        void sort() {
+            sort(std::less<>());
+        }
+
+        // 自底向上的归并排序 , 稳定 , 不分配内存 , 只重新链接结点
+        // 以输入中已有的非降序段(或反转后的严格降序段)为初始段
+        template<typename Compare>
+        void sort(Compare compare) {
+            if (head.next == nullptr || head.next->next == nullptr) return;
+            // bins[i]为空或者由2^i个初始段合并而成的有序段 , i越大的段中元素越靠前
+            base_node *bins[64]{};
+            size_type fill = 0;
+            for (base_node *cur = head.next, *run, *last; cur;) {
+                run = last = cur, cur = cur->next;
+                if (cur && compare(value_of(cur), value_of(run))) {
+                    for (base_node *nxt; cur && compare(value_of(cur), value_of(run)); cur = nxt) {
+                        nxt = cur->next;
+                        cur->next = run, run = cur;
+                    }
+                } else {
+                    for (; cur && !compare(value_of(cur), value_of(last)); cur = cur->next) last = cur;
+                }
+                last->next = nullptr;
+                size_type i = 0;
+                for (; i < fill && bins[i]; ++i) {
+                    run = merge_chain(bins[i], run, compare), bins[i] = nullptr;
+                }
+                bins[i] = run;
+                if (i == fill) ++fill;
+            }
+            base_node *ret = nullptr;
+            for (size_type i = 0; i < fill; ++i) {
+                if (bins[i]) ret = ret ? merge_chain(bins[i], ret, compare) : bins[i];
+            }
+            head.next = ret;
+        }
+
+#pragma endregion
+    public: // compare
+#pragma region
+
+        friend bool operator==(const forward_list &lhs, const forward_list &rhs) {
+            return ttl::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+        friend bool operator!=(const forward_list &lhs, const forward_list &rhs) {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const forward_list &lhs, const forward_list &rhs) {
+            return ttl::lexicographical_compare(
+                    lhs.begin(), lhs.end(),
+                    rhs.begin(), rhs.end());
+        }
+
+        friend bool operator>(const forward_list &lhs, const forward_list &rhs) {
+            return rhs < lhs;
+        }
+
+        friend bool operator<=(const forward_list &lhs, const forward_list &rhs) {
+            return !(rhs < lhs);
+        }
+
+        friend bool operator>=(const forward_list &lhs, const forward_list &rhs) {
+            return !(lhs < rhs);
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_FORWARD_LIST_H
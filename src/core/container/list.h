@@ -460,26 +460,27 @@ namespace ttl {
 #pragma region
 
         // 合并两个有序列表,将oth中的节点移动到*this中(不检查有序)
+        // 只重新链接结点 , 相等元素*this中的在前(稳定)
         void merge(list &&oth) {
             merge(std::move(oth), std::less<>());
         }
 
+        void merge(list &oth) {
+            merge(std::move(oth), std::less<>());
+        }
+
+        template<typename Compare>
+        void merge(list &oth, Compare compare) {
+            merge(std::move(oth), compare);
+        }
+
         template<typename Compare>
         void merge(list &&oth, Compare compare) {
-            using base_pointer = list_base_node *;
-            using node_pointer = list_node *;
-            iterator insert_it = begin(), insert_end = end();
-            iterator input_it = oth.begin(), input_end = oth.end();
-            while (input_it != input_end) {
-                if (insert_it != insert_end && compare(*insert_it, *input_it)) {
-                    ++insert_it; // 等待>=待插入节点的位置或者end
-                } else {
-                    insert_it = insert_front_aux(insert_it, (input_it++).current);
-                }
-            }
-            oth.root.next = oth.root.tail;
-            root.size += oth.root.size;
-            oth.root.size = 0;
+            if (&oth == this || oth.empty()) return;
+            size_type n = oth.size();
+            if (empty()) attach_chain(oth.detach_chain());
+            else attach_chain(merge_chain(detach_chain(), oth.detach_chain(), compare));
+            root.size += n, oth.root.size = 0;
         }
 
         // 从oth中直接移动指针节点到pos
@@ -514,53 +515,56 @@ namespace ttl {
         }
 
         size_type remove(const T &value) {
-            size_type ret = 0;
-            for (auto it = cbegin(), ed = cend(); it != ed;) {
-                if (*it == value) it = erase(it), ++ret;
-                else ++it;
-            }
-            return ret;
+            return remove_if([&value](const T &x) { return x == value; });
         }
 
+        // 单趟遍历 , 被删除的结点先摘下 , 遍历结束后统一销毁
+        // 因此value可以引用链表中的元素
         template<class UnaryPredicate>
         size_type remove_if(UnaryPredicate predicate) {
+            list_base_node *garbage = nullptr;
             size_type ret = 0;
-            for (auto it = cbegin(), ed = cend(); it != ed;) {
-                if (predicate(*it)) it = erase(it), ++ret;
-                else ++it;
+            for (list_base_node *cur = root.next, *nxt; cur != root.tail; cur = nxt) {
+                nxt = cur->next;
+                if (predicate(value_of(cur))) {
+                    hook(cur->prev, nxt);
+                    cur->next = garbage, garbage = cur, ++ret;
+                }
+            }
+            for (list_base_node *nxt; garbage; garbage = nxt) {
+                nxt = garbage->next;
+                destroy_node(garbage);
             }
             return ret;
         }
 
+        // 交换每个结点的next和prev
         void reverse() {
             if (size() <= 1) return;
-            list_base_node *cur = root.next, *nxt, *tmp;
-            root.next = root.tail;
-            while (cur != root.tail) {
-                tmp = cur->next, nxt = root.next;
-                hook(&root, cur), hook(cur, nxt), cur = tmp;
+            list_base_node *first = root.next, *last = root.tail->prev;
+            for (list_base_node *cur = first; cur != root.tail; cur = cur->prev) {
+                std::swap(cur->next, cur->prev);
             }
+            hook(&root, last), hook(first, root.tail);
         }
 
         size_type unique() {
-            if (size() <= 1) return 0;
-            size_type ret = 0;
-            for (auto it = cbegin(), ed = cend(), nxt = ttl::next(it); nxt != ed;) {
-                if (*it == *nxt) it = erase(it), ++ret;
-                else it = nxt;
-                nxt = ttl::next(it);
-            }
-            return ret;
+            return unique(std::equal_to<>());
         }
 
+        // 每组相等元素保留第一个 , predicate(保留的元素, 当前元素)
         template<class BinaryPredicate>
         size_type unique(BinaryPredicate predicate) {
             if (size() <= 1) return 0;
             size_type ret = 0;
-            for (auto it = cbegin(), ed = cend(), nxt = ttl::next(it); nxt != ed;) {
-                if (predicate(*it, *nxt)) it = erase(it), ++ret;
-                else it = nxt;
-                nxt = ttl::next(it);
+            list_base_node *keep = root.next;
+            for (list_base_node *cur = keep->next, *nxt; cur != root.tail; cur = nxt) {
+                nxt = cur->next;
+                if (predicate(value_of(keep), value_of(cur))) {
+                    hook(keep, nxt), destroy_node(cur), ++ret;
+                } else {
+                    keep = cur;
+                }
             }
             return ret;
         }
@@ -570,14 +574,81 @@ namespace ttl {
             sort(std::less<>());
         }
 
+        // 自底向上的归并排序 , 稳定 , 不分配内存 , 只重新链接结点
+        // 以输入中已有的非降序段(或反转后的严格降序段)为初始段 , 有序或逆序输入只需一趟
         template<typename Compare>
         void sort(Compare compare) {
-            if (this->size() <= 1) return;
-            list half;
-            half.splice(half.cend(), *this, at(size() / 2), end());
-            this->sort();
-            half.sort();
-            this->merge(std::move(half), compare);
+            if (size() <= 1) return;
+            // bins[i]为空或者由2^i个初始段合并而成的有序段 , i越大的段中元素越靠前
+            chain bins[64]{};
+            size_type fill = 0;
+            for (list_base_node *cur = detach_chain().first; cur;) {
+                chain run{cur, cur};
+                cur = cur->next;
+                if (cur && compare(value_of(cur), value_of(run.first))) {
+                    // 严格降序段 , 反转后作为初始段
+                    for (list_base_node *nxt; cur && compare(value_of(cur), value_of(run.first)); cur = nxt) {
+                        nxt = cur->next;
+                        hook(cur, run.first), run.first = cur;
+                    }
+                } else {
+                    for (; cur && !compare(value_of(cur), value_of(run.last)); cur = cur->next) run.last = cur;
+                }
+                run.last->next = nullptr;
+                size_type i = 0;
+                for (; i < fill && bins[i].first; ++i) {
+                    run = merge_chain(bins[i], run, compare), bins[i] = {};
+                }
+                bins[i] = run;
+                if (i == fill) ++fill;
+            }
+            chain ret{};
+            for (size_type i = 0; i < fill; ++i) {
+                if (bins[i].first) ret = ret.first ? merge_chain(bins[i], ret, compare) : bins[i];
+            }
+            attach_chain(ret);
+        }
+
+    private:
+        // 以nullptr结尾的一段结点 , 除first外prev均有效
+        struct chain {
+            list_base_node *first;
+            list_base_node *last;
+        };
+
+        static reference value_of(list_base_node *node) {
+            return reinterpret_cast<list_node *>(node)->data;
+        }
+
+        // 摘下所有结点(链表不能为空) , 不修改size
+        chain detach_chain() {
+            chain ret{root.next, root.tail->prev};
+            ret.last->next = nullptr;
+            hook(&root, root.tail);
+            return ret;
+        }
+
+        // 将结点接回(此时链表必须为空)
+        void attach_chain(chain c) {
+            hook(&root, c.first), hook(c.last, root.tail);
+        }
+
+        // 合并两个有序段 , 相等时a在前
+        // 只在切换来源时修改链接 , 连续取自同一段的结点保持原有的next和prev
+        template<typename Compare>
+        static chain merge_chain(chain a, chain b, Compare &compare) {
+            list_base_node head{}, *tail = &head, *x = a.first, *y = b.first;
+            while (x && y) {
+                if (compare(value_of(y), value_of(x))) {
+                    hook(tail, y);
+                    do tail = y, y = y->next; while (y && compare(value_of(y), value_of(x)));
+                } else {
+                    hook(tail, x);
+                    do tail = x, x = x->next; while (x && !compare(value_of(y), value_of(x)));
+                }
+            }
+            hook(tail, x ? x : y);
+            return {head.next, x ? a.last : b.last};
         }
 
 #pragma endregion
@@ -45,8 +45,8 @@ namespace ttl {
         class hashtable_iterator : public ttl::iterator<ttl::forward_iterator_tag, CVT> {
             friend class hashtable;
 
-            bucket_node *cur; // 迭代器当前位置
-            hashtable *table; // 所属的容器
+            bucket_node *cur;         // 迭代器当前位置
+            const hashtable *table;   // 所属的容器
         public:
             using value_type = CVT;
             using pointer = CVT *;
@@ -54,7 +54,7 @@ namespace ttl {
             using size_type = size_t;
             using difference_type = ptrdiff_t;
         private:
-            hashtable_iterator(bucket_node *node, hashtable *belong) : cur(node), table(belong) {}
+            hashtable_iterator(bucket_node *node, const hashtable *belong) : cur(node), table(belong) {}
 
         public: // constructor
             hashtable_iterator() = default;
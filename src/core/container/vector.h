@@ -335,7 +335,7 @@ namespace ttl {
             size_t n = lhs.size();
             if (n != rhs.size()) return false;
             if (&lhs == &rhs || lhs.start == rhs.start) return true;
-            for (int i = 0; i < n; ++i) if (lhs[i] != rhs[i]) return false;
+            for (size_t i = 0; i < n; ++i) if (lhs[i] != rhs[i]) return false;
             return true;
         }
 
@@ -0,0 +1,57 @@
+﻿#ifndef TINYSTL_EVENTCOUNT_H
+#define TINYSTL_EVENTCOUNT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace ttl {
+
+    // 事件计数 , 让等待某个条件的线程睡眠 , 没有等待者时通知只是一次原子读
+    // 等待方 :
+    //     auto key = ec.prepare_wait();
+    //     if (条件成立) ec.cancel_wait();
+    //     else ec.commit_wait(key);
+    // 通知方先使条件成立 , 再调用notify
+    // prepare_wait之后发生的通知都会使commit_wait返回 , 因此不会丢失唤醒
+    class eventcount {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<uint32_t> waiters{0};
+        std::mutex mtx;
+        std::condition_variable cv;
+    public:
+        uint64_t prepare_wait() {
+            waiters.fetch_add(1, std::memory_order_seq_cst);
+            return epoch.load(std::memory_order_seq_cst);
+        }
+
+        void cancel_wait() {
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void commit_wait(uint64_t key) {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this, key] { return epoch.load(std::memory_order_relaxed) != key; });
+            waiters.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        void notify_one() { notify(false); }
+
+        void notify_all() { notify(true); }
+
+    private:
+        void notify(bool all) {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (waiters.load(std::memory_order_relaxed) == 0) return;
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                epoch.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (all) cv.notify_all();
+            else cv.notify_one();
+        }
+    };
+}
+
+#endif //TINYSTL_EVENTCOUNT_H
@@ -0,0 +1,430 @@
+﻿#ifndef TINYSTL_THREAD_POOL_H
+#define TINYSTL_THREAD_POOL_H
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+#include "eventcount.h"
+#include "work_stealing_deque.h"
+#include "../container/deque.h"
+
+namespace ttl {
+
+    class thread_pool;
+
+    template<typename R>
+    class task_future;
+
+    class task_group;
+
+    namespace detail {
+        // 任务基类 , 每个任务单独分配 , 执行后由引用计数释放
+        // submit的任务同时作为future的共享状态 , 引用计数为2
+        struct pool_task {
+            std::atomic<int> refs{1};
+
+            virtual void run() = 0;
+
+            virtual ~pool_task() = default;
+
+            void release() {
+                if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+            }
+        };
+
+        template<typename Function>
+        struct pool_function_task final : pool_task {
+            Function f;
+
+            explicit pool_function_task(Function &&fn) : f(std::move(fn)) {}
+
+            void run() override { f(); }
+        };
+
+        template<typename Function>
+        pool_task *make_pool_task(Function &&f) {
+            return new pool_function_task<std::decay_t<Function>>(std::forward<Function>(f));
+        }
+    }
+
+    // 工作窃取线程池
+    // 每个工作线程有一个Chase-Lev双端队列 , 在底部压入与弹出自己产生的任务 , 空闲时随机选择其他线程从顶部窃取
+    // 外部线程提交的任务进入一个加锁的共享队列 , 工作线程在自己的队列为空时取用
+    // 空闲的工作线程在eventcount上睡眠 , 只有存在睡眠线程时提交任务才需要加锁唤醒
+    // 工作线程中等待(sync , get , parallel_for)时会执行其他任务而不是阻塞 , 因此嵌套并行不会死锁
+    class thread_pool {
+        friend class task_group;
+
+        template<typename R>
+        friend class task_future;
+
+        struct alignas(64) worker {
+            work_stealing_deque<detail::pool_task *> tasks;
+            uint64_t rng;
+        };
+
+        std::vector<std::unique_ptr<worker>> workers;
+        std::vector<std::thread> threads;
+        ttl::deque<detail::pool_task *> injected; // 外部线程提交的任务
+        std::mutex injected_mtx;
+        std::atomic<size_t> injected_count{0};
+        eventcount work_available;                // 工作线程在此睡眠
+        eventcount work_done;                     // 外部线程等待任务组或future完成时在此睡眠
+        std::atomic<bool> stopping{false};
+        std::exception_ptr unhandled;             // execute提交的任务抛出的第一个异常
+        std::mutex unhandled_mtx;
+
+        static inline thread_local thread_pool *current = nullptr; // 当前线程所属的线程池
+        static inline thread_local size_t current_index = 0;       // 当前线程在所属线程池中的下标
+    public: // constructor
+#pragma region
+
+        static size_t default_concurrency() {
+            size_t n = std::thread::hardware_concurrency();
+            return n ? n : 1;
+        }
+
+        explicit thread_pool(size_t thread_count = default_concurrency()) {
+            if (thread_count == 0) thread_count = 1;
+            for (size_t i = 0; i < thread_count; ++i) {
+                workers.emplace_back(new worker);
+                workers.back()->rng = 0x9e3779b97f4a7c15ull * (i + 1);
+            }
+            threads.reserve(thread_count);
+            for (size_t i = 0; i < thread_count; ++i) threads.emplace_back([this, i] { work(i); });
+        }
+
+        thread_pool(const thread_pool &) = delete;
+
+        thread_pool &operator=(const thread_pool &) = delete;
+
+        // 执行完所有剩余的任务后退出
+        ~thread_pool() {
+            stopping.store(true, std::memory_order_seq_cst);
+            work_available.notify_all();
+            for (auto &t: threads) t.join();
+        }
+
+        // 进程内共享的线程池 , 线程数为硬件并发数
+        static thread_pool &global() {
+            static thread_pool pool;
+            return pool;
+        }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        size_t size() const { return workers.size(); }
+
+        // 当前线程是否为本线程池的工作线程
+        bool in_worker() const { return current == this; }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 提交一个不关心结果的任务 , 任务抛出的异常不会离开工作线程 , 第一个异常通过take_exception取得
+        template<typename Function>
+        void execute(Function &&task) {
+            push(detail::make_pool_task([this, fn = std::forward<Function>(task)]() mutable {
+                try {
+                    fn();
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(unhandled_mtx);
+                    if (!unhandled) unhandled = std::current_exception();
+                }
+            }));
+        }
+
+        // 取出并清除execute的任务抛出的第一个异常 , 没有时返回空
+        std::exception_ptr take_exception() {
+            std::lock_guard<std::mutex> lock(unhandled_mtx);
+            std::exception_ptr e = unhandled;
+            unhandled = nullptr;
+            return e;
+        }
+
+        // 提交任务 , 通过返回的future取得结果或异常
+        template<typename Function>
+        auto submit(Function &&f) -> task_future<std::invoke_result_t<std::decay_t<Function> &>>;
+
+        // 将[0,n)按grain切成块 , 对每块[c*grain, min((c+1)*grain, n))调用body(begin, end) , 全部完成后返回
+        // grain为0时按线程数自适应 , 约为每个线程8块
+        // 块通过递归二分产生任务 , 空闲线程窃取的总是最大的剩余区间
+        // 某块抛出异常后不再执行新的块 , 第一个异常在调用线程重新抛出
+        template<typename Function>
+        void parallel_for(size_t n, size_t grain, Function &&body);
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        // 工作线程压入自己的队列 , 其他线程压入共享队列
+        void push(detail::pool_task *task) {
+            if (in_worker()) {
+                workers[current_index]->tasks.push(task);
+            } else {
+                std::lock_guard<std::mutex> lock(injected_mtx);
+                injected.push_back(task);
+                injected_count.fetch_add(1, std::memory_order_relaxed);
+            }
+            work_available.notify_one();
+        }
+
+        detail::pool_task *pop_injected() {
+            if (injected_count.load(std::memory_order_relaxed) == 0) return nullptr;
+            std::lock_guard<std::mutex> lock(injected_mtx);
+            if (injected.empty()) return nullptr;
+            detail::pool_task *task = injected.front();
+            injected.pop_front();
+            injected_count.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+
+        // 按自己的队列 , 共享队列 , 从随机的位置开始依次窃取其他队列的顺序寻找任务
+        detail::pool_task *find_task(size_t self) {
+            detail::pool_task *task = nullptr;
+            if (workers[self]->tasks.pop(task)) return task;
+            if ((task = pop_injected())) return task;
+            size_t n = size(), start = next_random(*workers[self]) % n;
+            for (size_t k = 0; k < n; ++k) {
+                size_t victim = (start + k) % n;
+                if (victim != self && workers[victim]->tasks.steal(task)) return task;
+            }
+            return nullptr;
+        }
+
+        static uint64_t next_random(worker &w) {
+            w.rng ^= w.rng << 13, w.rng ^= w.rng >> 7, w.rng ^= w.rng << 17;
+            return w.rng;
+        }
+
+        static void run_task(detail::pool_task *task) {
+            task->run();
+            task->release();
+        }
+
+        void work(size_t index) {
+            current = this, current_index = index;
+            while (true) {
+                detail::pool_task *task = find_task(index);
+                if (!task) {
+                    // 先登记等待再检查一次 , 之后提交的任务一定会唤醒本线程
+                    uint64_t key = work_available.prepare_wait();
+                    if ((task = find_task(index))) {
+                        work_available.cancel_wait();
+                    } else if (stopping.load(std::memory_order_seq_cst)) {
+                        work_available.cancel_wait();
+                        return;
+                    } else {
+                        work_available.commit_wait(key);
+                        continue;
+                    }
+                }
+                run_task(task);
+            }
+        }
+
+        // 等待done()成立 , 工作线程执行其他任务
+        // 外部线程调用arm()原子地登记等待并返回是否已经完成 , 未完成则睡眠
+        // 完成方只在看到登记标记时才唤醒 , 其他任务组与future的完成不会打扰睡眠的线程
+        template<typename Predicate, typename Arm>
+        void wait_until(Predicate done, Arm arm) {
+            if (in_worker()) {
+                while (!done()) {
+                    if (detail::pool_task *task = find_task(current_index)) run_task(task);
+                    else std::this_thread::yield();
+                }
+            } else {
+                while (true) {
+                    uint64_t key = work_done.prepare_wait();
+                    if (arm()) return work_done.cancel_wait();
+                    work_done.commit_wait(key);
+                }
+            }
+        }
+
+#pragma endregion
+    };
+
+    // submit返回的结果 , 只能移动 , get只能调用一次
+    template<typename R>
+    class task_future {
+        friend class thread_pool;
+
+        // 共享状态 , 由任务与future各持有一个引用
+        struct state : detail::pool_task {
+            thread_pool *pool = nullptr;
+            std::optional<std::conditional_t<std::is_void_v<R>, char, R>> value;
+            std::exception_ptr error;
+            std::atomic<int> status{0}; // ready_bit | waiting_bit
+        };
+
+        static constexpr int ready_bit = 1, waiting_bit = 2;
+
+        template<typename Function>
+        struct task final : state {
+            Function f;
+
+            explicit task(Function &&fn) : f(std::move(fn)) {}
+
+            void run() override {
+                try {
+                    if constexpr(std::is_void_v<R>) f(), this->value.emplace();
+                    else this->value.emplace(f());
+                } catch (...) {
+                    this->error = std::current_exception();
+                }
+                if (this->status.fetch_or(ready_bit, std::memory_order_acq_rel) & waiting_bit) {
+                    this->pool->work_done.notify_all();
+                }
+            }
+        };
+
+        state *st = nullptr;
+
+        explicit task_future(state *s) : st(s) {}
+
+    public:
+        task_future() = default;
+
+        task_future(task_future &&other) noexcept : st(other.st) { other.st = nullptr; }
+
+        task_future &operator=(task_future &&other) noexcept {
+            if (this != &other) {
+                if (st) st->release();
+                st = other.st, other.st = nullptr;
+            }
+            return *this;
+        }
+
+        ~task_future() { if (st) st->release(); }
+
+        bool valid() const { return st != nullptr; }
+
+        bool is_ready() const { return st->status.load(std::memory_order_acquire) & ready_bit; }
+
+        // 工作线程中等待时执行其他任务
+        void wait() const {
+            state *s = st;
+            s->pool->wait_until([s] { return s->status.load(std::memory_order_acquire) & ready_bit; },
+                                [s] { return s->status.fetch_or(waiting_bit, std::memory_order_acq_rel) & ready_bit; });
+        }
+
+        // 等待完成 , 返回结果或重新抛出任务中的异常
+        R get() {
+            wait();
+            struct releaser {
+                state *s;
+
+                ~releaser() { s->release(); }
+            } guard{st};
+            st = nullptr;
+            if (guard.s->error) std::rethrow_exception(guard.s->error);
+            if constexpr(!std::is_void_v<R>) return std::move(*guard.s->value);
+        }
+    };
+
+    template<typename Function>
+    auto thread_pool::submit(Function &&f) -> task_future<std::invoke_result_t<std::decay_t<Function> &>> {
+        using R = std::invoke_result_t<std::decay_t<Function> &>;
+        using task = typename task_future<R>::template task<std::decay_t<Function>>;
+        auto *st = new task(std::decay_t<Function>(std::forward<Function>(f)));
+        st->pool = this;
+        st->refs.store(2, std::memory_order_relaxed);
+        push(st);
+        return task_future<R>(st);
+    }
+
+    // fork-join : spawn派生子任务 , sync等待本组的所有子任务完成
+    // 子任务中可以继续创建task_group , 第一个异常在sync中重新抛出 , 之后新派生的任务不再执行
+    class task_group {
+        static constexpr size_t waiting_bit = size_t(1) << (sizeof(size_t) * 8 - 1);
+
+        thread_pool &pool;
+        std::atomic<size_t> pending{0}; // 未完成的任务数 | waiting_bit
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex error_mtx;
+    public:
+        explicit task_group(thread_pool &p = thread_pool::global()) : pool(p) {}
+
+        task_group(const task_group &) = delete;
+
+        task_group &operator=(const task_group &) = delete;
+
+        // 等待未完成的任务 , 不抛出其中的异常
+        ~task_group() { wait(); }
+
+        template<typename Function>
+        void spawn(Function &&f) {
+            pending.fetch_add(1, std::memory_order_relaxed);
+            pool.push(detail::make_pool_task([this, fn = std::forward<Function>(f)]() mutable {
+                if (!failed.load(std::memory_order_relaxed)) {
+                    try {
+                        fn();
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(error_mtx);
+                        if (!error) error = std::current_exception();
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+                // 计数归零后sync可能立即返回并销毁本组 , 之后只能访问线程池
+                thread_pool *p = &pool;
+                if (pending.fetch_sub(1, std::memory_order_acq_rel) == (waiting_bit | 1)) p->work_done.notify_all();
+            }));
+        }
+
+        bool cancelled() const { return failed.load(std::memory_order_relaxed); }
+
+        void sync() {
+            wait();
+            if (error) {
+                std::exception_ptr e = error;
+                error = nullptr, failed.store(false, std::memory_order_relaxed);
+                std::rethrow_exception(e);
+            }
+        }
+
+    private:
+        void wait() {
+            auto done = [](size_t v) { return (v & ~waiting_bit) == 0; };
+            pool.wait_until([&] { return done(pending.load(std::memory_order_acquire)); },
+                            [&] { return done(pending.fetch_or(waiting_bit, std::memory_order_acq_rel)); });
+            pending.fetch_and(~waiting_bit, std::memory_order_relaxed);
+        }
+    };
+
+    template<typename Function>
+    void thread_pool::parallel_for(size_t n, size_t grain, Function &&body) {
+        if (n == 0) return;
+        if (grain == 0) grain = ttl::max(size_t(1), n / (size() * 8));
+        size_t chunks = (n + grain - 1) / grain;
+        if (chunks == 1) return body(size_t(0), n);
+        task_group group(*this);
+        // 不断把右半部分派生出去 , 自己处理左半部分 , 直到只剩一块
+        struct splitter {
+            task_group &group;
+            Function &body;
+            size_t n, grain;
+
+            void operator()(size_t lo, size_t hi) const {
+                while (hi - lo > 1) {
+                    size_t mid = lo + (hi - lo) / 2;
+                    group.spawn([self = *this, mid, hi] { self(mid, hi); });
+                    hi = mid;
+                }
+                if (!group.cancelled()) body(lo * grain, ttl::min((lo + 1) * grain, n));
+            }
+        };
+        group.spawn([split = splitter{group, body, n, grain}, chunks] { split(0, chunks); });
+        group.sync();
+    }
+}
+
+#endif //TINYSTL_THREAD_POOL_H
@@ -0,0 +1,127 @@
+﻿#ifndef TINYSTL_WORK_STEALING_DEQUE_H
+#define TINYSTL_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "../container/vector.h"
+
+namespace ttl {
+
+    // Chase-Lev工作窃取双端队列 , 内存序参照Lê等人的C11版本
+    // 所有者线程在底部push/pop(后进先出) , 其他线程从顶部steal(先进先出)
+    // 环形数组写满时扩容为两倍 , 旧数组在析构时才释放 , 因为窃取者可能仍在读
+    // T需要可以无锁原子读写 , 通常为指针
+    template<typename T>
+    class work_stealing_deque {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        struct ring {
+            int64_t capacity;
+            int64_t mask;
+            std::atomic<T> *slots;
+
+            explicit ring(int64_t cap) : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[cap]) {}
+
+            ~ring() { delete[] slots; }
+
+            T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+
+            void put(int64_t i, T x) { slots[i & mask].store(x, std::memory_order_relaxed); }
+        };
+
+        alignas(64) std::atomic<int64_t> top{0};
+        alignas(64) std::atomic<int64_t> bottom{0};
+        std::atomic<ring *> array;
+        ttl::vector<ring *> retired; // 只由所有者线程访问
+    public: // constructor
+#pragma region
+
+        // capacity需要为2的幂
+        explicit work_stealing_deque(int64_t capacity = 256) : array(new ring(capacity)) {}
+
+        work_stealing_deque(const work_stealing_deque &) = delete;
+
+        work_stealing_deque &operator=(const work_stealing_deque &) = delete;
+
+        ~work_stealing_deque() {
+            delete array.load(std::memory_order_relaxed);
+            for (ring *r: retired) delete r;
+        }
+
+#pragma endregion
+    public: // capacity
+#pragma region
+
+        // 并发修改时只是近似值
+        bool empty() const {
+            int64_t b = bottom.load(std::memory_order_relaxed), t = top.load(std::memory_order_relaxed);
+            return b <= t;
+        }
+
+#pragma endregion
+    public: // change
+#pragma region
+
+        // 只能由所有者调用
+        void push(T x) {
+            int64_t b = bottom.load(std::memory_order_relaxed), t = top.load(std::memory_order_acquire);
+            ring *a = array.load(std::memory_order_relaxed);
+            if (b - t > a->capacity - 1) a = grow(a, t, b);
+            a->put(b, x);
+            bottom.store(b + 1, std::memory_order_release);
+        }
+
+        // 只能由所有者调用 , 为空时返回false
+        // 只剩一个元素时与窃取者通过CAS top竞争
+        bool pop(T &out) {
+            int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+            ring *a = array.load(std::memory_order_relaxed);
+            bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t t = top.load(std::memory_order_relaxed);
+            if (t > b) {
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return false;
+            }
+            out = a->get(b);
+            if (t == b) {
+                bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+                bottom.store(b + 1, std::memory_order_relaxed);
+                return won;
+            }
+            return true;
+        }
+
+        // 任意线程调用 , 为空或与其他线程竞争失败时返回false
+        bool steal(T &out) {
+            int64_t t = top.load(std::memory_order_acquire);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            int64_t b = bottom.load(std::memory_order_acquire);
+            if (t >= b) return false;
+            ring *a = array.load(std::memory_order_acquire);
+            T x = a->get(t);
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return false;
+            }
+            out = x;
+            return true;
+        }
+
+#pragma endregion
+    private: // helper
+#pragma region
+
+        ring *grow(ring *old, int64_t t, int64_t b) {
+            ring *a = new ring(old->capacity * 2);
+            for (int64_t i = t; i < b; ++i) a->put(i, old->get(i));
+            retired.push_back(old);
+            array.store(a, std::memory_order_release);
+            return a;
+        }
+
+#pragma endregion
+    };
+}
+
+#endif //TINYSTL_WORK_STEALING_DEQUE_H
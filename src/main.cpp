@@ -8,11 +8,41 @@
 #include "./tests/deque_test.h"
 #include "./tests/bs_tree_test.h"
 #include "./tests/segment_tree_test.h"
+#include "./tests/unrolled_list_test.h"
+#include "./tests/intrusive_test.h"
+#include "./tests/forward_list_test.h"
+#include "./tests/indexed_priority_queue_test.h"
+#include "./tests/top_k_test.h"
+#include "./tests/timing_wheel_test.h"
+#include "./tests/sort_test.h"
+#include "./tests/radix_sort_test.h"
+#include "./tests/execution_test.h"
+#include "./tests/thread_pool_test.h"
+#include "./tests/simd_test.h"
+#include "./tests/dynamic_bitset_test.h"
+#include "./tests/roaring_bitmap_test.h"
+#include "./tests/rank_select_bitvector_test.h"
+#include "./tests/sparse_table_test.h"
 
 using namespace ttl::ttl_test;
 
 // write all test code
 int main() {
+    sparse_table_test::runAll();
+    rank_select_bitvector_test::runAll();
+    roaring_bitmap_test::runAll();
+    dynamic_bitset_test::runAll();
+    simd_test::runAll();
+    thread_pool_test::runAll();
+    execution_test::runAll();
+    radix_sort_test::runAll();
+    sort_test::runAll();
+    timing_wheel_test::runAll();
+    top_k_test::runAll();
+    indexed_priority_queue_test::runAll();
+    forward_list_test::runAll();
+    intrusive_test::runAll();
+    unrolled_list_test::runAll();
     segment_tree_test::runAll();
     // if (time(nullptr)) return 0;
     bs_tree_test::runAll();
@@ -33,6 +33,24 @@ namespace ttl::ttl_test {
             test4();
             test5();
             test6();
+            test7();
+            test8<1 << 10>();
+            test8<1 << 16>();
+            test8<1 << 20>();
+            test9<1>();
+            test9<63>();
+            test9<64>();
+            test9<65>();
+            test9<1000>();
+            test9<4103>();
+            test10();
+            test11<1>();
+            test11<64>();
+            test11<65>();
+            test11<1000>();
+            test11<4103>();
+            test12(100);
+            test12(1000);
         }
 
     private:
@@ -116,6 +134,236 @@ namespace ttl::ttl_test {
             }, "bitset offset");
             bs_same(tb, sb);
         }
+
+        // 位操作与按字批量计数 , 覆盖Harley-Seal内核的各种余数
+        static void test7() {
+            static_assert(ttl::popcount(uint8_t(0xff)) == 8 && ttl::popcount(~0ull) == 64);
+            static_assert(ttl::countl_zero(uint16_t(1)) == 15 && ttl::countr_zero(uint32_t(0)) == 32);
+            static_assert(ttl::bit_width(0u) == 0 && ttl::bit_width(uint64_t(1) << 40) == 41);
+            static_assert(ttl::rotl(uint8_t(0x81), 1) == 0x03 && ttl::rotr(uint8_t(0x81), -9) == 0x03);
+            static_assert(ttl::byteswap(uint32_t(0x12345678)) == 0x78563412);
+            static_assert(ttl::byteswap(int16_t(0x0180)) == int16_t(0x8001));
+            for (int i = 0; i < 100000; ++i) {
+                uint64_t x = uint64_t(randInt()) << 33 ^ uint64_t(randInt()) << 11 ^ uint64_t(randInt());
+                int s = randInt(-200, 200);
+                assert(ttl::popcount(x) == int(std::bitset<64>(x).count()));
+                assert(ttl::popcount(uint16_t(x)) == int(std::bitset<16>(uint16_t(x)).count()));
+                int width = 0;
+                while (width < 64 && (x >> width)) ++width;
+                assert(ttl::bit_width(x) == width && ttl::countl_zero(x) == 64 - width);
+                assert(x == 0 || ((x >> ttl::countr_zero(x) & 1) && !(x & ((1ull << ttl::countr_zero(x)) - 1))));
+                uint32_t y = uint32_t(x);
+                assert(ttl::rotr(ttl::rotl(y, s), s) == y);
+                assert(ttl::rotl(y, s) == (y << ((s % 32 + 32) % 32) | y >> ((32 - (s % 32 + 32) % 32) % 32)));
+                assert(ttl::byteswap(ttl::byteswap(x)) == x && uint8_t(ttl::byteswap(x)) == uint8_t(x >> 56));
+            }
+            std::vector<uint64_t> words(3000);
+            for (auto &w: words) w = uint64_t(randInt()) << 32 | uint64_t(randInt());
+            for (size_t n = 0; n < words.size(); n = n < 300 ? n + 1 : n * 3 / 2) {
+                for (size_t off = 0; off < 2 && off <= n; ++off) {
+                    size_t expect = 0;
+                    for (size_t i = off; i < n; ++i) expect += std::bitset<64>(words[i]).count();
+                    assert(ttl::popcount(words.data() + off, words.data() + n) == expect);
+                }
+            }
+        }
+
+        // Bytes字节的bitset重复计数 , 报告吞吐量
+        template<size_t Bytes>
+        static void test8() {
+            constexpr size_t bits = Bytes * 8, reps = (size_t(256) << 20) / Bytes;
+            auto tb = std::make_unique<ttl::bitset<bits>>();
+            auto sb = std::make_unique<std::bitset<bits>>();
+            for (size_t i = 0; i < bits; ++i) {
+                if (randInt() & 1) tb->set(i), sb->set(i);
+            }
+            size_t t_ret = 0, s_ret = 0;
+            TTL_BANDWIDTH_COMPARE(
+                    reps * Bytes,
+                    for (size_t r = 0; r < reps; ++r) t_ret += tb->count(),
+                    for (size_t r = 0; r < reps; ++r) s_ret += sb->count(),
+                    ("bitset count " + std::to_string(Bytes >> 10) + " KiB").c_str()
+            );
+            assert(t_ret == s_ret);
+        }
+
+        // 大约一半的位为1
+        template<size_t M>
+        static void rand_fill(ttl::bitset<M> &tb, std::bitset<M> &sb, int density = 2) {
+            tb.reset(), sb.reset();
+            for (size_t i = 0; i < M; ++i) {
+                if (randInt(density) == 0) tb.set(i), sb.set(i);
+            }
+        }
+
+        // 整字移位与批量位运算 , 覆盖不足一个字 , 恰好一个字 , 以及最后一个字不满的情况
+        template<size_t M>
+        static void test9() {
+            ttl::bitset<M> ta, tb;
+            std::bitset<M> sa, sb;
+            for (int round = 0; round < 50; ++round) {
+                rand_fill(ta, sa);
+                rand_fill(tb, sb, round % 5 + 1);
+                for (size_t offset: {size_t(0), size_t(1), size_t(63), size_t(64), size_t(65), M / 2, M - 1, M, M + 7,
+                                     size_t(randInt(int(M) + 1))}) {
+                    bs_same(ta << offset, sa << offset);
+                    bs_same(ta >> offset, sa >> offset);
+                }
+                assert(ta.and_count(tb) == (sa & sb).count());
+                assert(ta.or_count(tb) == (sa | sb).count());
+                bs_same(ta & tb, sa & sb);
+                bs_same(ta | tb, sa | sb);
+                bs_same(ta ^ tb, sa ^ sb);
+                bs_same(~ta, ~sa);
+                bs_same(ttl::bitset<M>(ta).and_not(tb), sa & ~sb);
+                assert((ta == tb) == (sa == sb) && ta == ttl::bitset<M>(ta));
+                assert(ta.none() == sa.none() && ta.all() == sa.all());
+            }
+            ta.reset(), sa.reset();
+            bs_same(ta, sa);
+            assert(ta.none() && !ta.any());
+            ta.set(M - 1), sa.set(M - 1);
+            bs_same(ta, sa);
+            assert(ta.any() && !ta.none());
+            ta.flip(), sa.flip();
+            bs_same(ta, sa);
+            ta.flip(M - 1), sa.flip(M - 1);
+            bs_same(ta, sa);
+            assert(ta.all() && ta.count() == M);
+        }
+
+        static void test10() {
+            constexpr size_t M = 1 << 20;
+            auto ta = std::make_unique<ttl::bitset<M>>(), tb = std::make_unique<ttl::bitset<M>>();
+            auto sa = std::make_unique<std::bitset<M>>(), sb = std::make_unique<std::bitset<M>>();
+            rand_fill(*ta, *sa);
+            rand_fill(*tb, *sb);
+            size_t t_ret = 0, s_ret = 0, rounds = 1000, bytes = rounds * M / 8;
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    for (size_t r = 0; r < rounds; ++r) *ta <<= r % 200 + 1,
+                    for (size_t r = 0; r < rounds; ++r) *sa <<= r % 200 + 1,
+                    "bitset<1<<20> <<="
+            );
+            bs_same(*ta, *sa);
+            rand_fill(*ta, *sa);
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    for (size_t r = 0; r < rounds; ++r) *ta >>= r % 200 + 1,
+                    for (size_t r = 0; r < rounds; ++r) *sa >>= r % 200 + 1,
+                    "bitset<1<<20> >>="
+            );
+            bs_same(*ta, *sa);
+            rand_fill(*ta, *sa);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) *ta ^= *tb,
+                    for (size_t r = 0; r < rounds; ++r) *sa ^= *sb,
+                    "bitset<1<<20> ^="
+            );
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) (r & 1 ? *ta &= *tb : *ta |= *tb),
+                    for (size_t r = 0; r < rounds; ++r) (r & 1 ? *sa &= *sb : *sa |= *sb),
+                    "bitset<1<<20> &= |="
+            );
+            bs_same(*ta, *sa);
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    for (size_t r = 0; r < rounds; ++r) ta->flip(),
+                    for (size_t r = 0; r < rounds; ++r) sa->flip(),
+                    "bitset<1<<20> flip"
+            );
+            bs_same(*ta, *sa);
+            ta->reset(), sa->reset();
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    for (size_t r = 0; r < rounds; ++r) t_ret += ta->none(),
+                    for (size_t r = 0; r < rounds; ++r) s_ret += sa->none(),
+                    "bitset<1<<20> none"
+            );
+            assert(t_ret == s_ret);
+            *ta = *tb, *sa = *sb;
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) { ta->flip(M - 1); t_ret += *ta == *tb; },
+                    for (size_t r = 0; r < rounds; ++r) { sa->flip(M - 1); s_ret += *sa == *sb; },
+                    "bitset<1<<20> =="
+            );
+            assert(t_ret == s_ret);
+            rand_fill(*ta, *sa);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) t_ret += ta->and_count(*tb),
+                    for (size_t r = 0; r < rounds; ++r) s_ret += (*sa & *sb).count(),
+                    "bitset<1<<20> and_count"
+            );
+            assert(t_ret == s_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) t_ret += (*ta & *tb).count(),
+                    for (size_t r = 0; r < rounds; ++r) s_ret += (*sa & *sb).count(),
+                    "bitset<1<<20> (a & b).count()"
+            );
+            assert(t_ret == s_ret);
+        }
+
+        // find_first/next/last/prev , for_each_set与set_bits都与逐位扫描的结果一致
+        template<size_t M>
+        static void test11() {
+            ttl::bitset<M> tb;
+            std::bitset<M> sb;
+            for (int density: {1, 2, 10, 100, 100000}) {
+                rand_fill(tb, sb, density);
+                std::vector<size_t> expect, visited, iterated, forward, backward;
+                for (size_t i = 0; i < M; ++i) if (sb.test(i)) expect.push_back(i);
+                tb.for_each_set([&visited](size_t i) { visited.push_back(i); });
+                for (size_t i: tb.set_bits()) iterated.push_back(i);
+                for (size_t i = tb.find_first(); i != M; i = tb.find_next(i)) forward.push_back(i);
+                for (size_t i = tb.find_last(); i != M; i = tb.find_prev(i)) backward.push_back(i);
+                std::reverse(backward.begin(), backward.end());
+                assert(visited == expect && iterated == expect && forward == expect && backward == expect);
+                for (int k = 0; k < 100; ++k) {
+                    size_t i = randInt(int(M));
+                    auto next = std::upper_bound(expect.begin(), expect.end(), i);
+                    auto prev = std::lower_bound(expect.begin(), expect.end(), i);
+                    assert(tb.find_next(i) == (next == expect.end() ? M : *next));
+                    assert(tb.find_prev(i) == (prev == expect.begin() ? M : *(prev - 1)));
+                }
+                assert(tb.find_next(M - 1) == M && tb.find_next(M + 5) == M && tb.find_prev(0) == M);
+                assert(tb.find_prev(M + 5) == tb.find_last());
+            }
+        }
+
+        // 密度为1/density的bitset<1<<20> , 逐位test与按字跳过0的几种遍历方式
+        static void test12(int density) {
+            constexpr size_t M = 1 << 20;
+            auto tb = std::make_unique<ttl::bitset<M>>();
+            auto sb = std::make_unique<std::bitset<M>>();
+            rand_fill(*tb, *sb, density);
+            size_t rounds = 100, s_ret = 0, t_ret = 0;
+            std::string suffix = " 1/" + std::to_string(density);
+            TTL_STL_COMPARE_2(
+                    for (size_t r = 0; r < rounds; ++r) tb->for_each_set([&t_ret](size_t i) { t_ret += i; }),
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = 0; i < M; ++i) if (sb->test(i)) s_ret += i,
+                    ("bitset for_each_set" + suffix).c_str()
+            );
+            assert(s_ret == t_ret);
+            t_ret = 0;
+            TTL_STL_COMPARE_2(
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i: tb->set_bits()) t_ret += i,
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = 0; i < M; ++i) if (sb->test(i)) s_ret += i,
+                    ("bitset set_bits" + suffix).c_str()
+            );
+            assert(2 * t_ret == s_ret);
+            t_ret = 0;
+            TTL_STL_COMPARE_2(
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = tb->find_first(); i != M; i = tb->find_next(i)) t_ret += i,
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = 0; i < M; ++i) if (sb->test(i)) s_ret += i,
+                    ("bitset find_next" + suffix).c_str()
+            );
+            assert(3 * t_ret == s_ret);
+        }
     };
 
 }
@@ -10,10 +10,31 @@
 #include "../utils/test_helper.h"
 #include <deque>
 #include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace ttl::ttl_test {
 
     class deque_test {
+        // countdown归零时拷贝构造抛出异常 , 负数表示不抛出
+        struct throwing_item {
+            inline static int countdown = -1;
+            int val;
+
+            explicit throwing_item(int val) : val(val) {}
+
+            throwing_item(const throwing_item &rhs) : val(rhs.val) {
+                if (countdown >= 0 && countdown-- == 0) throw std::runtime_error("throwing_item copy");
+            }
+
+            throwing_item(throwing_item &&rhs) noexcept: val(rhs.val) {}
+
+            throwing_item &operator=(const throwing_item &) = default;
+
+            throwing_item &operator=(throwing_item &&) noexcept = default;
+        };
+
     public:
         static void runAll() {
             test1();
@@ -21,6 +42,10 @@ namespace ttl::ttl_test {
             test3();
             test4();
             test5();
+            test6();
+            test7();
+            test8();
+            test9();
         }
 
     private:
@@ -87,13 +112,12 @@ namespace ttl::ttl_test {
                 int j = 0;
                 v.insert(v.end(), "12345");
                 v.insert(v.end(), 12345u, "4321");
-                // Todo fix 注释中的代码取消后会有内存错误
-                // v.insert(v.begin() + 5005, rd.begin(), rd.end());
+                v.insert(v.begin() + 5005, rd.begin(), rd.end());
                 v.insert(v.begin() + 1235, {"-3", "4", "-5"});
                 for (int i = 1; i <= n; ++i) v.emplace_front(std::to_string(j++));
                 for (int i = 1; i <= n; ++i) v.emplace_back(std::to_string(j++));
                 for (int i = 1; i <= n; ++i) v.emplace_front(std::to_string(j++));
-                //for (int i = 1; i <= n; ++i) v.emplace(v.begin() + i, j++);
+                for (int i = 1; i <= n / 50; ++i) v.emplace(v.begin() + i, std::to_string(j++));
             }, "deque push");
             same(sd, td);
         }
@@ -138,6 +162,97 @@ namespace ttl::ttl_test {
             }, "deque resize");
             same(sd, td);
         }
+
+        // 中间插入
+        static void test6() {
+            using T = std::string;
+            const int n = 5000;
+            auto rd = randStrArray(n, 20);
+            auto rdi = randIntArray(n);
+            std::deque<T> sd(rd.begin(), rd.end());
+            ttl::deque<T> td(rd.begin(), rd.end());
+            TTL_STL_COMPARE(td, sd, {
+                for (int i = 0; i < n; ++i) {
+                    v.insert(v.begin() + rdi[i] % v.size(), rd[i]);
+                    if (i % 100 == 0) v.insert(v.begin() + rdi[i] % v.size(), 100, rd[i]);
+                    if (i % 100 == 50) v.insert(v.begin() + rdi[i] % v.size(), rd.begin(), rd.begin() + 100);
+                }
+            }, "deque middle insert");
+            same(sd, td);
+        }
+
+        // 不可默认构造的元素
+        static void test7() {
+            struct item {
+                std::string s;
+
+                explicit item(std::string s) : s(std::move(s)) {}
+
+                bool operator==(const item &rhs) const { return s == rhs.s; }
+            };
+            const int n = 5000;
+            auto rd = randStrArray(n, 10);
+            auto rdi = randIntArray(n);
+            std::deque<item> sd;
+            ttl::deque<item> td;
+            TTL_STL_COMPARE(td, sd, {
+                for (int i = 0; i < n; ++i) {
+                    v.emplace(v.begin() + (v.empty() ? 0 : rdi[i] % v.size()), rd[i]);
+                    v.insert(v.end() - (v.size() / 3), item(rd[i]));
+                }
+            }, "deque emplace no default");
+            same(sd, td);
+        }
+
+        // 中间插入时构造抛出异常 , deque应恢复原状
+        static void test8() {
+            using item = throwing_item;
+            const int n = 3000;
+            auto rdi = randIntArray(n);
+            ttl::deque<item> td;
+            std::vector<int> expect;
+            for (int i = 0; i < n; ++i) td.emplace_back(i), expect.push_back(i);
+            std::vector<item> src(1000, item(-1));
+            for (int i = 0; i < 300; ++i) {
+                size_t idx = rdi[i] % (td.size() + 1), count = 1 + rdi[i] % 700;
+                item::countdown = int(rdi[i] % count);
+                bool thrown = false;
+                try {
+                    if (i % 3 == 0) td.insert(td.begin() + idx, count, item(-1));
+                    else if (i % 3 == 1) td.insert(td.begin() + idx, src.begin(), src.begin() + count);
+                    else item::countdown = 0, td.insert(td.begin() + idx, src[0]);
+                } catch (const std::runtime_error &) {
+                    thrown = true;
+                }
+                item::countdown = -1;
+                assert(thrown && td.size() == expect.size());
+                for (size_t j = 0; j < expect.size(); ++j) assert(td[j].val == expect[j]);
+                // 确认合上空位后还能正常插入
+                td.insert(td.begin() + idx, item(i)), expect.insert(expect.begin() + idx, i);
+            }
+        }
+
+        // 插入的值引用了deque自身的元素 , 在头部插入时prepare_at也会移动该元素
+        static void test9() {
+            for (int sz: {1, 2, 3, 10}) {
+                for (size_t count: {1, 2, 5, 100}) {
+                    ttl::deque<std::string> td;
+                    std::deque<std::string> sd;
+                    for (int i = 0; i < sz; ++i) {
+                        td.push_back(std::string(40, char('a' + i)));
+                        sd.push_back(td.back());
+                    }
+                    td.insert(td.begin(), count, td.front());
+                    sd.insert(sd.begin(), count, sd.front());
+                    td.insert(td.begin() + 1, count, td.back());
+                    sd.insert(sd.begin() + 1, count, sd.back());
+                    td.insert(td.end(), count, td.front());
+                    sd.insert(sd.end(), count, sd.front());
+                    assert(td.size() == sd.size());
+                    for (size_t j = 0; j < sd.size(); ++j) assert(td[j] == sd[j]);
+                }
+            }
+        }
     };
 
 }
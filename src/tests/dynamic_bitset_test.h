@@ -0,0 +1,211 @@
+﻿#ifndef TINYSTL_DYNAMIC_BITSET_TEST_H
+#define TINYSTL_DYNAMIC_BITSET_TEST_H
+
+#include "../container/expand/dynamic_bitset.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <vector>
+
+namespace ttl::ttl_test {
+
+    class dynamic_bitset_test {
+        static void ds_same(const ttl::dynamic_bitset &tb, const std::vector<bool> &sb) {
+            assert(tb.size() == sb.size());
+            size_t cnt = 0;
+            for (size_t i = 0; i < sb.size(); ++i) {
+                if (tb.test(i) != sb[i]) assert(false);
+                cnt += sb[i];
+            }
+            assert(tb.count() == cnt);
+            assert(tb.none() == (cnt == 0) && tb.any() == (cnt != 0) && tb.all() == (cnt == sb.size()));
+            // 超出size()的位为0
+            if (tb.size() % 64) assert(tb.data()[tb.word_count() - 1] >> (tb.size() % 64) == 0);
+        }
+
+        static void rand_fill(ttl::dynamic_bitset &tb, std::vector<bool> &sb, size_t n, int density = 2) {
+            tb.resize(0), sb.clear();
+            for (size_t i = 0; i < n; ++i) {
+                bool x = randInt(density) == 0;
+                tb.push_back(x), sb.push_back(x);
+            }
+        }
+
+        // 按"缺少的位视为0"的规则 , 结果长度为n
+        template<typename Op>
+        static std::vector<bool> apply(const std::vector<bool> &a, const std::vector<bool> &b, size_t n, Op op) {
+            std::vector<bool> ret(n);
+            for (size_t i = 0; i < n; ++i) ret[i] = op(i < a.size() && a[i], i < b.size() && b[i]);
+            return ret;
+        }
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4();
+            test5();
+        }
+
+    private:
+        // push_back/append/resize/pop_back 与 vector<bool> 对拍 , 覆盖跨字与扩容
+        static void test1() {
+            ttl::dynamic_bitset tb;
+            std::vector<bool> sb;
+            assert(tb.empty() && tb.none() && tb.all() && tb.count() == 0 && tb.find_first() == 0);
+            for (int round = 0; round < 3000; ++round) {
+                int op = randInt(10);
+                if (op < 5) {
+                    bool x = randInt(2);
+                    tb.push_back(x), sb.push_back(x);
+                } else if (op < 7) {
+                    unsigned long long w = (unsigned long long) randInt() << 33 ^ (unsigned long long) randInt() << 2 ^ randInt(4);
+                    tb.append(w);
+                    for (int i = 0; i < 64; ++i) sb.push_back(w >> i & 1);
+                } else if (op < 8) {
+                    size_t n = randInt(int(sb.size()) + 130);
+                    bool x = randInt(2);
+                    tb.resize(n, x), sb.resize(n, x);
+                } else if (op < 9 && !sb.empty()) {
+                    tb.pop_back(), sb.pop_back();
+                } else if (!sb.empty()) {
+                    size_t i = randInt(int(sb.size()));
+                    tb[i].flip(), sb[i] = !sb[i];
+                }
+                ds_same(tb, sb);
+                assert(tb.capacity() >= tb.size());
+                assert(reinterpret_cast<uintptr_t>(tb.data()) % 64 == 0);
+            }
+            ttl::dynamic_bitset copy = tb, moved;
+            assert(copy == tb);
+            moved = std::move(copy);
+            assert(moved == tb && copy.empty());
+            tb.clear();
+            assert(tb.empty() && tb != moved);
+            bool caught = false;
+            try { (void)tb.test(0); } catch (const std::out_of_range &) { caught = true; }
+            assert(caught);
+        }
+
+        // 长度不同的对象之间的原地运算 , 二元运算 , 计数与比较
+        static void test2() {
+            const size_t lens[] = {0, 1, 63, 64, 65, 127, 128, 500, 1000, 4103};
+            ttl::dynamic_bitset ta, tb;
+            std::vector<bool> sa, sb;
+            for (size_t n: lens) {
+                for (size_t m: lens) {
+                    rand_fill(ta, sa, n);
+                    rand_fill(tb, sb, m, randInt(1, 5));
+                    size_t k = std::max(n, m), and_cnt = 0, or_cnt = 0;
+                    for (size_t i = 0; i < k; ++i) {
+                        bool x = i < n && sa[i], y = i < m && sb[i];
+                        and_cnt += x && y, or_cnt += x || y;
+                    }
+                    assert(ta.and_count(tb) == and_cnt && tb.and_count(ta) == and_cnt);
+                    assert(ta.or_count(tb) == or_cnt && tb.or_count(ta) == or_cnt);
+                    ds_same(ttl::dynamic_bitset(ta) &= tb, apply(sa, sb, n, std::logical_and<>()));
+                    ds_same(ttl::dynamic_bitset(ta) |= tb, apply(sa, sb, n, std::logical_or<>()));
+                    ds_same(ttl::dynamic_bitset(ta) ^= tb, apply(sa, sb, n, std::not_equal_to<>()));
+                    ds_same(ttl::dynamic_bitset(ta).and_not(tb), apply(sa, sb, n, [](bool x, bool y) { return x && !y; }));
+                    ds_same(ta & tb, apply(sa, sb, k, std::logical_and<>()));
+                    ds_same(tb | ta, apply(sa, sb, k, std::logical_or<>()));
+                    ds_same(ta ^ tb, apply(sa, sb, k, std::not_equal_to<>()));
+                    assert((ta == tb) == (sa == sb));
+                }
+                std::vector<bool> flipped(sa);
+                flipped.flip();
+                ds_same(~ta, flipped);
+                ds_same(ttl::dynamic_bitset(ta).set(), std::vector<bool>(n, true));
+                ds_same(ttl::dynamic_bitset(ta).reset(), std::vector<bool>(n, false));
+                ds_same(ttl::dynamic_bitset(n, true), std::vector<bool>(n, true));
+            }
+        }
+
+        // 移位与查找 , 与vector<bool>逐位模拟的结果对拍
+        static void test3() {
+            ttl::dynamic_bitset tb;
+            std::vector<bool> sb;
+            for (size_t n: {1, 63, 64, 65, 1000, 4103}) {
+                for (int density: {2, 50, 1000}) {
+                    rand_fill(tb, sb, n, density);
+                    for (size_t offset: {size_t(0), size_t(1), size_t(63), size_t(64), size_t(65), n / 2, n - 1, n, n + 7}) {
+                        std::vector<bool> l(n), r(n);
+                        for (size_t i = offset; i < n; ++i) l[i] = sb[i - offset], r[i - offset] = sb[i];
+                        ds_same(tb << offset, l);
+                        ds_same(tb >> offset, r);
+                    }
+                    std::vector<size_t> ones, got;
+                    for (size_t i = 0; i < n; ++i) if (sb[i]) ones.push_back(i);
+                    for (size_t i: tb.set_bits()) got.push_back(i);
+                    assert(got == ones);
+                    got.clear();
+                    tb.for_each_set([&got](size_t i) { got.push_back(i); });
+                    assert(got == ones);
+                    got.clear();
+                    for (size_t i = tb.find_first(); i != n; i = tb.find_next(i)) got.push_back(i);
+                    assert(got == ones);
+                    got.clear();
+                    for (size_t i = tb.find_last(); i != n; i = tb.find_prev(i)) got.push_back(i);
+                    std::reverse(got.begin(), got.end());
+                    assert(got == ones);
+                }
+            }
+        }
+
+        // 逐位追加与按字追加 , 行过滤位图的构建方式
+        static void test4() {
+            const int len = 1 << 24;
+            auto rd = randIntArray(len);
+            ttl::dynamic_bitset tb;
+            std::vector<bool> sb;
+            TTL_STL_COMPARE_2(
+                    for (auto x: rd) tb.push_back(x & 1),
+                    for (auto x: rd) sb.push_back(x & 1),
+                    "dynamic_bitset push_back"
+            );
+            ds_same(tb, sb);
+            ttl::dynamic_bitset ta;
+            TTL_STL_COMPARE_2(
+                    for (int i = 0; i < len; i += 64) ta.append(tb.data()[i / 64]),
+                    for (int i = 0; i < len; ++i) sb.push_back(rd[i] & 1),
+                    "dynamic_bitset append"
+            );
+            assert(ta == tb);
+        }
+
+        // 1<<22位的批量运算 , 报告吞吐量
+        static void test5() {
+            const size_t M = 1 << 22, rounds = 10, bytes = rounds * M / 8;
+            ttl::dynamic_bitset ta, tb;
+            std::vector<bool> sa, sb;
+            rand_fill(ta, sa, M);
+            rand_fill(tb, sb, M);
+            size_t t_ret = 0, s_ret = 0;
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    for (size_t r = 0; r < rounds; ++r) t_ret += ta.count(),
+                    for (size_t r = 0; r < rounds; ++r) s_ret += std::count(sa.begin(), sa.end(), true),
+                    "dynamic_bitset count"
+            );
+            assert(t_ret == s_ret);
+            t_ret = s_ret = 0;
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) t_ret += ta.and_count(tb),
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = 0; i < M; ++i) s_ret += sa[i] && sb[i],
+                    "dynamic_bitset and_count"
+            );
+            assert(t_ret == s_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    for (size_t r = 0; r < rounds; ++r) ta ^= tb,
+                    for (size_t r = 0; r < rounds; ++r) for (size_t i = 0; i < M; ++i) sa[i] = sa[i] != sb[i],
+                    "dynamic_bitset ^="
+            );
+            ds_same(ta, sa);
+        }
+    };
+
+}
+
+#endif //TINYSTL_DYNAMIC_BITSET_TEST_H
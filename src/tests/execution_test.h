@@ -0,0 +1,252 @@
+﻿#ifndef TINYSTL_EXECUTION_TEST_H
+#define TINYSTL_EXECUTION_TEST_H
+
+#include "../algorithm/execution.h"
+#include "../container/vector.h"
+#include "../container/deque.h"
+#include "../container/list.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace ttl::ttl_test {
+
+    class execution_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4(100000000);
+        }
+
+    private:
+        // 各算法在par/par_unseq/seq下与std的结果一致 , 包括小于一块 , 刚好整块与非整块的长度
+        // 线程池有4个线程 , 单核机器上同样会交错执行
+        static void test1() {
+            ttl::thread_pool pool(4);
+            auto par = ttl::execution::par.on(pool);
+            auto par_unseq = ttl::execution::par_unseq.on(pool);
+            auto rd = randIntArray(1000003);
+            for (int n: {0, 1, 1000, 1 << 15, 1000003}) {
+                std::vector<int> sv(rd.begin(), rd.begin() + n);
+                ttl::vector<int> tv(sv.begin(), sv.end()), out(n), out2(n);
+                auto odd = [](int x) { return x % 2 != 0; };
+
+                ttl::for_each(par, tv.begin(), tv.end(), [](int &x) { x /= 2; });
+                for (auto &x: sv) x /= 2;
+                same(sv, tv);
+                size_t odd_count = std::count_if(sv.begin(), sv.end(), odd);
+                assert(ttl::count_if(par, tv.begin(), tv.end(), odd) == odd_count);
+                assert(ttl::reduce(par_unseq, tv.begin(), tv.end(), 0ll) == std::accumulate(sv.begin(), sv.end(), 0ll));
+
+                ttl::transform(par, tv.begin(), tv.end(), out.begin(), [](int x) { return x + 1; });
+                ttl::transform(par_unseq, tv.begin(), tv.end(), out.begin(), out2.begin(), std::minus<>());
+                auto not_minus_one = [](int x) { return x != -1; };
+                assert(ttl::count_if(ttl::execution::seq, out2.begin(), out2.end(), not_minus_one) == 0);
+                ttl::fill(par, out.begin(), out.end(), 7);
+                assert(ttl::count_if(par, out.begin(), out.end(), [](int x) { return x == 7; }) == size_t(n));
+                assert(ttl::copy(par, tv.begin(), tv.end(), out.begin()) == out.end());
+                assert(ttl::equal(par, tv.begin(), tv.end(), out.begin(), out.end()));
+                if (n) {
+                    out[n - 1] ^= 1;
+                    assert(!ttl::equal(par, tv.begin(), tv.end(), out.begin()));
+                    assert(!ttl::equal(par, tv.begin(), tv.end(), out.begin(), out.end() - 1));
+                }
+
+                // find_if返回第一个满足条件的位置 , 后面的块中也有满足条件的元素
+                for (int at: {0, n / 3, n / 2, n - 1}) {
+                    if (at < 0 || at >= n) continue;
+                    ttl::vector<int> fv(size_t(n), 0);
+                    for (int i = at; i < n; i += 1 << 14) fv[i] = 1;
+                    assert(ttl::find_if(par, fv.begin(), fv.end(), [](int x) { return x == 1; }) - fv.begin() == at);
+                }
+                assert(ttl::find_if(par, tv.begin(), tv.end(), [](int x) { return x < 0; }) == tv.end());
+
+                std::vector<int> heap(rd.begin(), rd.begin() + n);
+                ttl::make_heap(par, heap.begin(), heap.end());
+                assert(ttl::is_heap(heap.begin(), heap.end()));
+                ttl::make_heap<4>(par, heap.begin(), heap.end(), std::greater<>());
+                assert(ttl::is_heap<4>(heap.begin(), heap.end(), std::greater<>()));
+
+                std::vector<int> sorted(rd.begin(), rd.begin() + n);
+                std::sort(sorted.begin(), sorted.end());
+                ttl::vector<int> ts(rd.begin(), rd.begin() + n);
+                ttl::sort(par, ts.begin(), ts.end());
+                same(sorted, ts);
+                ttl::deque<int> td(rd.begin(), rd.begin() + n);
+                ttl::sort(par_unseq, td.begin(), td.end(), std::greater<>());
+                std::reverse(sorted.begin(), sorted.end());
+                same(sorted, td);
+            }
+            // 非随机访问迭代器顺序执行
+            ttl::list<int> tl(rd.begin(), rd.begin() + 1000);
+            ttl::for_each(par, tl.begin(), tl.end(), [](int &x) { x = 1; });
+            assert(ttl::reduce(par, tl.begin(), tl.end()) == 1000);
+            // 字符串排序
+            auto rs = randStrArray(300000, 4);
+            std::vector<std::string> ss = rs;
+            std::sort(ss.begin(), ss.end());
+            ttl::sort(par, rs.begin(), rs.end());
+            assert(ss == rs);
+        }
+
+        // 浮点reduce的结果与线程数无关 , sort在大量重复值上的正确性
+        static void test2() {
+            std::vector<double> dv(3000017);
+            auto rd = randIntArray(int(dv.size()));
+            for (size_t i = 0; i < dv.size(); ++i) dv[i] = rd[i] / (rd[(i + 1) % dv.size()] + 1.0);
+            ttl::thread_pool single(1);
+            double expect = ttl::reduce(ttl::execution::par.on(single), dv.begin(), dv.end(), 0.0);
+            for (size_t threads: {2, 3, 4, 8}) {
+                ttl::thread_pool pool(threads);
+                double got = ttl::reduce(ttl::execution::par.on(pool), dv.begin(), dv.end(), 0.0);
+                assert(got == expect);
+                std::vector<int> dup(rd.begin(), rd.end());
+                for (auto &x: dup) x %= 3;
+                std::vector<int> sdup = dup;
+                std::sort(sdup.begin(), sdup.end());
+                ttl::sort(ttl::execution::par.on(pool), dup.begin(), dup.end());
+                assert(sdup == dup);
+            }
+        }
+
+        // 元素函数抛出的异常在调用线程重新抛出 , 在并行算法中嵌套调用并行算法
+        static void test3() {
+            ttl::thread_pool pool(3);
+            auto par = ttl::execution::par.on(pool);
+            ttl::vector<int> tv(size_t(1) << 20, 1);
+            bool caught = false;
+            try {
+                ttl::for_each(par, tv.begin(), tv.end(), [&tv](int &x) {
+                    if (&x == &tv[700000]) throw std::runtime_error("element");
+                });
+            } catch (const std::runtime_error &) {
+                caught = true;
+            }
+            assert(caught);
+            ttl::vector<ttl::vector<int>> rows(size_t(64), ttl::vector<int>(size_t(1) << 16, 1));
+            std::atomic<size_t> total{0};
+            ttl::for_each(par, rows.begin(), rows.end(), [&](ttl::vector<int> &row) {
+                total += ttl::reduce(par, row.begin(), row.end(), size_t(0));
+            });
+            assert(total == size_t(64) << 16);
+        }
+
+        // 1..N个线程相对顺序执行的加速比
+        static void test4(int n) {
+            auto rd = randIntArray(n);
+            ttl::vector<int> tv(rd.begin(), rd.end()), out(n);
+            auto odd = [](int x) { return x % 2 != 0; };
+            auto half = [](int x) { return x / 2; };
+            auto negative = [](int x) { return x < 0; };
+            std::string suffix = " n=" + std::to_string(n);
+            long long s_sum = 0, p_sum = 0;
+            size_t s_count = 0, p_count = 0, s_found = 0, p_found = 0;
+            bool s_equal = false, p_equal = false;
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        ttl::for_each(tv.begin(), tv.end(), [](int &x) { x ^= 1; });
+                    },
+                    {
+                        ttl::for_each(ttl::execution::par.on(pool), tv.begin(), tv.end(), [](int &x) { x ^= 1; });
+                    }, ("for_each" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        ttl::transform(tv.begin(), tv.end(), out.begin(), half);
+                    },
+                    {
+                        ttl::transform(ttl::execution::par.on(pool), tv.begin(), tv.end(), out.begin(), half);
+                    }, ("transform" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        s_sum = ttl::reduce(tv.begin(), tv.end(), 0ll);
+                    },
+                    {
+                        p_sum = ttl::reduce(ttl::execution::par.on(pool), tv.begin(), tv.end(), 0ll);
+                    }, ("reduce" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        ttl::copy(tv.begin(), tv.end(), out.begin());
+                    },
+                    {
+                        ttl::copy(ttl::execution::par.on(pool), tv.begin(), tv.end(), out.begin());
+                    }, ("copy" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        ttl::fill(out.begin(), out.end(), 1);
+                    },
+                    {
+                        ttl::fill(ttl::execution::par.on(pool), out.begin(), out.end(), 1);
+                    }, ("fill" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        s_count = ttl::count_if(tv.begin(), tv.end(), odd);
+                    },
+                    {
+                        p_count = ttl::count_if(ttl::execution::par.on(pool), tv.begin(), tv.end(), odd);
+                    }, ("count_if" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        s_found = ttl::find_if(tv.begin(), tv.end(), negative) - tv.begin();
+                    },
+                    {
+                        p_found = ttl::find_if(ttl::execution::par.on(pool), tv.begin(), tv.end(), negative) - tv.begin();
+                    }, ("find_if" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {
+                        ttl::copy(tv.begin(), tv.end(), out.begin());
+                    },
+                    {
+                        s_equal = ttl::equal(tv.begin(), tv.end(), out.begin());
+                    },
+                    {
+                        p_equal = ttl::equal(ttl::execution::par.on(pool), tv.begin(), tv.end(), out.begin());
+                    }, ("equal" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {
+                        ttl::copy(rd.begin(), rd.end(), out.begin());
+                    },
+                    {
+                        ttl::make_heap(out.begin(), out.end());
+                    },
+                    {
+                        ttl::make_heap(ttl::execution::par.on(pool), out.begin(), out.end());
+                    }, ("make_heap" + suffix).c_str()
+            );
+            TTL_PARALLEL_COMPARE(
+                    {
+                        ttl::copy(rd.begin(), rd.end(), out.begin());
+                    },
+                    {
+                        ttl::sort(out.begin(), out.end());
+                    },
+                    {
+                        ttl::sort(ttl::execution::par.on(pool), out.begin(), out.end());
+                    }, ("sort" + suffix).c_str()
+            );
+            assert(std::is_sorted(out.data(), out.data() + n));
+            assert(s_sum == p_sum && s_count == p_count && s_found == p_found && s_equal && p_equal);
+        }
+    };
+
+}
+
+#endif //TINYSTL_EXECUTION_TEST_H
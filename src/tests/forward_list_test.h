@@ -0,0 +1,117 @@
+﻿#ifndef TINYSTL_FORWARD_LIST_TEST_H
+#define TINYSTL_FORWARD_LIST_TEST_H
+
+#include "../container/forward_list.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <forward_list>
+
+namespace ttl::ttl_test {
+    class forward_list_test {
+        static_assert(sizeof(ttl::forward_list<int>) == sizeof(void *));
+        static_assert(sizeof(ttl::forward_list<int, ttl::pool_allocator<int>>) == sizeof(void *));
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4();
+            test5();
+        }
+
+    private:
+        static void test1() {
+            auto rd = randStrArray(10000, 10);
+            ttl::forward_list<std::string> tl;
+            std::forward_list<std::string> sl;
+            TTL_STL_COMPARE(tl, sl, {
+                v.assign(rd.begin(), rd.end());
+                v.insert_after(ttl::next(v.begin(), 3), size_t(50000), "world");
+                v.insert_after(ttl::next(v.begin(), 3000), rd.begin(), rd.end());
+                v.erase_after(ttl::next(v.begin(), 5), ttl::next(v.begin(), 5000));
+                for (auto &s: rd) if (s[0] == 'a') v.emplace_front(s); else if (s[0] == 'b') v.pop_front();
+                v.resize(30000);
+                v.resize(40000, "x");
+                v.assign(size_t(20000), "y");
+            }, "forward_list insert & erase");
+            same(sl, tl);
+        }
+
+        static void test2() {
+            auto rd = randStrArray(100000, 10);
+            ttl::forward_list<std::string> ta(rd.begin(), rd.end()), ta2(rd.begin(), rd.end());
+            std::forward_list<std::string> sa(rd.begin(), rd.end()), sa2(rd.begin(), rd.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ta.splice_after(ttl::next(ta.begin(), 333), ta2, ttl::next(ta2.begin(), 1234), ttl::next(ta2.begin(), 4321));
+                        ta.splice_after(ta.before_begin(), ta2, ta2.begin());
+                        ta2.splice_after(ta2.before_begin(), ta, ttl::next(ta.begin(), 5), ttl::next(ta.begin(), 50));
+                        ta.splice_after(ta.before_begin(), ta2);
+                    },
+                    {
+                        sa.splice_after(ttl::next(sa.begin(), 333), sa2, ttl::next(sa2.begin(), 1234), ttl::next(sa2.begin(), 4321));
+                        sa.splice_after(sa.before_begin(), sa2, sa2.begin());
+                        sa2.splice_after(sa2.before_begin(), sa, ttl::next(sa.begin(), 5), ttl::next(sa.begin(), 50));
+                        sa.splice_after(sa.before_begin(), sa2);
+                    }, "forward_list splice"
+            );
+            same(sa, ta);
+            same(sa2, ta2);
+        }
+
+        static void test3() {
+            auto rd = randStrArray(100000, 1);
+            std::forward_list<std::string> sa(rd.begin(), rd.end());
+            ttl::forward_list<std::string> ta(rd.begin(), rd.end());
+            TTL_STL_COMPARE(ta, sa, {
+                v.remove(v.front()); // value引用链表内元素
+                v.remove_if([](const std::string &s) { return s[0] < 'f'; });
+                v.unique();
+                for (int i = 0; i < 11; ++i) v.reverse();
+            }, "forward_list remove & reverse");
+            same(sa, ta);
+        }
+
+        static void test4() {
+            auto rd = randIntArray(1000000);
+            std::forward_list<int> sa(rd.begin(), rd.end());
+            ttl::forward_list<int> ta(rd.begin(), rd.end());
+            TTL_STL_COMPARE(ta, sa, {
+                v.sort();
+            }, "forward_list sort");
+            same(sa, ta);
+            auto rd2 = randIntArray(1000000);
+            std::forward_list<int> sb(rd2.begin(), rd2.end());
+            ttl::forward_list<int> tb(rd2.begin(), rd2.end());
+            sb.sort(), tb.sort();
+            TTL_STL_COMPARE_2(
+                    {
+                        ta.merge(tb);
+                    },
+                    {
+                        sa.merge(sb);
+                    }, "forward_list merge"
+            );
+            same(sa, ta);
+            assert(tb.empty());
+        }
+
+        // 结点池 : 频繁插入删除小结点
+        static void test5() {
+            const int n = 1000000;
+            auto rd = randIntArray(n);
+            ttl::forward_list<int, ttl::pool_allocator<int>> tl;
+            std::forward_list<int> sl;
+            TTL_STL_COMPARE(tl, sl, {
+                for (int r = 0; r < 5; ++r) {
+                    for (auto x: rd) v.push_front(x);
+                    for (int i = 0; i < n; ++i) v.pop_front();
+                }
+                v.assign(rd.begin(), rd.end());
+            }, "forward_list pool churn");
+            same(sl, tl);
+        }
+    };
+}
+
+#endif //TINYSTL_FORWARD_LIST_TEST_H
@@ -0,0 +1,149 @@
+﻿#ifndef TINYSTL_INDEXED_PRIORITY_QUEUE_TEST_H
+#define TINYSTL_INDEXED_PRIORITY_QUEUE_TEST_H
+
+#include "../adapter/indexed_priority_queue.h"
+#include "../adapter/priority_queue.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <map>
+#include <set>
+
+namespace ttl::ttl_test {
+
+    class indexed_priority_queue_test {
+        template<typename Key>
+        using dense_queue = ttl::indexed_priority_queue<Key, int, std::less<int>, std::hash<Key>, 4, true>;
+
+    public:
+        static void runAll() {
+            test1(ttl::indexed_priority_queue<int, int>(), [](int x) { return x; });
+            test1(ttl::indexed_priority_queue<std::string, int>(), [](int x) { return std::to_string(x); });
+            test1(dense_queue<int>(20000), [](int x) { return x; });
+            test1(ttl::indexed_priority_queue<long long, int>(), [](int x) { return (x % 2 ? -1 : 1) * ((long long) x << 40); });
+            test2();
+            test3();
+        }
+
+    private:
+        // 与std::map + std::set比较随机的push/update/erase/pop
+        template<typename Queue, typename MakeKey>
+        static void test1(Queue tq, MakeKey make_key) {
+            using Key = typename Queue::key_type;
+            const int n = 100000;
+            auto rd = randIntArray(n * 2);
+            std::map<Key, int> prio;
+            std::set<std::pair<int, Key>> order;
+            for (int i = 0; i < n; ++i) {
+                Key key = make_key(rd[i] % 20000);
+                int p = rd[i + n] % 100000, op = rd[i + n] % 5;
+                auto it = prio.find(key);
+                if (op == 0 && it != prio.end()) {
+                    assert(tq.erase(key));
+                    order.erase({it->second, key}), prio.erase(it);
+                } else if (op == 1 && !order.empty()) {
+                    assert(tq.top().second == order.rbegin()->first);
+                    prio.erase(tq.top().first), order.erase({tq.top().second, tq.top().first});
+                    tq.pop();
+                } else if (it != prio.end()) {
+                    tq.update(key, p);
+                    order.erase({it->second, key}), order.insert({p, key}), it->second = p;
+                } else {
+                    assert(tq.push(key, p) && !tq.push(key, p + 1));
+                    order.insert({p, key}), prio[key] = p;
+                }
+                assert(tq.size() == prio.size());
+            }
+            for (auto &kv: prio) assert(tq.contains(kv.first) && tq.priority(kv.first) == kv.second);
+            std::vector<int> ta, sa;
+            while (!tq.empty()) ta.push_back(tq.poll().second);
+            for (auto it = order.rbegin(); it != order.rend(); ++it) sa.push_back(it->first);
+            assert(ta == sa);
+        }
+
+        // 最短路 : 索引优先队列(decrease-key) vs 可重复插入并在pop时过滤过期项
+        static void test2() {
+            const int n = 100000, m = 1000000;
+            auto rd = randIntArray(m * 2);
+            // CSR格式的随机图
+            std::vector<int> offset(n + 1), to(m), weight(m);
+            for (int i = 0; i < m; ++i) ++offset[rd[i] % n + 1];
+            for (int i = 0; i < n; ++i) offset[i + 1] += offset[i];
+            std::vector<int> fill(offset.begin(), offset.end() - 1);
+            for (int i = 0; i < m; ++i) {
+                int e = fill[rd[i] % n]++;
+                to[e] = rd[i + m] % n, weight[e] = rd[i + m] / n % 1000 + 1;
+            }
+            const long long inf = std::numeric_limits<long long>::max();
+            std::vector<long long> t_dist(n, inf), s_dist(n, inf);
+            size_t lazy_peak = 0, indexed_peak = 0;
+            using item = std::pair<long long, int>;
+            using lazy_queue = ttl::priority_queue<item, ttl::vector<item>, std::greater<>>;
+            using indexed_queue = ttl::indexed_priority_queue<int, long long, std::greater<>, std::hash<int>, 4, true>;
+            TTL_STL_COMPARE_2(
+                    {
+                        indexed_queue q(n);
+                        q.reserve(n);
+                        t_dist[0] = 0;
+                        q.push(0, 0);
+                        while (!q.empty()) {
+                            int u = q.top().first;
+                            q.pop();
+                            for (int e = offset[u]; e < offset[u + 1]; ++e) {
+                                long long d = t_dist[u] + weight[e];
+                                int v = to[e];
+                                if (d < t_dist[v]) {
+                                    t_dist[v] = d;
+                                    q.push_or_update(v, d);
+                                }
+                            }
+                            indexed_peak = std::max(indexed_peak, q.size());
+                        }
+                    },
+                    {
+                        lazy_queue q;
+                        s_dist[0] = 0;
+                        q.push(item(0, 0));
+                        while (!q.empty()) {
+                            item top = q.poll();
+                            int u = top.second;
+                            if (top.first != s_dist[u]) continue; // 过期项
+                            for (int e = offset[u]; e < offset[u + 1]; ++e) {
+                                long long d = s_dist[u] + weight[e];
+                                int v = to[e];
+                                if (d < s_dist[v]) {
+                                    s_dist[v] = d;
+                                    q.push(item(d, v));
+                                }
+                            }
+                            lazy_peak = std::max(lazy_peak, q.size());
+                        }
+                    }, "dijkstra indexed vs lazy"
+            );
+            printf("heap peak : lazy %zu , indexed %zu\n", lazy_peak, indexed_peak);
+            assert(t_dist == s_dist);
+        }
+
+        // 稠密映射拒绝[0,bound)以外的key且不修改队列 , 默认的哈希映射接受任意整数key
+        static void test3() {
+            dense_queue<int> dq(100);
+            assert(dq.push(0, 1) && dq.push(99, 2));
+            for (int key: {-1, 100, INT32_MAX}) {
+                bool thrown = false;
+                try { dq.push(key, 3); } catch (const std::out_of_range &) { thrown = true; }
+                assert(thrown && !dq.contains(key) && !dq.erase(key));
+                thrown = false;
+                try { dq.push_or_update(key, 3); } catch (const std::out_of_range &) { thrown = true; }
+                assert(thrown);
+            }
+            assert(dq.size() == 2 && dq.top().first == 99);
+            dq.clear();
+            assert(dq.empty() && !dq.contains(0) && dq.push(0, 1));
+            ttl::indexed_priority_queue<long long, int> hq;
+            for (long long key: {-1LL, 1LL << 62, (long long) INT64_MIN}) assert(hq.push(key, int(key % 7)));
+            assert(hq.size() == 3 && hq.contains(INT64_MIN) && hq.erase(-1) && !hq.contains(-1));
+        }
+    };
+
+}
+
+#endif //TINYSTL_INDEXED_PRIORITY_QUEUE_TEST_H
@@ -0,0 +1,158 @@
+﻿#ifndef TINYSTL_INTRUSIVE_TEST_H
+#define TINYSTL_INTRUSIVE_TEST_H
+
+#include "../container/expand/intrusive_list.h"
+#include "../container/expand/intrusive_hashtable.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <list>
+#include <unordered_map>
+
+namespace ttl::ttl_test {
+
+    class intrusive_test {
+        // 同时位于LRU队列和哈希索引中的对象
+        struct entry {
+            int key = 0;
+            int value = 0;
+            intrusive_list_hook lru;
+            intrusive_hash_hook index;
+        };
+
+        struct key_of_entry {
+            const int &operator()(const entry &e) const { return e.key; }
+        };
+
+        using lru_list = ttl::intrusive_list<entry, &entry::lru>;
+        using index_table = ttl::intrusive_hashtable<entry, &entry::index, key_of_entry>;
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+        }
+
+    private:
+        static void test1() {
+            std::vector<entry> pool(10000);
+            for (int i = 0; i < 10000; ++i) pool[i].key = pool[i].value = i;
+            lru_list tl;
+            std::list<int> sl;
+            auto rd = randIntArray(100000);
+            for (auto &e: pool) tl.push_back(e), sl.push_back(e.key);
+            for (auto x: rd) {
+                auto &e = pool[x % pool.size()];
+                if (x % 3 == 0) {
+                    if (e.lru.is_linked()) tl.erase(e), sl.remove(e.key);
+                } else if (x % 3 == 1) {
+                    if (!e.lru.is_linked()) tl.push_front(e), sl.push_front(e.key);
+                } else if (e.lru.is_linked()) {
+                    tl.move_to(tl.cbegin(), e), sl.remove(e.key), sl.push_front(e.key);
+                }
+                if (x % 1000 == 0) {
+                    std::vector<int> keys;
+                    for (auto &t: tl) keys.push_back(t.key);
+                    same(sl, keys);
+                }
+            }
+            assert(tl.size() == sl.size());
+            lru_list moved(std::move(tl));
+            assert(tl.empty() && moved.size() == sl.size()); // NOLINT(bugprone-use-after-move)
+            moved.clear();
+            for (auto &e: pool) assert(!e.lru.is_linked());
+        }
+
+        static void test2() {
+            std::vector<entry> pool(100000);
+            auto rd = randIntArray(100000);
+            for (int i = 0; i < 100000; ++i) pool[i].key = rd[i] % 50000, pool[i].value = i;
+            index_table tm;
+            std::unordered_multimap<int, int> sm;
+            for (auto &e: pool) tm.insert_equal(e), sm.insert({e.key, e.value});
+            assert(tm.size() == sm.size());
+            for (int i = 0; i < 50000; i += 7) {
+                assert(tm.count(i) == sm.count(i));
+                assert(tm.erase(i) == sm.erase(i));
+            }
+            for (int i = 0; i < 100000; i += 3) {
+                auto &e = pool[i];
+                if (!e.index.is_linked()) continue;
+                tm.erase(e);
+                auto range = sm.equal_range(e.key);
+                for (auto it = range.first; it != range.second; ++it) {
+                    if (it->second == e.value) {
+                        sm.erase(it);
+                        break;
+                    }
+                }
+            }
+            std::unordered_multimap<int, int> tmp;
+            for (auto &e: tm) tmp.insert({e.key, e.value});
+            assert(tmp == sm);
+        }
+
+        // LRU缓存 : 侵入式list+hashtable vs std::list+std::unordered_map
+        static void test3() {
+            const int cap = 10000, n = 1000000;
+            auto rd = randIntArray(n);
+            std::vector<entry> pool(cap);
+            using std_list = std::list<std::pair<int, int>>;
+            using std_index = std::unordered_map<int, std_list::iterator>;
+            long long t_hit = 0, s_hit = 0;
+            TTL_STL_COMPARE_2(
+                    {
+                        lru_list queue;
+                        index_table index;
+                        index.reserve(cap);
+                        size_t used = 0;
+                        for (auto x: rd) {
+                            int key = x % (cap * 2);
+                            auto it = index.find(key);
+                            if (it != index.end()) {
+                                ++t_hit;
+                                queue.move_to(queue.cbegin(), *it);
+                                continue;
+                            }
+                            entry *e;
+                            if (used < pool.size()) {
+                                e = &pool[used++];
+                            } else { // 淘汰最久未使用的对象并复用
+                                e = &queue.back();
+                                queue.erase(*e);
+                                index.erase(*e);
+                            }
+                            e->key = key;
+                            e->value = x;
+                            queue.push_front(*e);
+                            index.insert_unique(*e);
+                        }
+                    },
+                    {
+                        std_list queue;
+                        std_index index;
+                        index.reserve(cap);
+                        for (auto x: rd) {
+                            int key = x % (cap * 2);
+                            auto it = index.find(key);
+                            if (it != index.end()) {
+                                ++s_hit;
+                                queue.splice(queue.begin(), queue, it->second);
+                                continue;
+                            }
+                            if (queue.size() == cap) {
+                                index.erase(queue.back().first);
+                                queue.pop_back();
+                            }
+                            queue.emplace_front(key, x);
+                            index[key] = queue.begin();
+                        }
+                    }, "intrusive lru"
+            );
+            assert(t_hit == s_hit);
+        }
+    };
+
+}
+
+#endif //TINYSTL_INTRUSIVE_TEST_H
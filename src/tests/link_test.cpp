@@ -0,0 +1,35 @@
+﻿// 第二个翻译单元 , 与main.cpp一起链接
+// 头文件中的非模板函数和变量必须是inline的 , 否则在这里会出现重复定义的链接错误
+#include "../core/adapter/indexed_priority_queue.h"
+#include "../core/adapter/priority_queue.h"
+#include "../core/adapter/radix_heap.h"
+#include "../core/adapter/top_k.h"
+#include "../core/algorithm/algorithm.h"
+#include "../core/algorithm/bit.h"
+#include "../core/algorithm/execution.h"
+#include "../core/algorithm/radix_sort.h"
+#include "../core/algorithm/simd.h"
+#include "../core/allocator/memory.h"
+#include "../core/container/deque.h"
+#include "../core/container/expand/bitset.h"
+#include "../core/container/expand/dynamic_bitset.h"
+#include "../core/container/expand/dynamic_segment_tree.h"
+#include "../core/container/expand/fenwick_tree.h"
+#include "../core/container/expand/intrusive_hashtable.h"
+#include "../core/container/expand/intrusive_list.h"
+#include "../core/container/expand/lru_cache.h"
+#include "../core/container/expand/rank_select_bitvector.h"
+#include "../core/container/expand/roaring_bitmap.h"
+#include "../core/container/expand/segment_tree.h"
+#include "../core/container/expand/sparse_table.h"
+#include "../core/container/expand/timing_wheel.h"
+#include "../core/container/expand/union_set.h"
+#include "../core/container/expand/unrolled_list.h"
+#include "../core/container/forward_list.h"
+#include "../core/container/list.h"
+#include "../core/container/unordered_map.h"
+#include "../core/container/vector.h"
+#include "../core/iterator/iterator.h"
+#include "../core/thread/eventcount.h"
+#include "../core/thread/thread_pool.h"
+#include "../core/thread/work_stealing_deque.h"
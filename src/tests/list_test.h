@@ -6,6 +6,7 @@
 #define TINYSTL_LIST_TEST_H
 
 #include "../container/list.h"
+#include "../container/vector.h"
 #include "../utils/profiler.h"
 #include "../utils/test_helper.h"
 #include <list>
@@ -23,6 +24,8 @@ namespace ttl::ttl_test {
             test6();
             test7();
             test8();
+            test9();
+            test10();
         }
 
     private:
@@ -115,6 +118,47 @@ namespace ttl::ttl_test {
             }, "list sort");
             same(sa, ta);
         }
+
+        static void test9() {
+            auto rd = randStrArray(100000, 1);
+            std::list<std::string> sa(rd.begin(), rd.end());
+            ttl::list<std::string> ta(rd.begin(), rd.end());
+            TTL_STL_COMPARE(ta, sa, {
+                v.remove(v.front()); // value引用链表内元素
+                v.remove_if([](const std::string &s) { return s[0] < 'f'; });
+                v.unique();
+                v.unique([](const std::string &a, const std::string &b) { return b[0] - a[0] < 3; });
+            }, "list remove & unique");
+            same(sa, ta);
+            assert(ta.size() == sa.size());
+        }
+
+        // 排序的稳定性 , 以及与复制到vector排序后重建的对比
+        static void test10() {
+            const int n = 1000000;
+            auto rd = randIntArray(n);
+            using item = std::pair<int, int>;
+            std::vector<item> items;
+            for (int i = 0; i < n; ++i) items.emplace_back(rd[i] % 1000, i);
+            auto by_first = [](const item &a, const item &b) { return a.first < b.first; };
+            ttl::list<item> ta(items.begin(), items.end()), tv(items.begin(), items.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ta.sort(by_first);
+                    },
+                    {
+                        ttl::vector<item> buf(tv.begin(), tv.end());
+                        std::stable_sort(buf.data(), buf.data() + buf.size(), by_first);
+                        tv.assign(buf.begin(), buf.end());
+                    }, "list sort vs vector sort"
+            );
+            std::stable_sort(items.begin(), items.end(), by_first);
+            same(items, ta);
+            same(items, tv);
+            std::vector<item> back;
+            for (auto it = ta.rbegin(); it != ta.rend(); ++it) back.push_back(*it);
+            assert(std::equal(back.rbegin(), back.rend(), items.begin()));
+        }
     };
 }
 
@@ -6,6 +6,7 @@
 #define TINYSTL_PRIORITY_QUEUE_TEST_H
 
 #include "../adapter/priority_queue.h"
+#include "../adapter/radix_heap.h"
 #include "../utils/profiler.h"
 #include "../utils/test_helper.h"
 #include <queue>
@@ -13,9 +14,19 @@
 namespace ttl::ttl_test {
 
     class priority_queue_test {
-        template<typename T>
+        // 64字节的元素
+        struct big_item {
+            long long key;
+            char pad[56]{};
+
+            bool operator<(const big_item &rhs) const { return key < rhs.key; }
+
+            bool operator==(const big_item &rhs) const { return key == rhs.key; }
+        };
+
+        template<typename T, typename Container, typename Compare, size_t D>
         static void pq_same(
-                ttl::priority_queue<T> tq,
+                ttl::priority_queue<T, Container, Compare, D> tq,
                 std::priority_queue<T> sq) {
             std::vector<T> ta, tb;
             while (!tq.empty()) ta.push_back(tq.top()), tq.pop();
@@ -32,6 +43,15 @@ namespace ttl::ttl_test {
 
             test1();
             test2();
+            test3();
+            test4<2>();
+            test4<4>();
+            test4<8>();
+            test5<2>();
+            test5<4>();
+            test5<8>();
+            test6();
+            test7();
         }
 
     private:
@@ -55,6 +75,114 @@ namespace ttl::ttl_test {
             }, "pq insert & pop");
             pq_same(tq, sq);
         }
+
+        // D叉堆的算法正确性
+        static void test3() {
+            std::vector<int> rd = randIntArray(100000);
+            for (auto &x: rd) x %= 1000;
+            auto check = [&](auto tag) {
+                constexpr size_t D = decltype(tag)::value;
+                std::vector<int> a(rd.begin(), rd.begin() + 50000), b = rd;
+                ttl::make_heap<D>(a.begin(), a.end());
+                assert(ttl::is_heap<D>(a.begin(), a.end()));
+                for (size_t i = 50000; i < rd.size(); ++i) {
+                    a.push_back(rd[i]), ttl::push_heap<D>(a.begin(), a.end());
+                }
+                assert(ttl::is_heap<D>(a.begin(), a.end()));
+                ttl::sort_heap<D>(a.begin(), a.end(), std::less<>());
+                std::sort(b.begin(), b.end());
+                assert(a == b);
+                std::vector<int> c = {9, 5, 4, 3, 8};
+                assert(ttl::is_heap_until<D>(c.begin(), c.end()) == c.begin() + (D == 2 ? 4 : 5));
+            };
+            check(std::integral_constant<size_t, 2>());
+            check(std::integral_constant<size_t, 4>());
+            check(std::integral_constant<size_t, 8>());
+        }
+
+        template<size_t D>
+        static void test4() {
+            const int n = 1000000;
+            ttl::priority_queue<int, ttl::vector<int>, std::less<>, D> tq;
+            std::priority_queue<int> sq;
+            std::vector<int> rd = randIntArray(n);
+            std::string name = "pq int D=" + std::to_string(D);
+            TTL_STL_COMPARE(tq, sq, {
+                for (auto x: rd) v.push(x);
+                for (int i = 0; i < n / 2; ++i) v.pop();
+            }, name.c_str());
+            pq_same(tq, sq);
+        }
+
+        template<size_t D>
+        static void test5() {
+            const int n = 1000000;
+            ttl::priority_queue<big_item, ttl::vector<big_item>, std::less<>, D> tq;
+            std::priority_queue<big_item> sq;
+            std::vector<int> rd = randIntArray(n);
+            std::string name = "pq 64B D=" + std::to_string(D);
+            TTL_STL_COMPARE(tq, sq, {
+                for (auto x: rd) v.push(big_item{x});
+                for (int i = 0; i < n / 2; ++i) v.pop();
+            }, name.c_str());
+            pq_same(tq, sq);
+        }
+
+        // 基数堆 : 单调的随机push/pop , 包括有符号key
+        static void test6() {
+            const int n = 200000;
+            std::vector<int> rd = randIntArray(n * 2);
+            ttl::radix_heap<int, int> th;
+            std::priority_queue<int, std::vector<int>, std::greater<>> sq;
+            int now = -1000000;
+            for (int i = 0; i < n; ++i) {
+                if (rd[i] % 3 == 0 && !sq.empty()) {
+                    assert(th.top().first == sq.top());
+                    now = th.poll().first, sq.pop();
+                    assert(th.last_key() == now);
+                } else {
+                    int key = now + rd[i + n] % (rd[i] % 2 ? 100 : 1000000);
+                    th.emplace(key, i), sq.push(key);
+                }
+                assert(th.size() == sq.size());
+            }
+            while (!sq.empty()) assert(th.top().first == sq.top()), th.pop(), sq.pop();
+            assert(th.empty());
+            bool thrown = false;
+            try { th.emplace(now - 1, 0); } catch (std::out_of_range &) { thrown = true; }
+            assert(thrown);
+        }
+
+        // 事件模拟 : 每次取出最早的事件并在其之后产生一个新事件 , 基数堆 vs 二叉堆
+        static void test7() {
+            const int n = 1000000, m = 5000000;
+            std::vector<int> rd = randIntArray(n + m);
+            using item = std::pair<unsigned, int>;
+            using radix_queue = ttl::radix_heap<unsigned, int>;
+            using binary_queue = ttl::priority_queue<item, ttl::vector<item>, std::greater<>>;
+            long long t_sum = 0, s_sum = 0;
+            TTL_STL_COMPARE_2(
+                    {
+                        radix_queue q;
+                        for (int i = 0; i < n; ++i) q.emplace(unsigned(rd[i] % 1000000), i);
+                        for (int i = n; i < n + m; ++i) {
+                            item e = q.poll();
+                            t_sum += e.first;
+                            q.emplace(e.first + rd[i] % 1000000, e.second);
+                        }
+                    },
+                    {
+                        binary_queue q;
+                        for (int i = 0; i < n; ++i) q.emplace(unsigned(rd[i] % 1000000), i);
+                        for (int i = n; i < n + m; ++i) {
+                            item e = q.poll();
+                            s_sum += e.first;
+                            q.emplace(e.first + rd[i] % 1000000, e.second);
+                        }
+                    }, "radix heap vs pq"
+            );
+            assert(t_sum == s_sum);
+        }
     };
 
 }
@@ -0,0 +1,143 @@
+﻿#ifndef TINYSTL_RADIX_SORT_TEST_H
+#define TINYSTL_RADIX_SORT_TEST_H
+
+#include "../algorithm/radix_sort.h"
+#include "../container/vector.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+
+namespace ttl::ttl_test {
+
+    class radix_sort_test {
+        using item = std::pair<uint64_t, uint32_t>;
+
+        struct key_of_item {
+            uint64_t operator()(const item &x) const { return x.first; }
+        };
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3(1000000);
+            test3(10000000);
+            test4();
+        }
+
+    private:
+        // 有符号整数 , 浮点数 , 只有低字节不同的key , 以及键值对的稳定性
+        static void test1() {
+            auto rd = randIntArray(200000);
+            for (int n: {0, 1, 2, 1000, 200000}) {
+                std::vector<int> sa(rd.begin(), rd.begin() + n);
+                for (int i = 0; i < n; i += 2) sa[i] = -sa[i];
+                ttl::vector<int> ta(sa.begin(), sa.end());
+                std::sort(sa.begin(), sa.end());
+                ttl::radix_sort(ta.begin(), ta.end());
+                same(sa, ta);
+
+                std::vector<double> sd(n);
+                for (int i = 0; i < n; ++i) sd[i] = (rd[i] % 2 ? -1.0 : 1.0) * rd[i] / (rd[(i + 1) % n] + 1.0);
+                std::vector<double> td = sd;
+                std::sort(sd.begin(), sd.end());
+                ttl::radix_sort(td.data(), td.data() + n);
+                assert(sd == td);
+
+                std::vector<float> sf(sd.begin(), sd.end()), tf = sf;
+                std::sort(sf.begin(), sf.end());
+                ttl::radix_sort(tf.begin(), tf.end());
+                assert(sf == tf);
+
+                // 只有最低字节不同 , 其余字节的趟被跳过 ; 使用调用者提供的缓冲区
+                std::vector<item> si(n);
+                for (int i = 0; i < n; ++i) si[i] = {0x1234567800000000ull | (rd[i] & 0xff), uint32_t(i)};
+                std::vector<item> ti = si, scratch(n);
+                std::stable_sort(si.begin(), si.end(), [](const item &a, const item &b) { return a.first < b.first; });
+                ttl::radix_sort(ti.data(), ti.data() + n, key_of_item(), scratch.data());
+                assert(si == ti);
+            }
+        }
+
+        // 字符串MSD , 包括公共前缀与空串
+        static void test2() {
+            for (int len: {1, 3, 20}) {
+                auto ss = randStrArray(100000, len);
+                for (size_t i = 0; i < ss.size(); i += 3) ss[i] = "prefix" + ss[i].substr(0, i % len);
+                ss.emplace_back(), ss.emplace_back();
+                ttl::vector<std::string> ts(ss.begin(), ss.end());
+                std::sort(ss.begin(), ss.end());
+                ttl::radix_sort(ts.begin(), ts.end());
+                same(ss, ts);
+            }
+        }
+
+        // radix_sort vs std::sort / ttl::sort
+        static void test3(int n) {
+            std::string suffix = " n=" + std::to_string(n);
+            auto rd = randIntArray(n);
+            auto rd2 = randIntArray(n);
+            std::vector<uint32_t> s32(rd.begin(), rd.end());
+            ttl::vector<uint32_t> t32(rd.begin(), rd.end()), r32 = t32, u32 = t32;
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::radix_sort(t32.begin(), t32.end());
+                    },
+                    {
+                        std::sort(s32.begin(), s32.end());
+                    }, ("radix vs std u32" + suffix).c_str()
+            );
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::radix_sort(r32.begin(), r32.end());
+                    },
+                    {
+                        ttl::sort(u32.begin(), u32.end());
+                    }, ("radix vs ttl u32" + suffix).c_str()
+            );
+            same(s32, t32), same(s32, r32), same(s32, u32);
+            std::vector<uint64_t> s64(n);
+            for (int i = 0; i < n; ++i) s64[i] = uint64_t(rd[i]) << 32 | uint64_t(rd2[i]);
+            ttl::vector<uint64_t> t64(s64.begin(), s64.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::radix_sort(t64.begin(), t64.end());
+                    },
+                    {
+                        std::sort(s64.begin(), s64.end());
+                    }, ("radix vs std u64" + suffix).c_str()
+            );
+            same(s64, t64);
+            std::vector<item> si(n);
+            for (int i = 0; i < n; ++i) si[i] = {s64[(i * 7919ll) % n], uint32_t(i)};
+            ttl::vector<item> ti(si.begin(), si.end());
+            auto by_key = [](const item &a, const item &b) { return a.first < b.first; };
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::radix_sort(ti.begin(), ti.end(), key_of_item());
+                    },
+                    {
+                        std::stable_sort(si.begin(), si.end(), by_key);
+                    }, ("radix vs std kv" + suffix).c_str()
+            );
+            same(si, ti);
+        }
+
+        static void test4() {
+            auto ss = randStrArray(1000000, 10);
+            ttl::vector<std::string> ts(ss.begin(), ss.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::radix_sort(ts.begin(), ts.end());
+                    },
+                    {
+                        std::sort(ss.begin(), ss.end());
+                    }, "radix vs std string"
+            );
+            same(ss, ts);
+        }
+    };
+
+}
+
+#endif //TINYSTL_RADIX_SORT_TEST_H
@@ -0,0 +1,106 @@
+﻿#ifndef TINYSTL_RANK_SELECT_BITVECTOR_TEST_H
+#define TINYSTL_RANK_SELECT_BITVECTOR_TEST_H
+
+#include "../container/expand/rank_select_bitvector.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <random>
+#include <vector>
+
+namespace ttl::ttl_test {
+
+    class rank_select_bitvector_test {
+        // 逐位计算的前缀和与1的位置对拍
+        static void rs_same(const ttl::rank_select_bitvector &rs, const ttl::dynamic_bitset &bs) {
+            assert(rs.size() == bs.size() && rs.bitvector() == bs);
+            size_t ones = 0;
+            for (size_t i = 0; i < bs.size(); ++i) {
+                if (rs.rank1(i) != ones || rs.rank0(i) != i - ones) assert(false);
+                if (bs[i]) {
+                    if (rs.select1(ones) != i) assert(false);
+                    ++ones;
+                }
+            }
+            assert(rs.rank1(bs.size()) == ones && rs.count() == ones);
+            bool caught = false;
+            try { (void)rs.select1(ones); } catch (const std::out_of_range &) { caught = true; }
+            assert(caught);
+        }
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+        }
+
+    private:
+        // 不同长度与密度 , 覆盖子块/块边界和全0/全1
+        static void test1() {
+            for (size_t n: {0, 1, 63, 64, 511, 512, 2047, 2048, 2049, 10000, (1 << 20) + 5}) {
+                for (int density: {0, 1, 2, 100, 5000}) {
+                    ttl::dynamic_bitset bs(n);
+                    for (size_t i = 0; i < n; ++i) if (density && randInt(density) == 0) bs.set(i);
+                    ttl::rank_select_bitvector rs(bs);
+                    rs_same(rs, bs);
+                    if (n >= 1 << 20) assert(rs.index_bytes() * 100 < n / 8 * 4);
+                }
+            }
+            ttl::bitset<3000> fixed;
+            for (int i = 0; i < 3000; i += randInt(1, 10)) fixed.set(i);
+            ttl::rank_select_bitvector rs(fixed);
+            ttl::dynamic_bitset bs(3000);
+            fixed.for_each_set([&bs](size_t i) { bs.set(i); });
+            rs_same(rs, bs);
+            rs_same(ttl::rank_select_bitvector(std::move(bs)), rs.bitvector());
+            rs_same(ttl::rank_select_bitvector(), ttl::dynamic_bitset());
+        }
+
+        // 字内select与逐位扫描对拍
+        static void test2() {
+            std::mt19937_64 gen(7);
+            for (int round = 0; round < 100000; ++round) {
+                uint64_t x = gen();
+                if (round % 3 == 1) x &= gen();
+                if (round % 3 == 2) x &= gen() & gen() & gen();
+                for (int k = 0, i = 0; i < 64; ++i) {
+                    if (x >> i & 1) {
+                        if (ttl::bit_select(x, k) != i) assert(false);
+                        ++k;
+                    }
+                }
+            }
+            assert(ttl::bit_select(uint64_t(1) << 63, 0) == 63 && ttl::bit_select(~uint64_t(0), 63) == 63);
+            assert(ttl::bit_select(uint32_t(0x80000001u), 1) == 31);
+        }
+
+        // 10^9位随机位向量上的rank/select , 报告每次查询的耗时与索引开销
+        static void test3() {
+            const size_t n = 1000000000, queries = 10000000;
+            std::mt19937_64 gen(1);
+            ttl::dynamic_bitset bs;
+            bs.reserve(n);
+            for (size_t i = 0; i < n / 64; ++i) bs.append(gen());
+            free_timer timer;
+            timer.start();
+            ttl::rank_select_bitvector rs(std::move(bs));
+            printf("%-30s : %.2lf ms , index %.2lf%%\n", "rank_select_bitvector build", double(timer.get_ns()) / 1e6,
+                   100.0 * double(rs.index_bytes()) / double(rs.size() / 8));
+            std::vector<size_t> pos(queries), rk(queries);
+            for (auto &x: pos) x = gen() % rs.size();
+            for (auto &x: rk) x = gen() % rs.count();
+            size_t ret = 0;
+            timer.start();
+            for (size_t x: pos) ret += rs.rank1(x);
+            printf("%-30s : %.2lf ns/op\n", "rank_select_bitvector rank1", double(timer.get_ns()) / double(queries));
+            timer.start();
+            for (size_t x: rk) ret += rs.select1(x);
+            printf("%-30s : %.2lf ns/op\n", "rank_select_bitvector select1", double(timer.get_ns()) / double(queries));
+            for (size_t i = 0; i < 1000; ++i) assert(rs.rank1(rs.select1(rk[i])) == rk[i] && rs[rs.select1(rk[i])]);
+            assert(ret != 0);
+        }
+    };
+
+}
+
+#endif //TINYSTL_RANK_SELECT_BITVECTOR_TEST_H
@@ -0,0 +1,240 @@
+﻿#ifndef TINYSTL_ROARING_BITMAP_TEST_H
+#define TINYSTL_ROARING_BITMAP_TEST_H
+
+#include "../container/expand/roaring_bitmap.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace ttl::ttl_test {
+
+    class roaring_bitmap_test {
+        using values = std::vector<uint32_t>;
+
+        static values to_values(const ttl::roaring_bitmap &rb) {
+            values ret;
+            rb.for_each([&ret](uint32_t x) { ret.push_back(x); });
+            return ret;
+        }
+
+        static uint32_t rand_u32() {
+            return uint32_t(randInt()) << 16 ^ uint32_t(randInt());
+        }
+
+        // 0 : 分散在整个值域(array容器) , 1 : 集中在几个桶中(bitset容器) , 2 : 区间(run容器) , 3 : 三者混合
+        static values make_values(int kind, size_t n) {
+            values ret;
+            if (kind == 0 || kind == 3) for (size_t i = 0; i < n; ++i) ret.push_back(rand_u32());
+            if (kind == 1 || kind == 3) for (size_t i = 0; i < n; ++i) ret.push_back(uint32_t(randInt(5 << 16)) + (7u << 16));
+            if (kind == 2 || kind == 3) {
+                for (size_t i = 0; i < n / 100 + 1; ++i) {
+                    uint32_t first = uint32_t(randInt(40 << 16)), len = uint32_t(randInt(1, 300));
+                    for (uint32_t x = first; x < first + len; ++x) ret.push_back(x);
+                }
+            }
+            std::sort(ret.begin(), ret.end());
+            ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
+            return ret;
+        }
+
+        static void rb_same(const ttl::roaring_bitmap &rb, const values &sv) {
+            assert(rb.size() == sv.size() && rb.empty() == sv.empty());
+            assert(to_values(rb) == sv);
+            for (int i = 0; i < 200 && !sv.empty(); ++i) {
+                size_t k = randInt(int(sv.size()));
+                assert(rb.select(k) == sv[k] && rb.contains(sv[k]));
+                uint32_t x = randInt(2) ? sv[k] + randInt(-3, 3) : rand_u32();
+                assert(rb.rank(x) == size_t(std::upper_bound(sv.begin(), sv.end(), x) - sv.begin()));
+                assert(rb.contains(x) == std::binary_search(sv.begin(), sv.end(), x));
+            }
+        }
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4();
+        }
+
+    private:
+        // add/remove与std::set对拍 , 容器在array与bitset之间来回转换 , 中途转为run容器
+        static void test1() {
+            ttl::roaring_bitmap rb;
+            std::set<uint32_t> ss;
+            for (int round = 0; round < 200000; ++round) {
+                uint32_t x = randInt(3) ? uint32_t(randInt(3 << 16)) : rand_u32();
+                if (round < 100000 || randInt(3) == 0) assert(rb.add(x) == ss.insert(x).second);
+                else assert(rb.remove(x) == (ss.erase(x) == 1));
+                if (round % 20000 == 0) rb_same(rb, values(ss.begin(), ss.end()));
+                if (round % 30000 == 0) rb.run_optimize();
+            }
+            rb_same(rb, values(ss.begin(), ss.end()));
+            ttl::roaring_bitmap copy = rb;
+            for (uint32_t x = 0; x < 70000; ++x) rb.add(x), ss.insert(x);
+            assert(rb.run_optimize());
+            rb_same(rb, values(ss.begin(), ss.end()));
+            assert(rb != copy && (rb & copy) == copy);
+            for (uint32_t x = 100; x < 69000; ++x) rb.remove(x), ss.erase(x);
+            rb_same(rb, values(ss.begin(), ss.end()));
+            bool caught = false;
+            try { (void)rb.select(ss.size()); } catch (const std::out_of_range &) { caught = true; }
+            assert(caught);
+            rb.clear();
+            assert(rb.empty() && rb.size() == 0 && rb.rank(uint32_t(-1)) == 0 && !rb.contains(0));
+        }
+
+        // 集合运算与只求基数的版本 , 覆盖三种容器两两组合
+        static void test2() {
+            for (int ka = 0; ka < 4; ++ka) {
+                for (int kb = 0; kb < 4; ++kb) {
+                    values a = make_values(ka, 20000), b = make_values(kb, 20000), c;
+                    ttl::roaring_bitmap ra(a.begin(), a.end()), rb(b.begin(), b.end());
+                    for (int opt = 0; opt < 4; ++opt) {
+                        if (opt & 1) ra.run_optimize();
+                        if (opt & 2) rb.run_optimize();
+                        c.clear();
+                        std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c));
+                        rb_same(ra & rb, c);
+                        assert(ra.and_count(rb) == c.size() && rb.and_count(ra) == c.size());
+                        c.clear();
+                        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c));
+                        rb_same(ra | rb, c);
+                        assert(ra.or_count(rb) == c.size());
+                        c.clear();
+                        std::set_symmetric_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c));
+                        rb_same(ra ^ rb, c);
+                        assert(ra.xor_count(rb) == c.size());
+                        c.clear();
+                        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c));
+                        rb_same(ttl::roaring_bitmap(ra).and_not(rb), c);
+                        assert(ra.and_not_count(rb) == c.size());
+                        assert((ra == rb) == (a == b) && ra == ttl::roaring_bitmap(a.begin(), a.end()));
+                    }
+                }
+            }
+            // 两个bitset容器求交后只剩少量元素 , 结果应转回array
+            ttl::roaring_bitmap even, odd;
+            for (uint32_t x = 0; x < 20000; ++x) (x % 2 ? odd : even).add(x);
+            odd.add(10000);
+            rb_same(even & odd, {10000});
+        }
+
+        // 可移植格式 : 固定的字节序列 , 往返 , 在序列化数据上直接查询 , 非法数据
+        static void test3() {
+            std::vector<char> buf;
+            auto bytes = [&buf](const ttl::roaring_bitmap &rb) {
+                buf.assign(rb.serialized_size(), 0);
+                assert(rb.serialize(buf.data()) == buf.size());
+                return std::vector<uint8_t>(buf.begin(), buf.end());
+            };
+            // cookie 12346 , 1个容器 , (键0 , 基数-1=2) , 偏移16 , 值1,2,3
+            assert(bytes({1, 2, 3}) == std::vector<uint8_t>({0x3a, 0x30, 0, 0, 1, 0, 0, 0, 0, 0, 2, 0, 16, 0, 0, 0,
+                                                             1, 0, 2, 0, 3, 0}));
+            // cookie 12347|(1-1)<<16 , run标记 , (键1 , 基数-1=99) , 容器数少于4时没有偏移表 , 1个run(5,99)
+            ttl::roaring_bitmap run;
+            for (uint32_t x = 65536 + 5; x < 65536 + 105; ++x) run.add(x);
+            run.run_optimize();
+            assert(bytes(run) == std::vector<uint8_t>({0x3b, 0x30, 0, 0, 1, 1, 0, 99, 0, 1, 0, 5, 0, 99, 0}));
+            assert(bytes(ttl::roaring_bitmap()).size() == 8);
+
+            for (int kind = 0; kind < 4; ++kind) {
+                for (size_t n: {1, 3, 5000, 30000}) {
+                    values sv = make_values(kind, n);
+                    ttl::roaring_bitmap rb(sv.begin(), sv.end());
+                    for (int opt = 0; opt < 2; ++opt) {
+                        if (opt) rb.run_optimize();
+                        bytes(rb);
+                        ttl::roaring_bitmap_view view(buf.data(), buf.size());
+                        assert(view.size() == sv.size() && view.container_count() > 0);
+                        for (int i = 0; i < 300; ++i) {
+                            size_t k = randInt(int(sv.size()));
+                            uint32_t x = randInt(2) ? sv[k] + randInt(-2, 2) : rand_u32();
+                            assert(view.contains(x) == rb.contains(x));
+                            assert(view.rank(x) == rb.rank(x));
+                            assert(view.select(k) == sv[k]);
+                        }
+                        ttl::roaring_bitmap back = ttl::roaring_bitmap::deserialize(buf.data(), buf.size());
+                        assert(back == rb);
+                        rb_same(back, sv);
+                        assert(bytes(back) == bytes(rb));
+                        // 截断的数据
+                        bool caught = false;
+                        try { ttl::roaring_bitmap_view(buf.data(), buf.size() - 1); }
+                        catch (const std::invalid_argument &) { caught = true; }
+                        assert(caught);
+                    }
+                }
+            }
+            buf.assign(16, 0);
+            bool caught = false;
+            try { ttl::roaring_bitmap_view(buf.data(), buf.size()); } catch (const std::invalid_argument &) { caught = true; }
+            assert(caught);
+        }
+
+        // 与有序数组的集合运算比较 , 稀疏(array容器)与稠密(bitset容器)两种分布
+        static void test4() {
+            for (uint32_t range: {1u << 26, 1u << 21}) {
+                values a, b, c;
+                for (int i = 0; i < 1000000; ++i) a.push_back(rand_u32() % range), b.push_back(rand_u32() % range);
+                std::sort(a.begin(), a.end()), std::sort(b.begin(), b.end());
+                a.erase(std::unique(a.begin(), a.end()), a.end());
+                b.erase(std::unique(b.begin(), b.end()), b.end());
+                ttl::roaring_bitmap ra(a.begin(), a.end()), rb(b.begin(), b.end()), rc;
+                std::string suffix = range == 1u << 26 ? " sparse" : " dense";
+                TTL_STL_COMPARE_2(
+                        rc = ra | rb,
+                        c.clear(); std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c)),
+                        ("roaring_bitmap or" + suffix).c_str()
+                );
+                assert(rc.size() == c.size());
+                TTL_STL_COMPARE_2(
+                        rc = ra & rb,
+                        c.clear(); std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(c)),
+                        ("roaring_bitmap and" + suffix).c_str()
+                );
+                assert(rc.size() == c.size());
+                size_t t_ret = 0, s_ret = 0;
+                TTL_STL_COMPARE_2(
+                        for (int r = 0; r < 10; ++r) t_ret += ra.and_count(rb),
+                        for (int r = 0; r < 10; ++r) s_ret += std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), counter()).n,
+                        ("roaring_bitmap and_count" + suffix).c_str()
+                );
+                assert(t_ret == s_ret);
+                std::vector<uint32_t> probe(1000000);
+                for (auto &x: probe) x = rand_u32() % range;
+                t_ret = s_ret = 0;
+                TTL_STL_COMPARE_2(
+                        for (uint32_t x: probe) t_ret += ra.contains(x),
+                        for (uint32_t x: probe) s_ret += std::binary_search(a.begin(), a.end(), x),
+                        ("roaring_bitmap contains" + suffix).c_str()
+                );
+                assert(t_ret == s_ret);
+                printf("%-30s : %zu bytes vs %zu bytes\n", ("roaring_bitmap serialized" + suffix).c_str(),
+                       ra.serialized_size(), a.size() * sizeof(uint32_t));
+            }
+        }
+
+        // 只计数的输出迭代器
+        struct counter {
+            using iterator_category = std::output_iterator_tag;
+            using value_type = void;
+            using difference_type = ptrdiff_t;
+            using pointer = void;
+            using reference = void;
+            size_t n = 0;
+
+            counter &operator*() { return *this; }
+
+            counter &operator++() { return ++n, *this; }
+
+            counter &operator=(uint32_t) { return *this; }
+        };
+    };
+
+}
+
+#endif //TINYSTL_ROARING_BITMAP_TEST_H
@@ -6,6 +6,9 @@
 #define TINYSTL_SEGMENT_TREE_TEST_H
 
 #include "../core/container/expand/segment_tree.h"
+#include "../core/container/expand/fenwick_tree.h"
+#include "../core/container/expand/dynamic_segment_tree.h"
+#include <map>
 #include "../utils/profiler.h"
 #include "../utils/test_helper.h"
 
@@ -16,6 +19,13 @@ namespace ttl::ttl_test {
     public:
         static void runAll() {
             test1();
+            test2();
+            test3();
+            test4();
+            test5();
+            test6();
+            test7();
+            test8();
         }
 
     private:
@@ -92,6 +102,344 @@ namespace ttl::ttl_test {
 
             for (auto v: tree) std::cout << v << ' ';
         }
+
+        // 非递归线段树 : 求和 , 最小值 , 不可交换的字符串拼接
+        static void test2() {
+            const int n = 1000;
+            Container arr(n);
+            for (auto &x: arr) x = randInt(-1000, 1000);
+            iterative_segment_tree<int> sum(arr);
+            auto min_op = [](int a, int b) { return std::min(a, b); };
+            iterative_segment_tree<int, decltype(min_op)> mn(arr, min_op, INT32_MAX);
+            std::vector<std::string> strs(n);
+            for (int i = 0; i < n; ++i) strs[i] = char('a' + i % 26);
+            iterative_segment_tree<std::string> cat(strs);
+            for (int round = 0; round < 2000; ++round) {
+                int i = randInt(n), v = randInt(-100, 100);
+                if (round % 2) sum.add(i, v), arr[i] += v, mn.set(i, arr[i]);
+                else sum.set(i, v), arr[i] = v, mn.set(i, v);
+                strs[i] = char('a' + randInt(26)), cat.set(i, strs[i]);
+                int l = randInt(n), r = randInt(n);
+                if (l > r) std::swap(l, r);
+                int s = 0, m = INT32_MAX;
+                std::string c;
+                for (int j = l; j <= r; ++j) s += arr[j], m = std::min(m, arr[j]), c += strs[j];
+                assert(sum.get(l, r) == s && mn.get(l, r) == m && cat.get(l, r) == c);
+                assert(sum.get(i) == arr[i]);
+            }
+        }
+
+        // 懒惰线段树与递归版本 , 逐元素模拟三方对拍 , 另外检查只开启部分操作的版本
+        static void test3() {
+            using value = unsigned long long;
+            for (int n: {1, 2, 3, 7, 8, 9, 100, 1000}) {
+                std::vector<value> arr(n);
+                for (auto &x: arr) x = randInt(100);
+                segment_tree<value> rec(arr);
+                lazy_segment_tree<value> lazy(arr);
+                lazy_segment_tree<value, segment_add> add_only(arr);
+                lazy_segment_tree<value, segment_set> set_only(arr);
+                std::vector<value> add_arr = arr, set_arr = arr;
+                for (int round = 0; round < 3000; ++round) {
+                    int op = randInt(3), l = randInt(n), r = randInt(n);
+                    value v = randInt(100);
+                    if (l > r) std::swap(l, r);
+                    if (op == 0) {
+                        rec.add(l, r, v), lazy.add(l, r, v), add_only.add(l, r, v);
+                        for (int j = l; j <= r; ++j) arr[j] += v, add_arr[j] += v;
+                    } else if (op == 1) {
+                        int k = randInt(4);
+                        rec.mut(l, r, k), lazy.mut(l, r, k);
+                        for (int j = l; j <= r; ++j) arr[j] *= k;
+                    } else {
+                        rec.set(l, r, v), lazy.set(l, r, v), set_only.set(l, r, v);
+                        for (int j = l; j <= r; ++j) arr[j] = v, set_arr[j] = v;
+                    }
+                    l = randInt(n), r = randInt(n);
+                    if (l > r) std::swap(l, r);
+                    value s = 0, as = 0, ss = 0;
+                    for (int j = l; j <= r; ++j) s += arr[j], as += add_arr[j], ss += set_arr[j];
+                    assert(lazy.get(l, r) == s && rec.get(l, r) == s);
+                    assert(add_only.get(l, r) == as && set_only.get(l, r) == ss);
+                    assert(lazy.get(l) == arr[l] && rec.get(r) == arr[r]);
+                }
+            }
+        }
+
+        // 10^7个元素 , 与递归版本比较每秒操作数
+        static void test4() {
+            using value = unsigned;
+            const int n = 10000000, m = 1000000;
+            std::vector<value> arr(n);
+            for (auto &x: arr) x = randInt(1000);
+            std::vector<int> ops(m), ls(m), rs(m);
+            for (int i = 0; i < m; ++i) {
+                ops[i] = randInt(4), ls[i] = randInt(n), rs[i] = randInt(n);
+                if (ls[i] > rs[i]) std::swap(ls[i], rs[i]);
+            }
+            value t_ret = 0, s_ret = 0;
+            {
+                segment_tree<value> rec(arr);
+                iterative_segment_tree<value> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] & 1) tree.add(ls[i], ops[i]);
+                            else t_ret += tree.get(ls[i], rs[i]);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] & 1) rec.add(ls[i], ls[i], ops[i]);
+                            else s_ret += rec.get(ls[i], rs[i]);
+                        },
+                        "iterative_segment_tree"
+                );
+                assert(t_ret == s_ret);
+            }
+            {
+                segment_tree<value> rec(arr);
+                lazy_segment_tree<value, segment_add> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] & 1) tree.add(ls[i], rs[i], ops[i]);
+                            else t_ret += tree.get(ls[i], rs[i]);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] & 1) rec.add(ls[i], rs[i], ops[i]);
+                            else s_ret += rec.get(ls[i], rs[i]);
+                        },
+                        "lazy_segment_tree add"
+                );
+                assert(t_ret == s_ret);
+            }
+            {
+                segment_tree<value> rec(arr);
+                lazy_segment_tree<value> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] == 0) t_ret += tree.get(ls[i], rs[i]);
+                            else if (ops[i] == 1) tree.add(ls[i], rs[i], i);
+                            else if (ops[i] == 2) tree.mut(ls[i], rs[i], 3);
+                            else tree.set(ls[i], rs[i], i);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (ops[i] == 0) s_ret += rec.get(ls[i], rs[i]);
+                            else if (ops[i] == 1) rec.add(ls[i], rs[i], i);
+                            else if (ops[i] == 2) rec.mut(ls[i], rs[i], 3);
+                            else rec.set(ls[i], rs[i], i);
+                        },
+                        "lazy_segment_tree add/mut/set"
+                );
+                assert(t_ret == s_ret);
+            }
+        }
+
+        // 树状数组 : 单点修改与区间查询 , 区间修改与区间查询 , 前缀最大值 , 顺序统计
+        static void test5() {
+            using value = long long;
+            for (int n: {1, 2, 7, 8, 9, 1000}) {
+                std::vector<value> arr(n), pt(n);
+                for (auto &x: arr) x = randInt(-100, 100);
+                for (auto &x: pt) x = randInt(-100, 100);
+                fenwick_tree<value> tree(pt), empty_built(n);
+                range_fenwick_tree<value> range(arr);
+                auto max_op = [](value a, value b) { return std::max(a, b); };
+                fenwick_tree<value, decltype(max_op)> mx(n, max_op, {}, INT64_MIN);
+                std::vector<value> mx_arr(n, INT64_MIN);
+                for (int i = 0; i < n; ++i) empty_built.add(i, pt[i]);
+                for (int round = 0; round < 2000; ++round) {
+                    int l = randInt(n), r = randInt(n), i = randInt(n);
+                    value v = randInt(-100, 100);
+                    if (l > r) std::swap(l, r);
+                    tree.add(i, v), empty_built.add(i, v), pt[i] += v;
+                    range.add(l, r, v);
+                    for (int j = l; j <= r; ++j) arr[j] += v;
+                    v = randInt(-100000, 100000);
+                    mx.add(i, v), mx_arr[i] = std::max(mx_arr[i], v);
+                    l = randInt(n), r = randInt(n);
+                    if (l > r) std::swap(l, r);
+                    value s = 0, ps = 0, m = INT64_MIN;
+                    for (int j = l; j <= r; ++j) s += arr[j], ps += pt[j];
+                    for (int j = 0; j <= r; ++j) m = std::max(m, mx_arr[j]);
+                    assert(range.get(l, r) == s && range.get(l) == arr[l] && range.prefix(r + 1) - range.prefix(l) == s);
+                    assert(tree.get(l, r) == ps && empty_built.get(l, r) == ps && tree.get(i) == pt[i]);
+                    assert(mx.prefix(r + 1) == m);
+                }
+            }
+            // 按值计数 , lower_bound(k)为第k小的元素
+            const int universe = 1 << 16;
+            fenwick_tree<int> cnt(universe);
+            std::vector<int> sorted;
+            for (int round = 0; round < 20000; ++round) {
+                int x = randInt(universe);
+                cnt.add(x, 1), sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), x), x);
+                if (round % 3 == 0) {
+                    int y = sorted[randInt(int(sorted.size()))];
+                    cnt.add(y, -1), sorted.erase(std::lower_bound(sorted.begin(), sorted.end(), y));
+                }
+                if (sorted.empty()) continue;
+                int k = randInt(int(sorted.size()));
+                assert(int(cnt.lower_bound(k + 1)) == sorted[k]);
+            }
+            assert(cnt.lower_bound(int(sorted.size()) + 1) == cnt.size() && cnt.lower_bound(0) == 0);
+        }
+
+        // 10^7个元素 , 树状数组与递归线段树比较每秒操作数
+        static void test6() {
+            using value = unsigned;
+            const int n = 10000000, m = 1000000;
+            std::vector<value> arr(n);
+            for (auto &x: arr) x = randInt(1000);
+            std::vector<int> ls(m), rs(m);
+            for (int i = 0; i < m; ++i) {
+                ls[i] = randInt(n), rs[i] = randInt(n);
+                if (ls[i] > rs[i]) std::swap(ls[i], rs[i]);
+            }
+            value t_ret = 0, s_ret = 0;
+            {
+                segment_tree<value> rec(arr);
+                fenwick_tree<value> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) tree.add(ls[i], i);
+                            else t_ret += tree.get(ls[i], rs[i]);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) rec.add(ls[i], ls[i], i);
+                            else s_ret += rec.get(ls[i], rs[i]);
+                        },
+                        "fenwick_tree"
+                );
+                assert(t_ret == s_ret);
+            }
+            {
+                segment_tree<value> rec(arr);
+                range_fenwick_tree<value> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) tree.add(ls[i], rs[i], i);
+                            else t_ret += tree.get(ls[i], rs[i]);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) rec.add(ls[i], rs[i], i);
+                            else s_ret += rec.get(ls[i], rs[i]);
+                        },
+                        "range_fenwick_tree"
+                );
+                assert(t_ret == s_ret);
+            }
+        }
+
+        // 动态开点线段树 : int64_t两端附近的稠密窗口与逐元素模拟对拍 , 稀疏的单点修改与std::map对拍 , 超长区间
+        static void test7() {
+            using value = unsigned long long;
+            const int n = 2000;
+            const int64_t bases[] = {INT64_MAX - n + 1, INT64_MIN, -1000};
+            for (int64_t base: bases) {
+                dynamic_segment_tree<value> window(base, base + n - 1), huge(INT64_MIN / 2 + (base < 0 ? base / 2 : 0), INT64_MAX);
+                std::vector<value> arr(n);
+                for (int round = 0; round < 3000; ++round) {
+                    int op = randInt(3), l = randInt(n), r = randInt(n);
+                    value v = randInt(100);
+                    if (l > r) std::swap(l, r);
+                    if (op == 0) {
+                        window.add(base + l, base + r, v), huge.add(base + l, base + r, v);
+                        for (int j = l; j <= r; ++j) arr[j] += v;
+                    } else if (op == 1) {
+                        int k = randInt(4);
+                        window.mut(base + l, base + r, k), huge.mut(base + l, base + r, k);
+                        for (int j = l; j <= r; ++j) arr[j] *= k;
+                    } else {
+                        window.set(base + l, base + r, v), huge.set(base + l, base + r, v);
+                        for (int j = l; j <= r; ++j) arr[j] = v;
+                    }
+                    l = randInt(n), r = randInt(n);
+                    if (l > r) std::swap(l, r);
+                    value sum = 0;
+                    for (int j = l; j <= r; ++j) sum += arr[j];
+                    assert(window.get(base + l, base + r) == sum && huge.get(base + l, base + r) == sum);
+                    assert(window.get(base + l) == arr[l]);
+                }
+                value total = 0;
+                for (auto x: arr) total += x;
+                assert(huge.get(INT64_MIN / 2 + (base < 0 ? base / 2 : 0), INT64_MAX) == total);
+            }
+
+            const int64_t lo = -(int64_t(1) << 62), hi = int64_t(1) << 62;
+            auto rand_coord = []() { return int64_t(uint64_t(randInt()) << 33 ^ uint64_t(randInt()) << 2) >> 1; };
+            dynamic_segment_tree<value> sparse(lo, hi);
+            std::map<int64_t, value> points;
+            const int ops = 20000;
+            for (int round = 0; round < ops; ++round) {
+                int64_t x = rand_coord();
+                value v = randInt(1000);
+                sparse.add(x, x, v), points[x] += v;
+                if (round % 20 == 0) {
+                    int64_t l = rand_coord(), r = rand_coord();
+                    if (l > r) std::swap(l, r);
+                    value sum = 0;
+                    for (auto it = points.lower_bound(l); it != points.end() && it->first <= r; ++it) sum += it->second;
+                    assert(sparse.get(l, r) == sum && sparse.get(x) == points[x]);
+                }
+            }
+            // 每次单点修改至多新建2*63个结点
+            assert(sparse.node_count() <= 1 + size_t(ops) * 2 * 63);
+            size_t bytes = sparse.memory_bytes();
+            sparse.clear();
+            assert(sparse.node_count() == 1 && sparse.memory_bytes() == bytes && sparse.get(lo, hi) == 0);
+            // 区间长度为2^62量级时 , 整体修改只新建O(log)个结点
+            const int64_t len = int64_t(1) << 61;
+            sparse.set(-len, len - 1, 3), sparse.add(0, len - 1, 1), sparse.mut(-len, -1, 2);
+            assert(sparse.get(-len, len - 1) == value(len) * 6 + value(len) * 4);
+            assert(sparse.get(-5, 4) == 5 * 6 + 5 * 4 && sparse.get(lo, -len - 1) == 0);
+            assert(sparse.node_count() < 64 * 8);
+        }
+
+        // 10^7个元素的稠密区间上与递归线段树比较 , 以及int64_t时间戳范围上的稀疏修改的内存
+        static void test8() {
+            using value = unsigned;
+            const int n = 10000000, m = 1000000;
+            std::vector<int> ls(m), rs(m);
+            for (int i = 0; i < m; ++i) {
+                ls[i] = randInt(n), rs[i] = randInt(n);
+                if (ls[i] > rs[i]) std::swap(ls[i], rs[i]);
+            }
+            value t_ret = 0, s_ret = 0;
+            {
+                segment_tree<value> rec{std::vector<value>(n)};
+                dynamic_segment_tree<value> tree(0, n - 1);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) tree.add(ls[i], rs[i], i);
+                            else t_ret += tree.get(ls[i], rs[i]);
+                        },
+                        for (int i = 0; i < m; ++i) {
+                            if (i & 1) rec.add(ls[i], rs[i], i);
+                            else s_ret += rec.get(ls[i], rs[i]);
+                        },
+                        "dynamic_segment_tree"
+                );
+                assert(t_ret == s_ret);
+            }
+            // 纳秒时间戳 , 约146年的范围 , 每次修改约新建2*62个结点
+            const int sparse_m = 100000;
+            dynamic_segment_tree<value> tree(0, int64_t(1) << 62);
+            free_timer timer;
+            timer.start();
+            for (int i = 0; i < sparse_m; ++i) {
+                int64_t ts = int64_t(uint64_t(randInt()) << 31 ^ uint64_t(randInt())) & ((int64_t(1) << 62) - 1);
+                tree.add(ts, ts + randInt(1000000), 1);
+            }
+            printf("%-30s : %.2lf Mops/s , %zu nodes , %zu bytes\n", "dynamic_segment_tree sparse",
+                   double(sparse_m) * 1e3 / double(timer.get_ns()), tree.node_count(), tree.memory_bytes());
+            timer.start();
+            tree.clear();
+            printf("%-30s : %lld ns\n", "dynamic_segment_tree clear", (long long) timer.get_ns());
+        }
     };
 
 }
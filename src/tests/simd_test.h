@@ -0,0 +1,256 @@
+﻿#ifndef TINYSTL_SIMD_TEST_H
+#define TINYSTL_SIMD_TEST_H
+
+#include "../container/vector.h"
+#include "../container/deque.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+
+namespace ttl::ttl_test {
+
+    class simd_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4<uint8_t>(1 << 26, "u8");
+            test4<int>(1 << 26, "int");
+            test4<float>(1 << 26, "float");
+            test4<double>(1 << 26, "double");
+        }
+
+    private:
+        // 值域很小 , 保证有大量重复
+        template<typename T>
+        static std::vector<T> make_input(size_t n, int range) {
+            std::vector<T> ret(n);
+            for (auto &x: ret) x = T(randInt(range) - range / 2);
+            return ret;
+        }
+
+        // 以不同的起始偏移覆盖非对齐的头部与各种长度的尾部
+        template<typename T>
+        static void check_search() {
+            for (size_t n: {0, 1, 7, 31, 32, 33, 64, 127, 128, 129, 1000, 5000}) {
+                auto a = make_input<T>(n + 3, 40);
+                for (size_t off = 0; off < 3; ++off) {
+                    const T *first = a.data() + off, *last = first + n;
+                    for (int v = -25; v < 25; v += 3) {
+                        assert(ttl::find(first, last, T(v)) == std::find(first, last, T(v)));
+                        assert(ttl::count(first, last, T(v)) == size_t(std::count(first, last, T(v))));
+                    }
+                    assert(ttl::min_element(first, last) == std::min_element(first, last));
+                    assert(ttl::max_element(first, last) == std::max_element(first, last));
+                }
+            }
+        }
+
+        // find/count/min_element/max_element : 各种元素类型 , 迭代器 , 混合类型的value
+        static void test1() {
+            check_search<char>();
+            check_search<int8_t>();
+            check_search<uint8_t>();
+            check_search<int16_t>();
+            check_search<uint16_t>();
+            check_search<int>();
+            check_search<unsigned>();
+            check_search<int64_t>();
+            check_search<uint64_t>();
+            check_search<float>();
+            check_search<double>();
+
+            std::vector<int> rd = make_input<int>(10000, 1000);
+            ttl::vector<int> tv(rd.begin(), rd.end());
+            ttl::deque<int> td(rd.begin(), rd.end());
+            std::deque<int> sd(rd.begin(), rd.end());
+            for (int v: {-500, -1, 0, 7, 499, 500}) {
+                auto pos = std::find(rd.begin(), rd.end(), v) - rd.begin();
+                assert(ttl::find(rd.begin(), rd.end(), v) - rd.begin() == pos);
+                assert(ttl::find(tv.begin(), tv.end(), v) - tv.begin() == pos);
+                assert(ttl::find(td.begin(), td.end(), v) - td.begin() == pos);
+                assert(ttl::count(tv.cbegin(), tv.cend(), v) == size_t(std::count(sd.begin(), sd.end(), v)));
+            }
+            assert(ttl::min_element(tv.begin(), tv.end()) - tv.begin() ==
+                   std::min_element(sd.begin(), sd.end()) - sd.begin());
+            assert(ttl::max_element(td.begin(), td.end()) - td.begin() ==
+                   std::max_element(sd.begin(), sd.end()) - sd.begin());
+
+            // value与元素类型不同时按==的转换规则比较
+            std::vector<uint8_t> bytes = {1, 255, 44, 0};
+            assert(ttl::find(bytes.begin(), bytes.end(), -1) == bytes.end());
+            assert(ttl::find(bytes.begin(), bytes.end(), 255) == bytes.begin() + 1);
+            assert(ttl::find(bytes.begin(), bytes.end(), 300) == bytes.end());
+            assert(ttl::count(bytes.begin(), bytes.end(), 256 + 44) == 0);
+            std::vector<unsigned> words(100, 7);
+            words[60] = unsigned(-1);
+            assert(ttl::find(words.begin(), words.end(), -1) == words.begin() + 60);
+            assert(ttl::count(words.begin(), words.end(), 7ll) == 99);
+            // 有符号与无符号的窄类型都提升为int比较 , 截断后的位模式相同也不相等
+            std::vector<short> shorts(100, -1);
+            assert(ttl::count(shorts.begin(), shorts.end(), (unsigned short) 65535) ==
+                   size_t(std::count(shorts.begin(), shorts.end(), (unsigned short) 65535)));
+            assert(ttl::count(shorts.begin(), shorts.end(), (unsigned short) 65535) == 0);
+            assert(ttl::find(shorts.begin(), shorts.end(), (unsigned short) 65535) == shorts.end());
+            std::vector<signed char> chars(100, -56);
+            assert(ttl::count(chars.begin(), chars.end(), (unsigned char) 200) == 0);
+            assert(ttl::find(chars.begin(), chars.end(), (unsigned char) 200) == chars.end());
+            assert(ttl::find(chars.begin(), chars.end(), (unsigned char) 200) ==
+                   std::find(chars.begin(), chars.end(), (unsigned char) 200));
+            std::vector<double> reals(100, 0.5);
+            reals[10] = 0.1f;
+            assert(ttl::find(reals.begin(), reals.end(), 0.1f) == reals.begin() + 10);
+            assert(ttl::find(reals.begin(), reals.end(), 0.1) == reals.end());
+            std::string str(300, 'a');
+            str[257] = 'z';
+            assert(ttl::find(str.begin(), str.end(), 'z') - str.begin() == 257);
+            assert(ttl::count(str.cbegin(), str.cend(), 'a') == 299);
+        }
+
+        // 浮点数 : NaN , ±0 , 跨越分块边界的最值
+        static void test2() {
+            const float nan = std::numeric_limits<float>::quiet_NaN();
+            for (size_t n: {1, 8, 100, 1024, 1025, 5000}) {
+                for (size_t pos: {size_t(0), n / 3, n - 1}) {
+                    std::vector<float> a(n, 1.0f);
+                    for (size_t i = 0; i < n; ++i) a[i] = float(i % 97);
+                    a[pos] = nan;
+                    assert(ttl::find(a.begin(), a.end(), nan) == a.end());
+                    assert(ttl::count(a.begin(), a.end(), nan) == 0);
+                    assert(ttl::min_element(a.begin(), a.end()) == std::min_element(a.begin(), a.end()));
+                    assert(ttl::max_element(a.begin(), a.end()) == std::max_element(a.begin(), a.end()));
+                    std::vector<float> b = a;
+                    assert(!ttl::equal(a.begin(), a.end(), b.begin(), b.end()));
+                    a[pos] = -0.0f, b[pos] = 0.0f;
+                    assert(ttl::equal(a.begin(), a.end(), b.begin()));
+                    assert(ttl::find(a.begin(), a.end(), 0.0f) == std::find(a.begin(), a.end(), 0.0f));
+                    assert(ttl::min_element(a.begin(), a.end()) == std::min_element(a.begin(), a.end()));
+                }
+            }
+            // 最值在不同分块中重复出现时返回第一个
+            for (size_t n: {4096, 10000, 100000}) {
+                std::vector<int16_t> a(n, 0);
+                for (size_t p: {n - 1, n / 2, size_t(3000), size_t(2049)}) a[p] = -5, a[n - 1 - p] = 9;
+                assert(ttl::min_element(a.begin(), a.end()) == std::min_element(a.begin(), a.end()));
+                assert(ttl::max_element(a.begin(), a.end()) == std::max_element(a.begin(), a.end()));
+            }
+            std::vector<int64_t> big = make_input<int64_t>(5000, 100);
+            assert(ttl::min_element(big.begin(), big.end()) == std::min_element(big.begin(), big.end()));
+            assert(ttl::max_element(big.begin(), big.end(), std::greater<>()) ==
+                   std::max_element(big.begin(), big.end(), std::greater<>()));
+        }
+
+        template<typename T>
+        static void check_compare() {
+            for (size_t n: {0, 1, 15, 16, 17, 63, 64, 65, 300}) {
+                auto a = make_input<T>(n, 200), b = a;
+                assert(ttl::equal(a.begin(), a.end(), b.begin(), b.end()));
+                assert(!ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+                for (size_t i = 0; i < n; ++i) {
+                    T old = b[i];
+                    b[i] = T(old + 1);
+                    assert(ttl::equal(a.begin(), a.end(), b.begin()) == std::equal(a.begin(), a.end(), b.begin()));
+                    assert(ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()) ==
+                           std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+                    assert(ttl::lexicographical_compare(b.cbegin(), b.cend(), a.cbegin(), a.cend()) ==
+                           std::lexicographical_compare(b.cbegin(), b.cend(), a.cbegin(), a.cend()));
+                    b[i] = old;
+                }
+                // 前缀
+                if (n > 0) {
+                    assert(!ttl::equal(a.begin(), a.end(), b.begin(), b.end() - 1));
+                    assert(ttl::lexicographical_compare(a.begin(), a.end() - 1, b.begin(), b.end()));
+                    assert(!ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end() - 1));
+                }
+            }
+        }
+
+        // equal/lexicographical_compare : 每个位置的不同 , 有符号字节 , 前缀 , NaN
+        static void test3() {
+            check_compare<uint8_t>();
+            check_compare<int8_t>();
+            check_compare<char>();
+            check_compare<int16_t>();
+            check_compare<int>();
+            check_compare<uint64_t>();
+            check_compare<float>();
+            check_compare<double>();
+
+            std::vector<double> a(200, 1.0), b(200, 1.0);
+            a[50] = b[50] = std::nan("");
+            assert(!ttl::equal(a.begin(), a.end(), b.begin()));
+            assert(!ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+            b[150] = 2.0;
+            assert(ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()));
+            assert(!ttl::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end()));
+
+            std::vector<char> neg = {'a', char(-1)}, pos = {'a', 'b'};
+            assert(ttl::lexicographical_compare(neg.begin(), neg.end(), pos.begin(), pos.end()) ==
+                   std::lexicographical_compare(neg.begin(), neg.end(), pos.begin(), pos.end()));
+            ttl::vector<int> tv = {1, 2, 3};
+            std::vector<int> sv = {1, 2, 3};
+            same(sv, tv);
+            assert(ttl::lexicographical_compare(tv.begin(), tv.end(), sv.begin(), sv.end() - 1) == false);
+        }
+
+        // bytes字节的数据 , 不含要查找的值 , 报告吞吐量
+        template<typename T>
+        static void test4(size_t bytes, const std::string &type) {
+            size_t n = bytes / sizeof(T);
+            std::vector<T> a(n), b;
+            for (size_t i = 0; i < n; ++i) a[i] = T(i % 100 + 1);
+            b = a;
+            const T *first = a.data(), *last = first + n;
+            size_t s_ret = 0, t_ret = 0;
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    t_ret = ttl::find(first, last, T(0)) - first,
+                    s_ret = std::find(first, last, T(0)) - first,
+                    ("find " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    t_ret = ttl::count(first, last, T(7)),
+                    s_ret = std::count(first, last, T(7)),
+                    ("count " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    t_ret = ttl::min_element(first, last) - first,
+                    s_ret = std::min_element(first, last) - first,
+                    ("min_element " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    bytes,
+                    t_ret = ttl::max_element(first, last) - first,
+                    s_ret = std::max_element(first, last) - first,
+                    ("max_element " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    t_ret = ttl::equal(a.begin(), a.end(), b.begin(), b.end()),
+                    s_ret = std::equal(a.begin(), a.end(), b.begin(), b.end()),
+                    ("equal " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+            TTL_BANDWIDTH_COMPARE(
+                    2 * bytes,
+                    t_ret = ttl::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()),
+                    s_ret = std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end()),
+                    ("lexicographical_compare " + type).c_str()
+            );
+            assert(s_ret == t_ret);
+        }
+    };
+
+}
+
+#endif //TINYSTL_SIMD_TEST_H
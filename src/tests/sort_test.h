@@ -0,0 +1,178 @@
+﻿#ifndef TINYSTL_SORT_TEST_H
+#define TINYSTL_SORT_TEST_H
+
+#include "../container/vector.h"
+#include "../container/deque.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+#include <deque>
+
+namespace ttl::ttl_test {
+
+    class sort_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3<ttl::vector<int>, std::vector<int>>("vector");
+            test3<ttl::deque<int>, std::deque<int>>("deque");
+            test4();
+            test5();
+        }
+
+    private:
+        // 四种输入 : 随机 , 有序 , 逆序 , 少量不同的值
+        static std::vector<int> make_input(int n, int kind) {
+            std::vector<int> ret = randIntArray(n);
+            if (kind == 1) std::sort(ret.begin(), ret.end());
+            else if (kind == 2) std::sort(ret.begin(), ret.end(), std::greater<>());
+            else if (kind == 3) for (auto &x: ret) x %= 16;
+            return ret;
+        }
+
+        static const char *kind_name(int kind) {
+            static const char *names[] = {"random", "sorted", "reversed", "few unique"};
+            return names[kind];
+        }
+
+        // 各种长度与输入下sort/stable_sort的正确性 , 包括需要分支划分的比较器与deque迭代器
+        static void test1() {
+            for (int n: {0, 1, 2, 3, 23, 24, 25, 100, 129, 1000, 100000}) {
+                for (int kind = 0; kind < 4; ++kind) {
+                    std::vector<int> rd = make_input(n, kind), sa = rd;
+                    std::sort(sa.begin(), sa.end());
+                    ttl::vector<int> ta(rd.begin(), rd.end());
+                    ttl::sort(ta.begin(), ta.end());
+                    same(sa, ta);
+                    ttl::deque<int> td(rd.begin(), rd.end());
+                    ttl::sort(td.begin(), td.end(), [](int a, int b) { return a < b; });
+                    same(sa, td);
+                    std::vector<int> tb = rd;
+                    ttl::sort(tb.begin(), tb.end(), std::greater<>());
+                    std::reverse(sa.begin(), sa.end());
+                    same(sa, tb);
+                    ttl::vector<int> tc(rd.begin(), rd.end());
+                    ttl::stable_sort(tc.begin(), tc.end(), std::greater<>());
+                    same(sa, tc);
+                }
+            }
+            // 构造针对三数取中的输入 , 依赖模式打乱与堆排序保证复杂度
+            std::vector<int> organ(1000000);
+            for (int i = 0; i < 500000; ++i) organ[i] = i, organ[999999 - i] = i;
+            std::vector<int> sa = organ;
+            std::sort(sa.begin(), sa.end());
+            ttl::sort(organ.begin(), organ.end());
+            assert(sa == organ);
+            auto rs = randStrArray(100000, 3);
+            std::vector<std::string> ss = rs;
+            std::sort(ss.begin(), ss.end());
+            ttl::sort(rs.begin(), rs.end());
+            assert(ss == rs);
+        }
+
+        // stable_sort与stable_partition的稳定性 , 以及partition的正确性
+        static void test2() {
+            using item = std::pair<int, int>;
+            auto by_key = [](const item &a, const item &b) { return a.first < b.first; };
+            auto key_odd = [](const item &a) { return a.first % 2 != 0; };
+            auto rd = randIntArray(200000);
+            for (int n: {1, 31, 33, 1000, 200000}) {
+                std::vector<item> sa(n);
+                for (int i = 0; i < n; ++i) sa[i] = {rd[i] % 100, i};
+                ttl::deque<item> ta(sa.begin(), sa.end());
+                std::vector<item> pa = sa, pb = sa, pc = sa;
+                std::stable_sort(sa.begin(), sa.end(), by_key);
+                ttl::stable_sort(ta.begin(), ta.end(), by_key);
+                same(sa, ta);
+                auto s_mid = std::stable_partition(pa.begin(), pa.end(), key_odd);
+                auto t_mid = ttl::stable_partition(pb.begin(), pb.end(), key_odd);
+                assert(pa == pb && s_mid - pa.begin() == t_mid - pb.begin());
+                auto mid = ttl::partition(pc.begin(), pc.end(), key_odd);
+                assert(mid - pc.begin() == s_mid - pa.begin());
+                assert(std::all_of(pc.begin(), mid, key_odd) && std::none_of(mid, pc.end(), key_odd));
+            }
+            ttl::vector<std::string> ts(10, "x");
+            ttl::stable_partition(ts.begin(), ts.end(), [](const std::string &) { return false; });
+            for (auto &s: ts) assert(s == "x");
+        }
+
+        // ttl::sort vs std::sort
+        template<typename TC, typename SC>
+        static void test3(const char *container) {
+            for (int kind = 0; kind < 4; ++kind) {
+                std::vector<int> rd = make_input(1000000, kind);
+                TC tc(rd.begin(), rd.end());
+                SC sc(rd.begin(), rd.end());
+                std::string name = std::string("sort ") + container + " " + kind_name(kind);
+                TTL_STL_COMPARE_2(
+                        {
+                            ttl::sort(tc.begin(), tc.end());
+                        },
+                        {
+                            std::sort(sc.begin(), sc.end());
+                        }, name.c_str()
+                );
+                same(sc, tc);
+            }
+        }
+
+        // ttl::stable_sort vs std::stable_sort
+        static void test4() {
+            for (int kind = 0; kind < 4; ++kind) {
+                std::vector<int> rd = make_input(1000000, kind);
+                ttl::vector<int> tc(rd.begin(), rd.end());
+                std::vector<int> sc = rd;
+                std::string name = std::string("stable_sort ") + kind_name(kind);
+                TTL_STL_COMPARE_2(
+                        {
+                            ttl::stable_sort(tc.begin(), tc.end());
+                        },
+                        {
+                            std::stable_sort(sc.begin(), sc.end());
+                        }, name.c_str()
+                );
+                same(sc, tc);
+            }
+            auto rs = randStrArray(300000, 8);
+            ttl::vector<std::string> ts(rs.begin(), rs.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::sort(ts.begin(), ts.end());
+                    },
+                    {
+                        std::sort(rs.begin(), rs.end());
+                    }, "sort string"
+            );
+            same(rs, ts);
+        }
+
+        // partition与stable_partition
+        static void test5() {
+            std::vector<int> rd = randIntArray(1000000);
+            auto odd = [](int x) { return x % 2 != 0; };
+            std::vector<int> sa = rd, ta = rd;
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::partition(ta.begin(), ta.end(), odd);
+                    },
+                    {
+                        std::partition(sa.begin(), sa.end(), odd);
+                    }, "partition"
+            );
+            sa = rd, ta = rd;
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::stable_partition(ta.begin(), ta.end(), odd);
+                    },
+                    {
+                        std::stable_partition(sa.begin(), sa.end(), odd);
+                    }, "stable_partition"
+            );
+            assert(sa == ta);
+        }
+    };
+
+}
+
+#endif //TINYSTL_SORT_TEST_H
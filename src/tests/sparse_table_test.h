@@ -0,0 +1,125 @@
+﻿#ifndef TINYSTL_SPARSE_TABLE_TEST_H
+#define TINYSTL_SPARSE_TABLE_TEST_H
+
+#include "../core/container/expand/sparse_table.h"
+#include "../core/container/expand/segment_tree.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <numeric>
+#include <vector>
+
+namespace ttl::ttl_test {
+
+    class sparse_table_test {
+        using Container = std::vector<int>;
+
+        struct gcd_op {
+            int operator()(int a, int b) const { return std::gcd(a, b); }
+        };
+
+        // 最小值是幂等的 , 重复k次仍为自身 , segment_tree下传标记时需要
+        struct idempotent_repeat {
+            int operator()(int v, int32_t) const { return v; }
+        };
+
+        static void make_queries(int n, int m, Container &ls, Container &rs) {
+            ls.resize(m), rs.resize(m);
+            for (int i = 0; i < m; ++i) {
+                ls[i] = randInt(n), rs[i] = randInt(n);
+                if (ls[i] > rs[i]) std::swap(ls[i], rs[i]);
+            }
+        }
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+        }
+
+    private:
+        // min , max , gcd以及分块版本 , 覆盖块边界附近的长度 , 与逐元素计算对拍
+        static void test1() {
+            for (int n: {1, 2, 3, 31, 32, 33, 64, 65, 1000, 5000}) {
+                for (int range: {3, 1000000}) {
+                    Container arr(n);
+                    for (auto &x: arr) x = randInt(1, range);
+                    sparse_table<int> mn(arr);
+                    sparse_table<int, minimum<int, std::greater<>>> mx(arr);
+                    sparse_table<int, gcd_op> gcd(arr);
+                    block_sparse_table<int> bmn(arr);
+                    block_sparse_table<int, std::greater<>> bmx(arr);
+                    assert(mn.size() == size_t(n) && bmn.size() == size_t(n));
+                    for (int round = 0; round < 3000; ++round) {
+                        int l = randInt(n), r = round % 2 ? randInt(n) : std::min(n - 1, l + randInt(70));
+                        if (l > r) std::swap(l, r);
+                        int a = arr[l], b = arr[l], g = 0;
+                        for (int j = l; j <= r; ++j) a = std::min(a, arr[j]), b = std::max(b, arr[j]), g = std::gcd(g, arr[j]);
+                        assert(mn.get(l, r) == a && mx.get(l, r) == b && gcd.get(l, r) == g);
+                        assert(bmn.get(l, r) == a && bmx.get(l, r) == b);
+                        assert(mn.get(l) == arr[l] && bmn.get(r) == arr[r]);
+                    }
+                }
+            }
+            // 分块版本为O(n) : 元素的副本与位掩码各n个字 , 块的sparse_table约为n/32*log(n/32)个元素
+            Container arr(1 << 20);
+            std::iota(arr.begin(), arr.end(), 0);
+            block_sparse_table<int> bmn(arr);
+            sparse_table<int> mn(arr);
+            assert(bmn.table_bytes() < arr.size() * sizeof(int) * 3 && mn.table_bytes() > arr.size() * sizeof(int) * 19);
+        }
+
+        // 10^7个元素 , 与递归线段树比较区间最小值的查询
+        static void test2() {
+            const int n = 10000000, m = 2000000;
+            Container arr(n), ls, rs;
+            for (auto &x: arr) x = randInt();
+            make_queries(n, m, ls, rs);
+            segment_tree<int, minimum<int>, int32_t, idempotent_repeat> rec(arr, {}, {}, INT32_MAX);
+            long long t_ret = 0, s_ret = 0;
+            {
+                sparse_table<int> tree(arr);
+                TTL_OPS_COMPARE(
+                        m,
+                        for (int i = 0; i < m; ++i) t_ret += tree.get(ls[i], rs[i]),
+                        for (int i = 0; i < m; ++i) s_ret += rec.get(ls[i], rs[i]),
+                        "sparse_table get"
+                );
+                assert(t_ret == s_ret);
+            }
+            t_ret = s_ret = 0;
+            block_sparse_table<int> tree(arr);
+            TTL_OPS_COMPARE(
+                    m,
+                    for (int i = 0; i < m; ++i) t_ret += tree.get(ls[i], rs[i]),
+                    for (int i = 0; i < m; ++i) s_ret += rec.get(ls[i], rs[i]),
+                    "block_sparse_table get"
+            );
+            assert(t_ret == s_ret);
+        }
+
+        // 10^8个元素 , 完整的sparse_table与递归线段树都需要数GB内存 , 与非递归线段树比较
+        static void test3() {
+            const int n = 100000000, m = 10000000;
+            Container arr(n), ls, rs;
+            for (auto &x: arr) x = randInt();
+            make_queries(n, m, ls, rs);
+            long long t_ret = 0, s_ret = 0;
+            block_sparse_table<int> tree(arr);
+            iterative_segment_tree<int, minimum<int>> seg(arr, {}, INT32_MAX);
+            arr = Container();
+            TTL_OPS_COMPARE(
+                    m,
+                    for (int i = 0; i < m; ++i) t_ret += tree.get(ls[i], rs[i]),
+                    for (int i = 0; i < m; ++i) s_ret += seg.get(ls[i], rs[i]),
+                    "block_sparse_table get 1e8"
+            );
+            assert(t_ret == s_ret);
+            printf("%-30s : %zu bytes vs %zu bytes (iterative_segment_tree)\n", "block_sparse_table memory",
+                   tree.table_bytes(), size_t(n) * 2 * sizeof(int));
+        }
+    };
+
+}
+
+#endif //TINYSTL_SPARSE_TABLE_TEST_H
@@ -0,0 +1,215 @@
+﻿#ifndef TINYSTL_THREAD_POOL_TEST_H
+#define TINYSTL_THREAD_POOL_TEST_H
+
+#include "../thread/thread_pool.h"
+#include "../algorithm/execution.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <ctime>
+#include <stdexcept>
+
+namespace ttl::ttl_test {
+
+    class thread_pool_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4();
+            test5(36, 20);
+            test5(27, 0);
+            test6(1 << 16);
+        }
+
+    private:
+        static uint64_t fib(int n) {
+            return n < 2 ? n : fib(n - 1) + fib(n - 2);
+        }
+
+        // 每层派生一个子任务 , n小于cutoff时顺序计算
+        static uint64_t fib(ttl::thread_pool &pool, int n, int cutoff) {
+            if (n < 2 || n < cutoff) return fib(n);
+            uint64_t a = 0, b = 0;
+            ttl::task_group group(pool);
+            group.spawn([&] { a = fib(pool, n - 1, cutoff); });
+            b = fib(pool, n - 2, cutoff);
+            group.sync();
+            return a + b;
+        }
+
+        // submit与future : 返回值 , void , 异常 , 工作线程中嵌套等待 , 多个外部线程同时提交
+        static void test1() {
+            for (size_t threads: {1, 2, 4}) {
+                ttl::thread_pool pool(threads);
+                std::vector<ttl::task_future<int>> futures;
+                for (int i = 0; i < 1000; ++i) futures.push_back(pool.submit([i] { return i * 2; }));
+                for (int i = 0; i < 1000; ++i) assert(futures[i].get() == i * 2 && !futures[i].valid());
+                std::atomic<int> hits{0};
+                pool.submit([&hits] { ++hits; }).get();
+                assert(hits == 1);
+                auto failing = pool.submit([]() -> int { throw std::runtime_error("task"); });
+                bool caught = false;
+                try {
+                    failing.get();
+                } catch (const std::runtime_error &) {
+                    caught = true;
+                }
+                assert(caught);
+                auto outer = pool.submit([&pool] {
+                    auto inner = pool.submit([] { return std::string("inner"); });
+                    return inner.get() + "+outer";
+                });
+                assert(outer.get() == "inner+outer");
+                std::vector<std::thread> producers;
+                std::atomic<long long> total{0};
+                for (int t = 0; t < 4; ++t) {
+                    producers.emplace_back([&pool, &total, t] {
+                        std::vector<ttl::task_future<long long>> fs;
+                        for (int i = 0; i < 5000; ++i) fs.push_back(pool.submit([t, i] { return (long long) t * i; }));
+                        for (auto &f: fs) total += f.get();
+                    });
+                }
+                for (auto &p: producers) p.join();
+                assert(total == 6ll * (4999ll * 5000 / 2));
+            }
+        }
+
+        // spawn/sync : 递归fib , 异常 , 析构时执行剩余的任务 , execute的异常
+        static void test2() {
+            for (size_t threads: {1, 2, 3, 8}) {
+                ttl::thread_pool pool(threads);
+                assert(pool.submit([&pool] { return fib(pool, 22, 0); }).get() == fib(22));
+                assert(fib(pool, 24, 10) == fib(24)); // 从外部线程开始派生
+                ttl::task_group group(pool);
+                std::atomic<int> ran{0};
+                for (int i = 0; i < 100; ++i) {
+                    group.spawn([&ran, i] {
+                        if (i == 50) throw std::logic_error("spawn");
+                        ++ran;
+                    });
+                }
+                bool caught = false;
+                try {
+                    group.sync();
+                } catch (const std::logic_error &) {
+                    caught = true;
+                }
+                assert(caught && ran <= 99);
+                group.spawn([&ran] { ran = -1; });
+                group.sync();
+                assert(ran == -1);
+            }
+            std::atomic<int> done{0};
+            {
+                ttl::thread_pool pool(2);
+                for (int i = 0; i < 10000; ++i) pool.execute([&done] { ++done; });
+            }
+            assert(done == 10000);
+            // execute的任务抛出的异常留在线程池中 , 单个线程按提交顺序执行共享队列中的任务
+            ttl::thread_pool single(1);
+            single.execute([] { throw std::runtime_error("execute"); });
+            single.execute([] { throw std::logic_error("second"); });
+            single.submit([] {}).get();
+            bool caught = false;
+            try {
+                std::rethrow_exception(single.take_exception());
+            } catch (const std::runtime_error &) {
+                caught = true;
+            }
+            assert(caught && !single.take_exception());
+        }
+
+        // parallel_for : 每个下标恰好访问一次 , 块的边界 , 异常 , 嵌套
+        static void test3() {
+            ttl::thread_pool pool(4);
+            for (size_t n: {1, 2, 100, 4097, 100000}) {
+                for (size_t grain: {0, 1, 7, 4096}) {
+                    std::vector<std::atomic<int>> seen(n);
+                    pool.parallel_for(n, grain, [&](size_t lo, size_t hi) {
+                        assert(lo < hi && hi <= n);
+                        if (grain) assert(lo % grain == 0 && (hi - lo == grain || hi == n));
+                        for (size_t i = lo; i < hi; ++i) ++seen[i];
+                    });
+                    for (auto &x: seen) assert(x == 1);
+                }
+            }
+            bool caught = false;
+            std::atomic<size_t> visited{0};
+            try {
+                pool.parallel_for(1 << 20, 64, [&](size_t lo, size_t hi) {
+                    if (lo == 64 * 1000) throw std::out_of_range("chunk");
+                    visited += hi - lo;
+                });
+            } catch (const std::out_of_range &) {
+                caught = true;
+            }
+            assert(caught && visited < (1 << 20));
+            std::atomic<size_t> cells{0};
+            pool.parallel_for(300, 1, [&](size_t lo, size_t) {
+                pool.parallel_for(lo + 1, 0, [&](size_t a, size_t b) { cells += b - a; });
+            });
+            assert(cells == 300 * 301 / 2);
+        }
+
+        // 空闲的工作线程睡眠 , 不消耗cpu
+        static void test4() {
+            ttl::thread_pool pool(8);
+            pool.submit([] {}).get();
+            std::clock_t begin = std::clock();
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            double cpu_ms = double(std::clock() - begin) * 1000 / CLOCKS_PER_SEC;
+            printf("%-30s : %.2lf ms cpu in 200 ms\n", "idle pool(8)", cpu_ms);
+            assert(cpu_ms < 20);
+        }
+
+        // fib(n) , 小于cutoff时顺序计算 , cutoff为0时每次调用都是一个任务 , 衡量任务的开销
+        static void test5(int n, int cutoff) {
+            std::string name = "fib(" + std::to_string(n) + ") cutoff=" + std::to_string(cutoff);
+            uint64_t s_ret = 0, p_ret = 0;
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        s_ret = fib(n);
+                    },
+                    {
+                        p_ret = pool.submit([&pool, n, cutoff] { return fib(pool, n, cutoff); }).get();
+                    }, name.c_str()
+            );
+            assert(s_ret == p_ret);
+        }
+
+        // 不均匀的负载 : 第i次迭代的代价正比于i , 比较自适应的块与按线程数静态均分
+        static void test6(size_t n) {
+            std::vector<uint64_t> out(n);
+            auto body = [&out](size_t lo, size_t hi) {
+                for (size_t i = lo; i < hi; ++i) {
+                    uint64_t x = i;
+                    for (size_t k = 0; k < i; ++k) x = x * 6364136223846793005ull + 1442695040888963407ull;
+                    out[i] = x;
+                }
+            };
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        body(0, n);
+                    },
+                    {
+                        pool.parallel_for(n, 0, body);
+                    }, "uneven parallel_for adaptive"
+            );
+            TTL_PARALLEL_COMPARE(
+                    {},
+                    {
+                        body(0, n);
+                    },
+                    {
+                        pool.parallel_for(n, (n + pool.size() - 1) / pool.size(), body);
+                    }, "uneven parallel_for static"
+            );
+        }
+    };
+
+}
+
+#endif //TINYSTL_THREAD_POOL_TEST_H
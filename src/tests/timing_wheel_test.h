@@ -0,0 +1,145 @@
+﻿#ifndef TINYSTL_TIMING_WHEEL_TEST_H
+#define TINYSTL_TIMING_WHEEL_TEST_H
+
+#include "../container/expand/timing_wheel.h"
+#include "../adapter/priority_queue.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace ttl::ttl_test {
+
+    class timing_wheel_test {
+        struct timeout {
+            int id = 0;
+            uint64_t period = 0; // 非0时到期后重新调度
+            timer_hook hook;
+        };
+
+        using wheel = ttl::timing_wheel<timeout, &timeout::hook>;
+
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+        }
+
+    private:
+        // 与std::map记录的到期时间比较 , 包括取消 , 重新调度 , 回调中调度以及大跨度的推进
+        static void test1() {
+            const int n = 20000, m = 200000;
+            auto rd = randIntArray(m * 2);
+            std::vector<timeout> pool(n);
+            std::map<int, uint64_t> expect; // id -> 到期时间
+            wheel tw(1000);
+            uint64_t now = 1000;
+            for (int i = 0; i < n; ++i) pool[i].id = i, pool[i].period = i % 7 == 0 ? i % 50 + 1 : 0;
+            for (int i = 0; i < m; ++i) {
+                auto &t = pool[rd[i] % n];
+                int op = rd[i + m] % 10;
+                if (op < 5) {
+                    // 跨度从几个tick到2^40个tick
+                    uint64_t delay = uint64_t(rd[i + m]) >> (rd[i] % 31);
+                    if (op == 0) delay <<= 9;
+                    tw.schedule(t, now + delay), expect[t.id] = now + delay;
+                } else if (op < 7) {
+                    assert(tw.cancel(t) == (expect.erase(t.id) == 1));
+                } else {
+                    now += op == 9 ? uint64_t(rd[i]) << 8 : rd[i] % 100;
+                    std::vector<int> fired, want;
+                    for (auto &kv: expect) if (kv.second <= now) want.push_back(kv.first);
+                    for (int id: want) expect.erase(id);
+                    size_t cnt = tw.advance(now, [&](timeout &x) {
+                        assert(x.hook.expire_time() <= now && !x.hook.is_linked());
+                        fired.push_back(x.id);
+                        // 周期定时器在之后的时刻重新调度 , 不应在本轮触发
+                        if (x.period) tw.schedule(x, now + x.period), expect[x.id] = now + x.period;
+                    });
+                    assert(cnt == fired.size());
+                    std::sort(fired.begin(), fired.end());
+                    assert(fired == want);
+                }
+                assert(tw.size() == expect.size());
+            }
+            for (auto &kv: expect) assert(pool[kv.first].hook.is_linked());
+            tw.clear();
+            for (auto &t: pool) assert(!t.hook.is_linked());
+            assert(tw.empty() && tw.advance(uint64_t(-2), [](timeout &) { assert(false); }) == 0);
+        }
+
+        // 1e7个活跃的定时器 : 调度 , 取消一半 , 推进到全部到期
+        // 对比二叉堆 , 取消时记录版本号 , 弹出时丢弃过期的项
+        static void test2() {
+            const int n = 10000000, horizon = 1 << 22, step = 64;
+            auto rd = randIntArray(n);
+            std::vector<timeout> pool(n);
+            std::vector<uint32_t> version(n);
+            for (int i = 0; i < n; ++i) pool[i].id = i;
+            using item = std::pair<uint64_t, uint64_t>; // (到期时间 , 版本号 << 32 | id)
+            using binary_queue = ttl::priority_queue<item, ttl::vector<item>, std::greater<>>;
+            wheel tw;
+            binary_queue pq;
+            size_t t_fired = 0, s_fired = 0;
+            TTL_STL_COMPARE_2(
+                    {
+                        for (int i = 0; i < n; ++i) tw.schedule(pool[i], rd[i] % horizon);
+                    },
+                    {
+                        for (int i = 0; i < n; ++i) pq.push(item(rd[i] % horizon, i));
+                    }, "timer schedule"
+            );
+            TTL_STL_COMPARE_2(
+                    {
+                        for (int i = 0; i < n; i += 2) tw.cancel(pool[i]);
+                    },
+                    {
+                        for (int i = 0; i < n; i += 2) ++version[i];
+                    }, "timer cancel"
+            );
+            TTL_STL_COMPARE_2(
+                    {
+                        for (uint64_t now = step - 1; now < horizon; now += step) {
+                            t_fired += tw.advance(now, [](timeout &) {});
+                        }
+                    },
+                    {
+                        for (uint64_t now = step - 1; now < horizon; now += step) {
+                            while (!pq.empty() && pq.top().first <= now) {
+                                uint64_t tag = pq.top().second;
+                                pq.pop();
+                                if (tag >> 32 == version[uint32_t(tag)]) ++s_fired;
+                            }
+                        }
+                    }, "timer expire"
+            );
+            assert(t_fired == s_fired && t_fired == size_t(n / 2));
+        }
+
+        // 推进到uint64_t的最大值 , 最高层有待触发的定时器 , 之后还能继续调度与推进
+        static void test3() {
+            const uint64_t max = ~uint64_t(0);
+            const uint64_t when[] = {max, max - 1, max - 64, max - 4097, uint64_t(1) << 63, 12345, 5};
+            std::vector<timeout> pool(std::size(when));
+            std::vector<uint64_t> fired;
+            auto record = [&fired](timeout &x) { fired.push_back(x.hook.expire_time()); };
+            wheel tw;
+            for (size_t i = 0; i < pool.size(); ++i) tw.schedule(pool[i], when[i]);
+            assert(tw.advance(max - 65, record) == 4 && tw.size() == 3);
+            assert(tw.advance(max, record) == 3 && tw.empty());
+            assert(std::is_sorted(fired.begin(), fired.end()) && fired.back() == max);
+            // 到达最大值后 , 过期的与位于最大值的定时器都在下一次推进时触发
+            tw.schedule(pool[0], max), tw.schedule(pool[1], 7);
+            assert(tw.advance(max, record) == 2 && tw.empty());
+            assert(tw.advance(max, record) == 0);
+            wheel top(max - 200);
+            top.schedule(pool[0], max), top.schedule(pool[1], max - 100);
+            assert(top.advance(max - 100, record) == 1 && top.advance(max, record) == 1);
+        }
+    };
+
+}
+
+#endif //TINYSTL_TIMING_WHEEL_TEST_H
@@ -0,0 +1,115 @@
+﻿#ifndef TINYSTL_TOP_K_TEST_H
+#define TINYSTL_TOP_K_TEST_H
+
+#include "../adapter/top_k.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <algorithm>
+
+namespace ttl::ttl_test {
+
+    class top_k_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3(10);
+            test3(1000);
+            test3(100000);
+            test4();
+        }
+
+    private:
+        // 分块得到部分结果后合并
+        static void test1() {
+            std::vector<int> rd = randIntArray(100000);
+            for (auto &x: rd) x %= 5000;
+            for (size_t k: {0, 1, 7, 100, 5000, 200000}) {
+                ttl::top_k<int> all(k), part[4] = {ttl::top_k<int>(k), ttl::top_k<int>(k),
+                                                    ttl::top_k<int>(k), ttl::top_k<int>(k)};
+                for (size_t i = 0; i < rd.size(); ++i) part[i % 4].push(rd[i]);
+                all.merge(part[0]);
+                for (int i = 1; i < 4; ++i) all.merge(std::move(part[i]));
+                std::vector<int> sa = rd;
+                std::sort(sa.begin(), sa.end(), std::greater<>());
+                sa.resize(std::min(k, sa.size()));
+                same(sa, all.sorted());
+                ttl::top_k<int, std::greater<>> smallest(k);
+                smallest.push(rd.begin(), rd.end());
+                std::vector<int> sb = rd;
+                std::sort(sb.begin(), sb.end());
+                sb.resize(std::min(k, sb.size()));
+                same(sb, std::move(smallest).sorted());
+            }
+        }
+
+        // partial_sort 与 nth_element
+        static void test2() {
+            std::vector<int> rd = randIntArray(100000);
+            for (size_t k: {0, 1, 10, 1000, 99999, 100000}) {
+                std::vector<int> ta = rd, sa = rd;
+                ttl::partial_sort(ta.begin(), ta.begin() + k, ta.end());
+                std::partial_sort(sa.begin(), sa.begin() + k, sa.end());
+                assert(std::equal(ta.begin(), ta.begin() + k, sa.begin()));
+                if (k == rd.size()) continue;
+                std::vector<int> tb = rd;
+                for (auto &x: tb) x %= 100; // 大量重复元素
+                std::vector<int> sb = tb;
+                ttl::nth_element(tb.begin(), tb.begin() + k, tb.end());
+                std::sort(sb.begin(), sb.end());
+                assert(tb[k] == sb[k]);
+                for (size_t i = 0; i < k; ++i) assert(tb[i] <= tb[k]);
+                for (size_t i = k + 1; i < tb.size(); ++i) assert(tb[k] <= tb[i]);
+            }
+        }
+
+        // 吞吐量 : top_k vs 全排序
+        static void test3(size_t k) {
+            std::vector<int> rd = randIntArray(1000000);
+            std::vector<int> sa;
+            ttl::vector<int> ta;
+            std::string name = "top_k vs sort , k=" + std::to_string(k);
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::top_k<int> q(k);
+                        for (auto x: rd) q.push(x);
+                        ta = std::move(q).sorted();
+                    },
+                    {
+                        sa = rd;
+                        std::sort(sa.begin(), sa.end(), std::greater<>());
+                        sa.resize(k);
+                    }, name.c_str()
+            );
+            same(sa, ta);
+        }
+
+        // 与std的partial_sort/nth_element比较
+        static void test4() {
+            std::vector<int> rd = randIntArray(1000000);
+            std::vector<int> sa = rd, ta = rd;
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::nth_element(ta.begin(), ta.begin() + 500000, ta.end());
+                    },
+                    {
+                        std::nth_element(sa.begin(), sa.begin() + 500000, sa.end());
+                    }, "nth_element"
+            );
+            assert(sa[500000] == ta[500000]);
+            sa = rd, ta = rd;
+            TTL_STL_COMPARE_2(
+                    {
+                        ttl::partial_sort(ta.begin(), ta.begin() + 1000, ta.end());
+                    },
+                    {
+                        std::partial_sort(sa.begin(), sa.begin() + 1000, sa.end());
+                    }, "partial_sort k=1000"
+            );
+            assert(std::equal(sa.begin(), sa.begin() + 1000, ta.begin()));
+        }
+    };
+
+}
+
+#endif //TINYSTL_TOP_K_TEST_H
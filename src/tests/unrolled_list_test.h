@@ -0,0 +1,196 @@
+﻿#ifndef TINYSTL_UNROLLED_LIST_TEST_H
+#define TINYSTL_UNROLLED_LIST_TEST_H
+
+#include "../container/expand/unrolled_list.h"
+#include "../container/list.h"
+#include "../container/vector.h"
+#include "../utils/profiler.h"
+#include "../utils/test_helper.h"
+#include <list>
+
+namespace ttl::ttl_test {
+    class unrolled_list_test {
+    public:
+        static void runAll() {
+            test1();
+            test2();
+            test3();
+            test4();
+            test5();
+            test6();
+            test7();
+        }
+
+    private:
+        static void test1() {
+            auto rd = randStrArray(10000, 10);
+            ttl::unrolled_list<std::string> tl;
+            std::list<std::string> sl;
+            TTL_STL_COMPARE(tl, sl, {
+                v.assign(rd.begin(), rd.end());
+                v.insert(ttl::prev(v.end(), 3), 50000, "world");
+                v.insert(ttl::prev(v.rend(), 3000).base(), 50000, "asd");
+                v.insert(ttl::next(v.begin(), 777), rd.begin(), rd.end());
+                for (auto &s: rd) if (s[0] == 'a') v.emplace_front(s); else if (s[0] == 'b') v.emplace_back(s);
+            }, "unrolled insert");
+            same(sl, tl);
+        }
+
+        static void test2() {
+            auto rd = randStrArray(100000, 10);
+            auto rdi = randIntArray(1000);
+            ttl::unrolled_list<std::string> tl(rd.begin(), rd.end());
+            std::list<std::string> sl(rd.begin(), rd.end());
+            TTL_STL_COMPARE(tl, sl, {
+                for (auto i: rdi) {
+                    if (v.size() < 5000) break;
+                    i %= v.size() / 5;
+                    i *= 2;
+                    v.erase(ttl::next(v.begin(), i), ttl::next(v.begin(), i * 2));
+                    v.erase(ttl::next(v.begin(), i / 2));
+                }
+                for (int i = 0; i < 1000; ++i) { v.pop_front(); v.pop_back(); }
+            }, "unrolled erase");
+            same(sl, tl);
+        }
+
+        static void test3() {
+            auto rd = randStrArray(100000, 10);
+            ttl::unrolled_list<std::string> ta(rd.begin(), rd.end()), ta2(rd.begin(), rd.end());
+            std::list<std::string> sa(rd.begin(), rd.end()), sa2(rd.begin(), rd.end());
+            TTL_STL_COMPARE_2(
+                    {
+                        ta.splice(ttl::next(ta.begin(), 333), ta2, ttl::next(ta2.begin(), 1234), ttl::prev(ta2.end(), 4321));
+                        ta.splice(ta.end(), ta2);
+                        ta2.splice(ta2.begin(), ta, ttl::next(ta.begin(), 5), ttl::next(ta.begin(), 50));
+                    },
+                    {
+                        sa.splice(ttl::next(sa.begin(), 333), sa2, ttl::next(sa2.begin(), 1234), ttl::prev(sa2.end(), 4321));
+                        sa.splice(sa.end(), sa2);
+                        sa2.splice(sa2.begin(), sa, ttl::next(sa.begin(), 5), ttl::next(sa.begin(), 50));
+                    }, "unrolled splice"
+            );
+            same(sa, ta);
+            same(sa2, ta2);
+            assert(ta.size() == sa.size() && ta2.size() == sa2.size());
+        }
+
+        static void test4() {
+            auto rd = randStrArray(100000, 1);
+            std::list<std::string> sa(rd.begin(), rd.end());
+            ttl::unrolled_list<std::string> ta(rd.begin(), rd.end());
+            TTL_STL_COMPARE(ta, sa, {
+                v.remove("a");
+                v.remove_if([](const std::string &s) { return s[0] < 'f'; });
+                v.unique();
+                for (int i = 0; i < 11; ++i) v.reverse();
+                v.resize(v.size() / 2);
+                v.resize(v.size() * 3, "x");
+            }, "unrolled remove & reverse");
+            same(sa, ta);
+            assert(ta.size() == sa.size());
+        }
+
+        // 目标场景 : 随机位置插入删除 + 全量扫描
+        static void test5() {
+            const int n = 100000, m = 2000;
+            auto rd = randIntArray(n);
+            auto rdi = randIntArray(m);
+            ttl::unrolled_list<int> tl(rd.begin(), rd.end());
+            ttl::list<int> ll(rd.begin(), rd.end());
+            long long t_sum = 0, l_sum = 0;
+            TTL_STL_COMPARE_2(
+                    {
+                        for (int i = 0; i < m; ++i) {
+                            auto it = tl.nth(rdi[i] % tl.size());
+                            if (i & 1) tl.erase(it);
+                            else tl.insert(it, rdi[i]);
+                            if (i % 200 == 0) for (auto x: tl) t_sum += x;
+                        }
+                    },
+                    {
+                        for (int i = 0; i < m; ++i) {
+                            auto idx = rdi[i] % ll.size();
+                            auto it = idx < ll.size() / 2 ? ttl::next(ll.begin(), idx) :
+                                      ttl::prev(ll.end(), ll.size() - idx);
+                            if (i & 1) ll.erase(it);
+                            else ll.insert(it, rdi[i]);
+                            if (i % 200 == 0) for (auto x: ll) l_sum += x;
+                        }
+                    }, "unrolled vs ttl::list edit"
+            );
+            same(ll, tl);
+            assert(t_sum == l_sum);
+        }
+
+        static void test6() {
+            const int n = 100000, m = 2000;
+            auto rd = randStrArray(n, 10);
+            auto rdi = randIntArray(m);
+            ttl::unrolled_list<std::string> tl(rd.begin(), rd.end());
+            ttl::vector<std::string> tv(rd.begin(), rd.end());
+            size_t t_len = 0, v_len = 0;
+            TTL_STL_COMPARE_2(
+                    {
+                        for (int i = 0; i < m; ++i) {
+                            auto it = tl.nth(rdi[i] % tl.size());
+                            if (i & 1) tl.erase(it);
+                            else tl.insert(it, rd[i]);
+                            if (i % 200 == 0) for (auto &x: tl) t_len += x.size();
+                        }
+                    },
+                    {
+                        for (int i = 0; i < m; ++i) {
+                            auto it = tv.begin() + rdi[i] % tv.size();
+                            if (i & 1) tv.erase(it);
+                            else tv.insert(it, rd[i]);
+                            if (i % 200 == 0) for (auto &x: tv) v_len += x.size();
+                        }
+                    }, "unrolled vs ttl::vector edit"
+            );
+            same(tv, tl);
+            assert(t_len == v_len);
+        }
+
+        // merge与sort , 覆盖块边界附近的长度与排序的稳定性
+        static void test7() {
+            auto rd1 = randStrArray(100000, 10), rd2 = randStrArray(100000, 10);
+            std::sort(rd1.begin(), rd1.end()), std::sort(rd2.begin(), rd2.end());
+            std::list<std::string> sa;
+            ttl::unrolled_list<std::string> ta;
+            TTL_STL_COMPARE(ta, sa, {
+                v.assign(rd1.begin(), rd1.end());
+                v.merge({rd2.begin(), rd2.end()});
+            }, "unrolled merge");
+            same(sa, ta);
+            auto rd = randStrArray(100000, 10);
+            sa.assign(rd.begin(), rd.end()), ta.assign(rd.begin(), rd.end());
+            TTL_STL_COMPARE(ta, sa, {
+                v.sort();
+            }, "unrolled sort");
+            same(sa, ta);
+            using item = std::pair<int, int>;
+            auto by_first = [](const item &a, const item &b) { return a.first < b.first; };
+            for (int n: {0, 1, 2, 31, 32, 33, 64, 65, 1000, 5000}) {
+                std::list<item> sl, sl2;
+                for (int i = 0; i < n; ++i) sl.emplace_back(randInt(10), i), sl2.emplace_back(randInt(10), n + i);
+                ttl::unrolled_list<item, 32> tl(sl.begin(), sl.end()), tl2(sl2.begin(), sl2.end());
+                sl.sort(by_first), tl.sort(by_first);
+                same(sl, tl);
+                sl2.sort(by_first), tl2.sort(by_first);
+                sl.merge(sl2, by_first), tl.merge(tl2, by_first);
+                same(sl, tl);
+                assert(tl.size() == size_t(2 * n) && tl2.empty());
+                // 归并产生的块结构上还能继续插入删除
+                for (int i = 0; i < 300; ++i) {
+                    int idx = randInt(int(sl.size()) + 1);
+                    if (i % 3 == 2 && idx < int(sl.size())) sl.erase(std::next(sl.begin(), idx)), tl.erase(tl.nth(idx));
+                    else sl.insert(std::next(sl.begin(), idx), item(i, i)), tl.insert(tl.nth(idx), item(i, i));
+                }
+                same(sl, tl);
+            }
+        }
+    };
+}
+
+#endif //TINYSTL_UNROLLED_LIST_TEST_H
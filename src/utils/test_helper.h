@@ -50,6 +50,77 @@ namespace ttl::ttl_test {
     }while(false)                                   \
 
 
+// 同TTL_STL_COMPARE_2 , 另外按处理的字节数bytes报告两者的吞吐量
+#define TTL_BANDWIDTH_COMPARE(bytes, t_code, s_code, name)                                 \
+    do{                                                                                     \
+        free_timer timer;                                                                   \
+        time_type s_cost,t_cost;                                                            \
+        printf("%-30s : stl vs", (name));                                                   \
+        timer.start();                                                                      \
+        {s_code;}                                                                           \
+        s_cost = timer.get_ns();                                                            \
+        printf(" ttl : ");                                                                  \
+        timer.start();                                                                      \
+        {t_code;}                                                                           \
+        t_cost = timer.get_ns();                                                            \
+        report(s_cost, t_cost);                                                             \
+        report_bandwidth((bytes), s_cost, t_cost);                                          \
+    }while(false)                                                                           \
+
+
+// 同TTL_STL_COMPARE_2 , 另外按操作次数ops报告两者每秒执行的操作数
+#define TTL_OPS_COMPARE(ops, t_code, s_code, name)                                         \
+    do{                                                                                     \
+        free_timer timer;                                                                   \
+        time_type s_cost,t_cost;                                                            \
+        printf("%-30s : stl vs", (name));                                                   \
+        timer.start();                                                                      \
+        {s_code;}                                                                           \
+        s_cost = timer.get_ns();                                                            \
+        printf(" ttl : ");                                                                  \
+        timer.start();                                                                      \
+        {t_code;}                                                                           \
+        t_cost = timer.get_ns();                                                            \
+        report(s_cost, t_cost);                                                             \
+        report_ops((ops), s_cost, t_cost);                                                  \
+    }while(false)                                                                           \
+
+
+// 先顺序执行s_code , 再依次用1..N个线程的线程池执行p_code , N为硬件并发数 , 报告相对顺序执行的加速比
+// 每次计时前执行reset(不计时) , p_code中用pool表示当前的线程池
+#define TTL_PARALLEL_COMPARE(reset, s_code, p_code, name)                                  \
+    do{                                                                                     \
+        free_timer timer;                                                                   \
+        {reset;}                                                                            \
+        timer.start();                                                                      \
+        {s_code;}                                                                           \
+        time_type s_cost = timer.get_ns();                                                  \
+        printf("%-30s : seq %.2lf ms\n", (name), double(s_cost) / 1e6);                     \
+        for (size_t threads = 1; threads <= ttl::thread_pool::default_concurrency(); ++threads) { \
+            ttl::thread_pool pool(threads);                                                 \
+            {reset;}                                                                        \
+            timer.start();                                                                  \
+            {p_code;}                                                                       \
+            report_speedup(threads, s_cost, timer.get_ns());                                \
+        }                                                                                   \
+    }while(false)                                                                           \
+
+
+    void report_speedup(size_t threads, time_type s_cost, time_type p_cost) {
+        printf("%30s   %2zu threads : %.2lf ms , speedup %.2lfx\n", "", threads, double(p_cost) / 1e6,
+               double(s_cost) / double(p_cost));
+    }
+
+    void report_bandwidth(size_t bytes, time_type s_cost, time_type t_cost) {
+        printf("%30s   %.2lf GB/s vs %.2lf GB/s\n", "", double(bytes) / double(s_cost),
+               double(bytes) / double(t_cost));
+    }
+
+    void report_ops(size_t ops, time_type s_cost, time_type t_cost) {
+        printf("%30s   %.2lf Mops/s vs %.2lf Mops/s\n", "", double(ops) * 1e3 / double(s_cost),
+               double(ops) * 1e3 / double(t_cost));
+    }
+
     void report(time_type s_cost, time_type t_cost) {
         static struct recorder {
             int win = 0, lose = 0, same = 0;